@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include "CalibrationManager.hpp"
 
 #include "../../util/src/OpenCVUtil.hpp"
@@ -7,7 +9,12 @@
 #include "Windows/CalibrationMeterWindow.hpp"
 #include "Windows/EliminateProjectionWindow.hpp"
 
-CalibrationManager::CalibrationManager(ImoveConfiguration* calibration) : calibration(calibration), projection(Projection(calibration)) {}
+// Steady clock time in nanoseconds, which is the same clock the projection is eliminated with
+static long long nowNanoseconds() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+CalibrationManager::CalibrationManager(ImoveConfiguration* calibration) : calibration(calibration), projection(calibration) {}
 
 void CalibrationManager::run() {
 	// setup camera
@@ -27,18 +34,24 @@ void CalibrationManager::run() {
 	EliminateProjectionWindow eliminateprojection_window(cv::Point2i(width_resolution_projector, 300), cv::Size(300, 300), projectionelimination_configuration, this->projection);
 	ProjectionWindow projection_window(cv::Point2i(width_resolution_projector + 300, 300), cv::Size(300, 300), this->projection);
 
-	cv::Mat frame_projector;
-	// while camera frame can be read and while no key pressed
-	while (cv::waitKey(1) == OpenCVUtil::NOKEY_ANYKEY && camera_videoreader.read(frame_camera)) {
-		// initialize a black projector frame
-		frame_projector = cv::Mat::zeros(resolution_projector, CV_8UC3);
-		// draw projector image for Calibration
-		projector_window.drawImage(frame_projector);
+	// initialize a black projector frame and draw projector image for Calibration, displayed by the first wait for a key
+	cv::Mat frame_projector = cv::Mat::zeros(resolution_projector, CV_8UC3);
+	projector_window.drawImage(frame_projector);
+	// while no key pressed, which displays the windows drawn before
+	while (cv::waitKey(1) == OpenCVUtil::NOKEY_ANYKEY) {
+		// feed Calibration image for latency and brightness Calibration, displayed from now on, before the camera frame showing it is captured
+		projection.feedFrameProjector(projector_window.getClonedImage(), nowNanoseconds());
+		// stamp the camera frame when it is grabbed, decoding it takes time after
+		if (!camera_videoreader.grab()) {
+			break;
+		}
+		const long long timestamp_capture = nowNanoseconds();
+		if (!camera_videoreader.retrieve(frame_camera)) {
+			break;
+		}
 
-		// feed Calibration image for delay and brightness Calibration
-		projection.feedFrameProjector(projector_window.getClonedImage());
 		// draw calibrated eliminated camera image
-		eliminateprojection_window.drawImage(frame_camera);
+		eliminateprojection_window.drawImage(frame_camera, timestamp_capture);
 
 		// draw calibrated eliminated projection image
 		projection_window.drawImage(eliminateprojection_window.getClonedImage());
@@ -47,6 +60,10 @@ void CalibrationManager::run() {
 		calibrationprojection_window.drawImage(frame_camera.clone());
 		// draw Calibration meter image
 		calibrationmeter_window.drawImage(frame_camera.clone());
+
+		// draw the next projector image for Calibration, displayed by the next wait for a key
+		frame_projector = cv::Mat::zeros(resolution_projector, CV_8UC3);
+		projector_window.drawImage(frame_projector);
 	}
 
 	//safe release camera
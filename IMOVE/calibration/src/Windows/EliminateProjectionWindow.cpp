@@ -3,14 +3,14 @@
 EliminateProjectionWindow::EliminateProjectionWindow(cv::Point2i position, cv::Size size, ProjectioneliminationConfiguration* calibration, Projection& projection) : OpenCVWindow("Eliminate projection", position, size), calibration(calibration), projection(projection) {
 	track_projector_background_light = round(this->calibration->getProjectorBackgroundLight() * FLOAT_FULL_PERCENTAGE);
 	cv::createTrackbar(this->name_trackbar_ratio_projector_background_light, this->name_window, &this->track_projector_background_light, this->INT_FULL_PERCENTAGE, EliminateProjectionWindow::onProjectorBackgroundLight, (void*) &*this);
-	this->track_frames_projector_camera_delay = (signed int) this->calibration->getFramesProjectorCameraDelay();
-	cv::createTrackbar(this->name_trackbar_frames_projector_camera_delay, this->name_window, &this->track_frames_projector_camera_delay, this->INT_FULL_PERCENTAGE, EliminateProjectionWindow::onFramesProjectorCameraDelay, (void*) &*this);
+	this->track_latency_projector_camera = (signed int) this->calibration->getLatencyProjectorCameraMs();
+	cv::createTrackbar(this->name_trackbar_latency_projector_camera, this->name_window, &this->track_latency_projector_camera, this->INT_MAXIMUM_LATENCY_MS, EliminateProjectionWindow::onLatencyProjectorCamera, (void*) &*this);
 }
 
-void EliminateProjectionWindow::drawImage(cv::Mat image_camera) {
+void EliminateProjectionWindow::drawImage(cv::Mat image_camera, long long timestamp_capture) {
 	cv::Mat image_projectionelimination;
 
-	this->projection.eliminateProjectionFeedbackFromFrameCamera(image_projectionelimination, image_camera);
+	this->projection.eliminateProjectionFeedbackFromFrameCamera(image_projectionelimination, image_camera, timestamp_capture);
 	OpenCVWindow::drawImage(image_projectionelimination);
 }
 
@@ -22,13 +22,13 @@ void EliminateProjectionWindow::onProjectorBackgroundLight(int tracked_int, void
 	that->calibration->setProjectorBackgroundLight(((float) tracked_int) / that->FLOAT_FULL_PERCENTAGE);
 }
 
-// Amount of frames delay between projection and camera trackbar callback
-void EliminateProjectionWindow::onFramesProjectorCameraDelay(int tracked_int, void *param) {
+// Milliseconds latency between projection and camera trackbar callback
+void EliminateProjectionWindow::onLatencyProjectorCamera(int tracked_int, void *param) {
 	EliminateProjectionWindow* that = (EliminateProjectionWindow*) param;
 	
 	if (tracked_int < 0) {
-		that->calibration->setFramesProjectorCameraDelay(0);
+		that->calibration->setLatencyProjectorCameraMs(0);
 	} else {
-		that->calibration->setFramesProjectorCameraDelay((unsigned int) tracked_int);
+		that->calibration->setLatencyProjectorCameraMs((unsigned int) tracked_int);
 	}
 }
@@ -4,13 +4,19 @@
 #include "../../../util/src/configuration/ProjectioneliminationConfiguration.hpp"
 #include "../../../util/src/Projection.hpp"
 
-// Window to calibrate the elimination of the projection on the camera based on the projector frame with some delay and intensity
+// Window to calibrate the elimination of the projection on the camera based on the projector frame with some latency and intensity
 class EliminateProjectionWindow : public OpenCVWindow {
 	public:
 		const char* name_trackbar_ratio_projector_background_light = "Ratio projector - background light";
-		const char* name_trackbar_frames_projector_camera_delay = "Frames projector - camera delay";
+		const char* name_trackbar_latency_projector_camera = "Latency projector - camera (ms)";
 		
-		void drawImage(cv::Mat image_camera);
+		/**
+		 * Draw the camera frame with the projection eliminated.
+		 *
+		 * @param image_camera      The camera frame
+		 * @param timestamp_capture The steady clock nanoseconds on which the camera frame is captured
+		 **/
+		void drawImage(cv::Mat image_camera, long long timestamp_capture);
 
 		EliminateProjectionWindow(cv::Point2i position, cv::Size size, ProjectioneliminationConfiguration* calibration, Projection& projection);
 
@@ -19,11 +25,12 @@ class EliminateProjectionWindow : public OpenCVWindow {
 		Projection& projection;
 	
 		int track_projector_background_light;
-		int track_frames_projector_camera_delay;
+		int track_latency_projector_camera;
 
 		const int INT_FULL_PERCENTAGE = 100;
 		const float FLOAT_FULL_PERCENTAGE = 100.0f;
+		const int INT_MAXIMUM_LATENCY_MS = 1000;
 		
 		static void onProjectorBackgroundLight(int tracked_int, void *param);
-		static void onFramesProjectorCameraDelay(int tracked_int, void *param);
+		static void onLatencyProjectorCamera(int tracked_int, void *param);
 };
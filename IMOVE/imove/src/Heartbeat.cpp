@@ -0,0 +1 @@
+#include "Heartbeat.hpp"
@@ -0,0 +1,30 @@
+#ifndef IMOVE_HEARTBEAT_H
+#define IMOVE_HEARTBEAT_H
+
+#include <atomic>
+
+const char* const NAME_SHARED_MEMORY_HEARTBEAT_SCENE = "ImoveHeartbeatScene";
+const char* const NAME_SHARED_MEMORY_HEARTBEAT_PEOPLEEXTRACTOR = "ImoveHeartbeatPeopleextractor";
+
+// Counter in shared memory a process increments every iteration of its main loop, so the imove process can see it stall
+class Heartbeat {
+	public:
+		Heartbeat() : beats(0) {}
+
+		// Signal that the process is still making progress
+		inline void beat() {
+			this->beats.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Gets the amount of beats since the segment was created
+		inline unsigned long long getBeats() const {
+			return this->beats.load(std::memory_order_relaxed);
+		}
+
+	private:
+		static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory heartbeat requires lock-free atomics");
+
+		std::atomic<unsigned long long> beats;
+};
+
+#endif //IMOVE_HEARTBEAT_H
@@ -1,7 +1,20 @@
+#ifndef IMOVE_RUNNING_H
+#define IMOVE_RUNNING_H
+
+#include <atomic>
+
 const char* const NAME_SHARED_MEMORY_RUNNING = "ImoveRunning";
 
+// Run and shutdown flags shared by all processes, lock-free atomics so every process sees changes without locking
 class Running {
 	public:
-		bool running = true;
-		bool reboot_on_shutdown = true;
+		Running() : running(true), reboot_on_shutdown(true) {}
+
+		std::atomic<bool> running;
+		std::atomic<bool> reboot_on_shutdown;
+
+	private:
+		static_assert(ATOMIC_BOOL_LOCK_FREE == 2, "Shared memory running flags require lock-free atomics");
 };
+
+#endif //IMOVE_RUNNING_H
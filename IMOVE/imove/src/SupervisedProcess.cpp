@@ -0,0 +1,118 @@
+#include <spawn.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "SupervisedProcess.hpp"
+
+extern char** environ;
+
+// Milliseconds between checks whether a child process exited while shutting down
+static const unsigned int INTERVAL_SHUTDOWN_MS = 10;
+
+SupervisedProcess::SupervisedProcess(const std::string& name, const std::string& path, const std::vector<std::string>& arguments, boost::interprocess::offset_ptr<Heartbeat> heartbeat) :
+	name(name),
+	path(path),
+	arguments(arguments),
+	heartbeat(heartbeat),
+	pid(0),
+	spawns(0),
+	completed(false),
+	beating(false),
+	beats_checked(0)
+{}
+
+bool SupervisedProcess::spawn() {
+	// argument list of executable path followed by arguments and terminated by NULL
+	std::vector<char*> argv;
+	argv.push_back(const_cast<char*>(this->path.c_str()));
+	for (std::vector<std::string>::const_iterator argument = this->arguments.begin(); argument != this->arguments.end(); ++argument) {
+		argv.push_back(const_cast<char*>(argument->c_str()));
+	}
+	argv.push_back(NULL);
+
+	const int error = posix_spawn(&this->pid, this->path.c_str(), NULL, NULL, argv.data(), environ);
+	if (error != 0) {
+		std::cerr << "Failing to start " << this->name << ": " << std::strerror(error) << std::endl;
+		this->pid = 0;
+		return false;
+	}
+	std::cout << "Started " << this->name << std::endl;
+	++this->spawns;
+	// only count beats of this child process as progress
+	this->beating = false;
+	this->beats_checked = this->heartbeat->getBeats();
+	this->time_beat = std::chrono::steady_clock::now();
+	return true;
+}
+
+bool SupervisedProcess::hasExited() {
+	if (this->pid == 0) {
+		return true;
+	}
+	int status;
+	if (waitpid(this->pid, &status, WNOHANG) != this->pid) {
+		return false;
+	}
+	this->completed = WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+	if (WIFSIGNALED(status)) {
+		std::cout << "Ended " << this->name << " by signal " << WTERMSIG(status) << std::endl;
+	} else {
+		std::cout << "Ended " << this->name << " with status " << WEXITSTATUS(status) << std::endl;
+	}
+	this->pid = 0;
+	return true;
+}
+
+bool SupervisedProcess::isStalled(unsigned int timeout_ms) {
+	const unsigned long long beats = this->heartbeat->getBeats();
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (beats != this->beats_checked) {
+		this->beating = true;
+		this->beats_checked = beats;
+		this->time_beat = now;
+		return false;
+	}
+	// still starting up when it did not beat since it was started
+	if (!this->beating) {
+		return false;
+	}
+	return now - this->time_beat > std::chrono::milliseconds(timeout_ms);
+}
+
+void SupervisedProcess::kill() {
+	if (this->pid == 0) {
+		return;
+	}
+	::kill(this->pid, SIGKILL);
+	waitpid(this->pid, NULL, 0);
+	this->completed = false;
+	std::cout << "Killed " << this->name << std::endl;
+	this->pid = 0;
+}
+
+void SupervisedProcess::shutdown(unsigned int timeout_ms) {
+	const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+	while (!this->hasExited()) {
+		if (std::chrono::steady_clock::now() > deadline) {
+			this->kill();
+			return;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(INTERVAL_SHUTDOWN_MS));
+	}
+}
+
+bool SupervisedProcess::hasCompleted() const {
+	return this->completed;
+}
+
+const std::string& SupervisedProcess::getName() const {
+	return this->name;
+}
+
+unsigned int SupervisedProcess::getSpawns() const {
+	return this->spawns;
+}
@@ -0,0 +1,85 @@
+#ifndef IMOVE_SUPERVISEDPROCESS_H
+#define IMOVE_SUPERVISEDPROCESS_H
+
+#include <sys/types.h>
+#include <boost/interprocess/offset_ptr.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Heartbeat.hpp"
+
+// Child process of imove which is spawned, watched by its heartbeat and restarted on its own
+class SupervisedProcess {
+	public:
+		/**
+		 * Setup child process without starting it.
+		 *
+		 * @param name      The name to report the child process with
+		 * @param path      The path of the executable
+		 * @param arguments The arguments for the executable
+		 * @param heartbeat The heartbeat of the child process in shared memory
+		 **/
+		SupervisedProcess(const std::string& name, const std::string& path, const std::vector<std::string>& arguments, boost::interprocess::offset_ptr<Heartbeat> heartbeat);
+
+		/**
+		 * Start the executable as child process.
+		 *
+		 * @return false when the child process could not be started
+		 **/
+		bool spawn();
+
+		/**
+		 * Check without blocking whether the child process exited, and clean it up if so.
+		 *
+		 * @return true when not running
+		 **/
+		bool hasExited();
+
+		// Gets whether the child process exited by itself with success the last time it exited, so it completed instead of failing
+		bool hasCompleted() const;
+
+		/**
+		 * Check whether the child process stopped beating. Only checked once it started beating,
+		 * so a slow startup is not seen as a stall.
+		 *
+		 * @param timeout_ms The amount of milliseconds without a beat after which the child process is stalled
+		 * @return true when stalled
+		 **/
+		bool isStalled(unsigned int timeout_ms);
+
+		// Forcefully stop the child process and wait till it exited
+		void kill();
+
+		/**
+		 * Wait till the child process exited by itself, otherwise forcefully stop it.
+		 *
+		 * @param timeout_ms The amount of milliseconds to wait for the child process
+		 **/
+		void shutdown(unsigned int timeout_ms);
+
+		// Gets the name of the child process
+		const std::string& getName() const;
+
+		// Gets the amount of times the child process is started
+		unsigned int getSpawns() const;
+
+	private:
+		const std::string name;
+		const std::string path;
+		const std::vector<std::string> arguments;
+		boost::interprocess::offset_ptr<Heartbeat> heartbeat;
+
+		// process id, 0 when not running
+		pid_t pid;
+		unsigned int spawns;
+		// whether it last exited by itself with success
+		bool completed;
+		// whether it beated since it was started
+		bool beating;
+		// beats on last check and time on which they last changed
+		unsigned long long beats_checked;
+		std::chrono::steady_clock::time_point time_beat;
+};
+
+#endif //IMOVE_SUPERVISEDPROCESS_H
@@ -1,19 +1,67 @@
-#include <sys/types.h>
-#include <unistd.h>
-#include <sys/wait.h>
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "../../scene_interface_sma/src/SharedMemory.hpp"
 #include "../../scene_interface_sma/src/PeopleQueue.hpp"
-#include "../../peopleextractor_interface_sma/src/SceneframeQueue.hpp"
+#include "../../scene_interface_sma/src/PeopleSnapshot.hpp"
+#include "../../scene_interface_sma/src/TraceRing.hpp"
+#include "../../scene_interface_sma/src/FrameSequence.hpp"
+#include "../../peopleextractor_interface_sma/src/SceneframeBuffer.hpp"
 #include "Running.hpp"
+#include "Heartbeat.hpp"
+#include "SupervisedProcess.hpp"
 
 const unsigned int CONFIGURATION_CALIBRATION_ARGN = 1;
 const unsigned int CONFIGURATION_LIGHTTRAIL_ARGN = 2;
 
 const unsigned int SIZE_SHAREDMEMORY = 100000000; // 100MB
 
+// Milliseconds between checks of the child processes
+const unsigned int INTERVAL_SUPERVISE_MS = 200;
+// Milliseconds without a heartbeat after which a child process is seen as stalled and restarted
+const unsigned int TIMEOUT_HEARTBEAT_MS = 5000;
+// Milliseconds a child process gets to exit by itself on shutdown
+const unsigned int TIMEOUT_SHUTDOWN_MS = 5000;
+// Minimum milliseconds between two starts of the same child process, so a child failing on startup does not spin
+const unsigned int DELAY_RESTART_MS = 1000;
+
+/**
+ * Restart child process when it crashed, failed or stalled while the application should keep running.
+ * A child process which exited by itself with success completed, such as a replay which ran out of frames, and shuts down the application.
+ *
+ * @param process      The child process
+ * @param running      The application running flags
+ * @param time_started The time on which the child process was last started, updated on restart
+ **/
+void superviseProcess(SupervisedProcess& process, boost::interprocess::offset_ptr<Running> running, std::chrono::steady_clock::time_point& time_started) {
+	if (process.hasExited()) {
+		if (!running->running) {
+			return;
+		}
+		if (process.hasCompleted()) {
+			std::cout << "Completed " << process.getName() << std::endl;
+			running->running = false;
+			running->reboot_on_shutdown = false;
+			return;
+		}
+		std::cerr << "Unexpected end of " << process.getName() << std::endl;
+	} else if (process.isStalled(TIMEOUT_HEARTBEAT_MS)) {
+		std::cerr << "Stalled " << process.getName() << std::endl;
+		process.kill();
+	} else {
+		return;
+	}
+	// wait a bit when started only just ago
+	const std::chrono::steady_clock::time_point time_restart = time_started + std::chrono::milliseconds(DELAY_RESTART_MS);
+	std::this_thread::sleep_until(time_restart);
+	time_started = std::chrono::steady_clock::now();
+	std::cout << "Restarting " << process.getName() << std::endl;
+	process.spawn();
+}
+
 // setup and run Scene with continous people extraction as input based on configuration given in parameter otherwise show parameters
 int main(int argc, char* argv[]) {
 	// show parameters if not given 2 parameter
@@ -23,54 +71,63 @@ int main(int argc, char* argv[]) {
 	}
 
 	std::string argv_str(argv[0]);
-  std::string base = argv_str.substr(0, argv_str.find_last_of("/"));
-	
-	boost::interprocess::offset_ptr<Running> running;
-	// while set that it should not shutdown but (re)start or when boost failed
-	while (running == NULL || running->reboot_on_shutdown) {
-		// Newly create a new shared memory segment with certain size
-		boost::interprocess::shared_memory_object::remove(scene_interface_sma::NAME_SHARED_MEMORY);
-		boost::interprocess::managed_shared_memory* segment = new boost::interprocess::managed_shared_memory(boost::interprocess::create_only, scene_interface_sma::NAME_SHARED_MEMORY, SIZE_SHAREDMEMORY);
-		// Construct the people extracted queue in shared memory
-		const scene_interface_sma::PeopleQueueSMA people_queue_sma(segment->get_segment_manager());
-		segment->construct<scene_interface_sma::PeopleQueue>(scene_interface_sma::NAME_PEOPLE_QUEUE)(people_queue_sma);
-		const peopleextractor_interface_sma::SceneframeQueueSMA sceneframe_queue_sma(segment->get_segment_manager());
-		segment->construct<peopleextractor_interface_sma::SceneframeQueue>(peopleextractor_interface_sma::NAME_SCENEFRAME_QUEUE)(sceneframe_queue_sma);
-		running = segment->construct<Running>(NAME_SHARED_MEMORY_RUNNING)();
-		
+	std::string base = argv_str.substr(0, argv_str.find_last_of("/"));
+
+	// Newly create a new shared memory segment with certain size, kept for restarts of the child processes
+	boost::interprocess::shared_memory_object::remove(scene_interface_sma::NAME_SHARED_MEMORY);
+	boost::interprocess::managed_shared_memory* segment = new boost::interprocess::managed_shared_memory(boost::interprocess::create_only, scene_interface_sma::NAME_SHARED_MEMORY, SIZE_SHAREDMEMORY);
+	// Construct the people extracted queue with all its preallocated frames in shared memory
+	segment->construct<scene_interface_sma::PeopleQueue>(scene_interface_sma::NAME_PEOPLE_QUEUE)();
+	// Construct the latest extracted people snapshot in shared memory
+	segment->construct<scene_interface_sma::PeopleSnapshot>(scene_interface_sma::NAME_PEOPLE_SNAPSHOT)();
+	// Construct the trace of camera frames through the pipeline in shared memory
+	segment->construct<scene_interface_sma::TraceRing>(scene_interface_sma::NAME_TRACE_RING)();
+	// Construct the sequence of camera frames in shared memory, so a restarted people extractor continues it
+	segment->construct<scene_interface_sma::FrameSequence>(scene_interface_sma::NAME_FRAME_SEQUENCE)();
+	// Construct the scene frame buffer in shared memory, its images are allocated by the scene
+	segment->construct<peopleextractor_interface_sma::SceneframeBuffer>(peopleextractor_interface_sma::NAME_SCENEFRAME_BUFFER)();
+	boost::interprocess::offset_ptr<Running> running = segment->construct<Running>(NAME_SHARED_MEMORY_RUNNING)();
+	// Construct the heartbeats of both child processes
+	boost::interprocess::offset_ptr<Heartbeat> heartbeat_scene = segment->construct<Heartbeat>(NAME_SHARED_MEMORY_HEARTBEAT_SCENE)();
+	boost::interprocess::offset_ptr<Heartbeat> heartbeat_peopleextractor = segment->construct<Heartbeat>(NAME_SHARED_MEMORY_HEARTBEAT_PEOPLEEXTRACTOR)();
+	// Fault in the whole segment once, so the processes do not pay for page faults while running
+	peopleextractor_interface_sma::SharedMemoryArena::prefault(segment, false);
+
+	std::vector<std::string> arguments_scene;
+	arguments_scene.push_back(argv[CONFIGURATION_CALIBRATION_ARGN]);
+	arguments_scene.push_back(argv[CONFIGURATION_LIGHTTRAIL_ARGN]);
+	SupervisedProcess process_scene("Scene", base + "/imove_scene", arguments_scene, heartbeat_scene);
+	std::vector<std::string> arguments_peopleextractor;
+	arguments_peopleextractor.push_back(argv[CONFIGURATION_CALIBRATION_ARGN]);
+	SupervisedProcess process_peopleextractor("Peopleextractor", base + "/imove_peopleextractor", arguments_peopleextractor, heartbeat_peopleextractor);
+
+	// while set that it should not shutdown but (re)start
+	do {
 		running->running = true;
-		// fork to create subprocess scene
-		pid_t pID_scene = fork();
-		if (pID_scene == 0) {
-			// replace process with imove_scene process
-			std::cout << "Starting Scene" << std::endl;
-			system(("\"" + base + "/imove_scene\" " + (std::string)argv[CONFIGURATION_CALIBRATION_ARGN] + " " + (std::string) argv[CONFIGURATION_LIGHTTRAIL_ARGN]).c_str());
-			std::cout << "Ended Scene" << std::endl;
-			_exit(0);
-		} else if (pID_scene < 0) {
-			std::cerr << "Failing to create subprocess scene" << std::endl;
-		} else {
-			// fork to create subprocess peopleextractor
-			pid_t pID_peopleextractor = fork();
-			if (pID_peopleextractor == 0) {
-				std::cout << "Starting Peopleextractor" << std::endl;
-				// replace process with imove_peopleextractor process
-				system(("\"" + base + "/imove_peopleextractor\" " + (std::string) argv[CONFIGURATION_CALIBRATION_ARGN]).c_str());
-				std::cout << "Ended Peopleextractor" << std::endl;
-				_exit(0);
-			} else if (pID_peopleextractor < 0) {
-				std::cerr << "Failing to create subprocess people extractor" << std::endl;
-			} else {
-				// root process waits untill scene process exists and exits all subprocesses
-				wait(NULL);
-				running->running = false;
-				wait(NULL);
-			}
+		std::chrono::steady_clock::time_point time_started_scene = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point time_started_peopleextractor = time_started_scene;
+		if (!process_scene.spawn() || !process_peopleextractor.spawn()) {
+			running->running = false;
+			running->reboot_on_shutdown = false;
 		}
-	}
+
+		// restart only the child process which crashed or stalled, the other keeps its state
+		while (running->running) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(INTERVAL_SUPERVISE_MS));
+			superviseProcess(process_scene, running, time_started_scene);
+			superviseProcess(process_peopleextractor, running, time_started_peopleextractor);
+		}
+
+		// shutdown of one child process shuts down the other
+		process_scene.shutdown(TIMEOUT_SHUTDOWN_MS);
+		process_peopleextractor.shutdown(TIMEOUT_SHUTDOWN_MS);
+	} while (running->reboot_on_shutdown);
+
+	std::cout << "Started scene " << process_scene.getSpawns() << " times"
+		<< " and peopleextractor " << process_peopleextractor.getSpawns() << " times" << std::endl;
 
 	// remove shared memory segment
 	boost::interprocess::shared_memory_object::remove(scene_interface_sma::NAME_SHARED_MEMORY);
-	
+
 	return EXIT_SUCCESS;
 }
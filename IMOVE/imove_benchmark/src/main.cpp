@@ -0,0 +1,635 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../../util/src/configuration/ImoveConfiguration.hpp"
+#include "../../util/src/Boundary.h"
+#include "../../util/src/Vector2.h"
+#include "../../imove_peopleextractor/src/Capture/Recording.hpp"
+#include "../../imove_peopleextractor/src/Capture/SyntheticFrameSource.hpp"
+#include "../../imove_peopleextractor/src/ImageProcessing/Detector/GaussianBackgroundModel.h"
+#include "../../imove_peopleextractor/src/ImageProcessing/Detector/KnnBackgroundModel.h"
+#include "../../imove_peopleextractor/src/ImageProcessing/Detector/PeopleDetector.h"
+#include "../../imove_peopleextractor/src/ImageProcessing/Identifier/PeopleIdentifier.h"
+#include "../../imove_peopleextractor/src/Pipeline/Ingestion.hpp"
+#include "../../imove_peopleextractor/src/Person.h"
+
+const unsigned int CONFIGURATION_ARGN = 1;
+const unsigned int FRAMES_ARGN = 2;
+const unsigned int RECORDING_ARGN = 3;
+
+// Combination of backends of the people detector
+struct Backends {
+	const char* name;
+	CameraConfiguration::BlobDetector blob_detector;
+	CameraConfiguration::BackgroundModel background_model;
+};
+
+// Backends which are compared, the first is the reference on recordings
+const Backends BACKENDS[] = {
+	{ "simple/knn", CameraConfiguration::BLOB_DETECTOR_SIMPLE, CameraConfiguration::BACKGROUND_MODEL_KNN },
+	{ "cc/knn", CameraConfiguration::BLOB_DETECTOR_CONNECTED_COMPONENTS, CameraConfiguration::BACKGROUND_MODEL_KNN },
+	{ "cc/gauss", CameraConfiguration::BLOB_DETECTOR_CONNECTED_COMPONENTS, CameraConfiguration::BACKGROUND_MODEL_GAUSSIAN }
+};
+
+// Amounts of people in the synthetic crowds which are benchmarked
+const unsigned int AMOUNTS_PEOPLE[] = { 1, 2, 5, 10, 20, 50, 100, 200 };
+// Amount of people in the synthetic crowd the background models are benchmarked on
+const unsigned int AMOUNT_PEOPLE_BACKGROUND = 20;
+// Amount of people in the synthetic crowd ingestion is benchmarked on
+const unsigned int AMOUNT_PEOPLE_INGESTION = 20;
+// Factor of the camera resolution the synthetic crowd is captured at when benchmarking ingestion, so ingestion resizes like with a camera of a higher resolution
+const unsigned int FACTOR_CAPTURE_INGESTION = 2;
+// Amounts of threads detecting people is benchmarked on
+const int AMOUNTS_THREADS[] = { 1, 2, 4, 8 };
+// Camera frames to let the background subtractor learn the floor before measuring
+const unsigned int FRAMES_WARMUP = 50;
+// Camera frames measured per crowd when not given
+const unsigned int FRAMES_DEFAULT = 300;
+// Maximum distance in meters between a found and a true location to count as the same person, more than the perspective correction of the detector
+const float DISTANCE_MATCH_METERS = 0.5;
+// Seed of the synthetic crowds, fixed so benchmarks are comparable
+const unsigned int SEED = 1;
+
+// Counts of found locations compared to true locations
+struct Accuracy {
+	unsigned long long truths;
+	unsigned long long found;
+	unsigned long long matched;
+	double distance_matched;
+
+	Accuracy() : truths(0), found(0), matched(0), distance_matched(0) {}
+};
+
+/**
+ * Match found locations to the closest true locations and count them.
+ *
+ * @param truths       The true locations of people
+ * @param found        The found locations of people
+ * @param distance_max The maximum distance in pixels to match a found location to a true location
+ * @param accuracy     The counts to add to
+ * @param matches      If given, filled with the index of the found location matched to every true location, -1 for none
+ **/
+void count(const std::vector<Vector2>& truths, std::vector<Vector2> found, float distance_max, Accuracy& accuracy, std::vector<int>* matches = NULL) {
+	accuracy.truths += truths.size();
+	accuracy.found += found.size();
+	// index of every found location which is not taken yet
+	std::vector<int> indices(found.size());
+	for (unsigned int i = 0; i < indices.size(); ++i) {
+		indices[i] = i;
+	}
+	if (matches != NULL) {
+		matches->assign(truths.size(), -1);
+	}
+	for (unsigned int t = 0; t < truths.size(); ++t) {
+		// greedily take the closest found location which is not taken yet
+		float distance_closest = std::numeric_limits<float>::max();
+		int closest = -1;
+		for (unsigned int i = 0; i < found.size(); ++i) {
+			const float distance = Vector2(truths[t]).distance(found[i]);
+			if (distance < distance_closest) {
+				distance_closest = distance;
+				closest = i;
+			}
+		}
+		if (closest >= 0 && distance_closest <= distance_max) {
+			++accuracy.matched;
+			accuracy.distance_matched += distance_closest;
+			if (matches != NULL) {
+				(*matches)[t] = indices[closest];
+			}
+			found.erase(found.begin() + closest);
+			indices.erase(indices.begin() + closest);
+		}
+	}
+}
+
+/**
+ * Gets the percentile of sorted values.
+ *
+ * @param values     The sorted values, not empty
+ * @param percentile The percentile between 0 and 100
+ **/
+double percentile(const std::vector<double>& values, double percentile) {
+	const std::size_t index = static_cast<std::size_t>(percentile / 100.0 * (values.size() - 1) + 0.5);
+	return values[index];
+}
+
+// Milliseconds since the given time
+double millisecondsSince(const std::chrono::steady_clock::time_point& time) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time).count();
+}
+
+/**
+ * Setup a detector like the people extractor does, with other backends.
+ *
+ * @param camera_configuration The configuration of the camera
+ * @param backends             The backends of the detector
+ **/
+PeopleDetector createDetector(CameraConfiguration* camera_configuration, const Backends& backends) {
+	return PeopleDetector(
+		camera_configuration->getMeter(),
+		camera_configuration->getMinBlobArea(),
+		camera_configuration->getMinBlobDistance(),
+		backends.blob_detector,
+		camera_configuration->getBlobMorphologySize(),
+		backends.background_model,
+		camera_configuration->getBackgroundLearningRate(),
+		camera_configuration->getBackgroundShadows()
+	);
+}
+
+/**
+ * Measure throughput and accuracy of detecting and identifying people in synthetic crowds of growing size, for every combination of backends.
+ *
+ * @param calibration     The configuration of the camera and the synthetic crowd
+ * @param frames_measured The amount of camera frames measured per crowd
+ **/
+void benchmarkSynthetic(ImoveConfiguration* calibration, unsigned int frames_measured) {
+	CameraConfiguration* camera_configuration = calibration->getCameraConfiguration();
+	CaptureConfiguration* capture_configuration = calibration->getCaptureConfiguration();
+	const float pixels_per_meter = camera_configuration->getMeter();
+	const Boundary boundary = camera_configuration->getProjection().createReorientedTopLeftBoundary();
+
+	std::cout << "Benchmarking " << frames_measured << " camera frames of "
+		<< camera_configuration->getResolution().width << "x" << camera_configuration->getResolution().height
+		<< " per crowd" << std::endl;
+	std::cout << std::setw(12) << "detector"
+		<< std::setw(8) << "people"
+		<< std::setw(12) << "detect p50"
+		<< std::setw(12) << "detect p99"
+		<< std::setw(12) << "match p50"
+		<< std::setw(12) << "match p99"
+		<< std::setw(8) << "fps"
+		<< std::setw(10) << "recall"
+		<< std::setw(11) << "precision"
+		<< std::setw(10) << "error px"
+		<< std::setw(10) << "tracked"
+		<< std::setw(10) << "switches" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	for (const Backends& backends : BACKENDS) {
+		for (unsigned int amount_people : AMOUNTS_PEOPLE) {
+			SyntheticFrameSource source(
+				camera_configuration->getResolution(),
+				pixels_per_meter,
+				amount_people,
+				capture_configuration->getSyntheticFps(),
+				false,
+				capture_configuration->getSyntheticFloorContrast(),
+				capture_configuration->getSyntheticPattern(),
+				SEED
+			);
+			// setup detector and identifier like the people extractor does
+			PeopleDetector detector = createDetector(camera_configuration, backends);
+			PeopleIdentifier identifier(
+				boundary,
+				camera_configuration->getMatchDistance() * pixels_per_meter,
+				camera_configuration->getTrackAcceleration() * pixels_per_meter,
+				camera_configuration->getTrackMeasurementNoise() * pixels_per_meter
+			);
+
+			cv::Mat frame;
+			std::vector<double> milliseconds_detect;
+			std::vector<double> milliseconds_match;
+			Accuracy accuracy_detected;
+			Accuracy accuracy_tracked;
+			// id of the person last matched to every true person, to count how often people swap identities
+			std::vector<int> matches_tracked;
+			std::vector<long long> ids_tracked(amount_people, -1);
+			unsigned long long switches = 0;
+			for (unsigned int i = 0; i < FRAMES_WARMUP + frames_measured; ++i) {
+				source.read(frame);
+				const std::chrono::steady_clock::time_point time_detect = std::chrono::steady_clock::now();
+				std::vector<Vector2> locations = detector.detect(frame);
+				const double millisecond_detect = millisecondsSince(time_detect);
+				const std::chrono::steady_clock::time_point time_match = std::chrono::steady_clock::now();
+				std::vector<Person> people = identifier.match(locations, source.getTimestamp());
+				const double millisecond_match = millisecondsSince(time_match);
+				if (i < FRAMES_WARMUP) {
+					continue;
+				}
+
+				milliseconds_detect.push_back(millisecond_detect);
+				milliseconds_match.push_back(millisecond_match);
+				count(source.getLocations(), locations, DISTANCE_MATCH_METERS * pixels_per_meter, accuracy_detected);
+				std::vector<Vector2> locations_tracked;
+				for (Person& person : people) {
+					locations_tracked.push_back(person.getLocation());
+				}
+				count(source.getLocations(), locations_tracked, DISTANCE_MATCH_METERS * pixels_per_meter, accuracy_tracked, &matches_tracked);
+				for (unsigned int t = 0; t < matches_tracked.size(); ++t) {
+					if (matches_tracked[t] < 0) {
+						continue;
+					}
+					const long long id = people[matches_tracked[t]].getId();
+					if (ids_tracked[t] >= 0 && ids_tracked[t] != id) {
+						++switches;
+					}
+					ids_tracked[t] = id;
+				}
+			}
+
+			double milliseconds_total = 0;
+			for (unsigned int i = 0; i < frames_measured; ++i) {
+				milliseconds_total += milliseconds_detect[i] + milliseconds_match[i];
+			}
+			std::sort(milliseconds_detect.begin(), milliseconds_detect.end());
+			std::sort(milliseconds_match.begin(), milliseconds_match.end());
+			std::cout << std::setw(12) << backends.name
+				<< std::setw(8) << amount_people
+				<< std::setw(12) << percentile(milliseconds_detect, 50)
+				<< std::setw(12) << percentile(milliseconds_detect, 99)
+				<< std::setw(12) << percentile(milliseconds_match, 50)
+				<< std::setw(12) << percentile(milliseconds_match, 99)
+				<< std::setw(8) << (milliseconds_total > 0 ? 1000.0 * frames_measured / milliseconds_total : 0.0)
+				<< std::setw(10) << (double) accuracy_detected.matched / std::max(1ULL, accuracy_detected.truths)
+				<< std::setw(11) << (double) accuracy_detected.matched / std::max(1ULL, accuracy_detected.found)
+				<< std::setw(10) << accuracy_detected.distance_matched / std::max(1ULL, accuracy_detected.matched)
+				<< std::setw(10) << (double) accuracy_tracked.matched / std::max(1ULL, accuracy_tracked.truths)
+				<< std::setw(10) << switches
+				<< std::endl;
+		}
+	}
+}
+
+/**
+ * Measure throughput of every combination of backends on the camera frames of a recording, and how much they agree with the first.
+ *
+ * @param calibration The configuration of the camera
+ * @param filepath    The path of the recording file
+ **/
+void benchmarkRecording(ImoveConfiguration* calibration, const std::string& filepath) {
+	CameraConfiguration* camera_configuration = calibration->getCameraConfiguration();
+	const float pixels_per_meter = camera_configuration->getMeter();
+	RecordingReader reader(filepath);
+	if (!reader.isOpen() || reader.size() == 0) {
+		std::cerr << "No camera frames recorded in " << filepath << std::endl;
+		return;
+	}
+
+	std::cout << "Benchmarking " << reader.size() << " recorded camera frames of " << filepath << std::endl;
+	std::cout << std::setw(12) << "detector"
+		<< std::setw(12) << "detect p50"
+		<< std::setw(12) << "detect p99"
+		<< std::setw(12) << "detect avg"
+		<< std::setw(12) << "blobs/frame"
+		<< std::setw(10) << "agree"
+		<< std::setw(11) << "precision" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	// locations per recorded camera frame found by the first detector
+	std::vector<std::vector<Vector2> > locations_reference(reader.size());
+	for (unsigned int d = 0; d < sizeof(BACKENDS) / sizeof(BACKENDS[0]); ++d) {
+		PeopleDetector detector = createDetector(camera_configuration, BACKENDS[d]);
+
+		cv::Mat frame_recorded;
+		cv::Mat frame_camera;
+		long long timestamp_capture;
+		scene_interface::People people;
+		std::vector<double> milliseconds_detect;
+		unsigned long long blobs = 0;
+		Accuracy accuracy;
+		for (unsigned int i = 0; i < reader.size(); ++i) {
+			reader.read(i, frame_recorded, timestamp_capture, people);
+			// like the people extractor, detect on the camera frame resized to the camera resolution
+			cv::resize(frame_recorded, frame_camera, camera_configuration->getResolution());
+			const std::chrono::steady_clock::time_point time_detect = std::chrono::steady_clock::now();
+			std::vector<Vector2> locations = detector.detect(frame_camera);
+			milliseconds_detect.push_back(millisecondsSince(time_detect));
+			blobs += locations.size();
+			if (d == 0) {
+				locations_reference[i] = locations;
+			} else {
+				count(locations_reference[i], locations, DISTANCE_MATCH_METERS * pixels_per_meter, accuracy);
+			}
+		}
+
+		double milliseconds_total = 0;
+		for (double millisecond_detect : milliseconds_detect) {
+			milliseconds_total += millisecond_detect;
+		}
+		std::sort(milliseconds_detect.begin(), milliseconds_detect.end());
+		std::cout << std::setw(12) << BACKENDS[d].name
+			<< std::setw(12) << percentile(milliseconds_detect, 50)
+			<< std::setw(12) << percentile(milliseconds_detect, 99)
+			<< std::setw(12) << milliseconds_total / milliseconds_detect.size()
+			<< std::setw(12) << (double) blobs / reader.size();
+		if (d == 0) {
+			std::cout << std::setw(10) << "-" << std::setw(11) << "-";
+		} else {
+			std::cout << std::setw(10) << (double) accuracy.matched / std::max(1ULL, accuracy.truths)
+				<< std::setw(11) << (double) accuracy.matched / std::max(1ULL, accuracy.found);
+		}
+		std::cout << std::endl;
+	}
+}
+
+/**
+ * Measure throughput of the background models on a synthetic crowd, the gaussian one with every supported instruction set,
+ * and how much of its foreground agrees with the gaussian one without vector instructions.
+ *
+ * @param calibration     The configuration of the camera and the synthetic crowd
+ * @param frames_measured The amount of camera frames measured
+ **/
+void benchmarkBackgroundModels(ImoveConfiguration* calibration, unsigned int frames_measured) {
+	CameraConfiguration* camera_configuration = calibration->getCameraConfiguration();
+	CaptureConfiguration* capture_configuration = calibration->getCaptureConfiguration();
+	const float learning_rate = camera_configuration->getBackgroundLearningRate();
+	const bool shadows = camera_configuration->getBackgroundShadows();
+
+	// the same camera frames for every background model
+	SyntheticFrameSource source(
+		camera_configuration->getResolution(),
+		camera_configuration->getMeter(),
+		AMOUNT_PEOPLE_BACKGROUND,
+		capture_configuration->getSyntheticFps(),
+		false,
+		capture_configuration->getSyntheticFloorContrast(),
+		capture_configuration->getSyntheticPattern(),
+		SEED
+	);
+	std::vector<cv::Mat> frames(FRAMES_WARMUP + frames_measured);
+	for (cv::Mat& frame : frames) {
+		source.read(frame);
+	}
+
+	std::cout << "Benchmarking background models on " << frames_measured << " camera frames of " << AMOUNT_PEOPLE_BACKGROUND << " people" << std::endl;
+	std::cout << std::setw(12) << "model"
+		<< std::setw(12) << "apply p50"
+		<< std::setw(12) << "apply p99"
+		<< std::setw(8) << "fps"
+		<< std::setw(12) << "foreground"
+		<< std::setw(10) << "agree" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	// foreground masks of the measured camera frames of the gaussian model without vector instructions
+	std::vector<cv::Mat> foregrounds_reference(frames_measured);
+	const int amount_models = 1 + GaussianBackgroundModel::getSupportedInstructionSet() + 1;
+	for (int m = 0; m < amount_models; ++m) {
+		// the knn model first, then the gaussian one from slowest to fastest instruction set
+		cv::Ptr<BackgroundModel> model;
+		std::string name;
+		if (m == 0) {
+			model = cv::Ptr<BackgroundModel>(new KnnBackgroundModel(learning_rate, shadows));
+			name = "knn";
+		} else {
+			const GaussianBackgroundModel::InstructionSet instruction_set = static_cast<GaussianBackgroundModel::InstructionSet>(m - 1);
+			GaussianBackgroundModel* gaussian = new GaussianBackgroundModel(learning_rate, shadows);
+			gaussian->setInstructionSet(instruction_set);
+			model = cv::Ptr<BackgroundModel>(gaussian);
+			name = std::string("gauss/") + GaussianBackgroundModel::getName(instruction_set);
+		}
+
+		cv::Mat foreground;
+		std::vector<double> milliseconds_apply;
+		double foreground_pixels = 0;
+		unsigned long long pixels_agreed = 0;
+		for (unsigned int i = 0; i < frames.size(); ++i) {
+			const std::chrono::steady_clock::time_point time_apply = std::chrono::steady_clock::now();
+			model->apply(frames[i], foreground, true);
+			const double millisecond_apply = millisecondsSince(time_apply);
+			if (i < FRAMES_WARMUP) {
+				continue;
+			}
+
+			milliseconds_apply.push_back(millisecond_apply);
+			foreground_pixels += (double) cv::countNonZero(foreground) / foreground.total();
+			if (m == 1) {
+				foregrounds_reference[i - FRAMES_WARMUP] = foreground.clone();
+			} else if (m > 1) {
+				cv::Mat different;
+				cv::compare(foreground, foregrounds_reference[i - FRAMES_WARMUP], different, cv::CMP_NE);
+				pixels_agreed += foreground.total() - cv::countNonZero(different);
+			}
+		}
+
+		double milliseconds_total = 0;
+		for (double millisecond_apply : milliseconds_apply) {
+			milliseconds_total += millisecond_apply;
+		}
+		std::sort(milliseconds_apply.begin(), milliseconds_apply.end());
+		std::cout << std::setw(12) << name
+			<< std::setw(12) << percentile(milliseconds_apply, 50)
+			<< std::setw(12) << percentile(milliseconds_apply, 99)
+			<< std::setw(8) << (milliseconds_total > 0 ? 1000.0 * frames_measured / milliseconds_total : 0.0)
+			<< std::setw(12) << foreground_pixels / frames_measured;
+		if (m > 1) {
+			std::cout << std::setw(10) << (double) pixels_agreed / (frames_measured * frames[0].total());
+		} else {
+			std::cout << std::setw(10) << "-";
+		}
+		std::cout << std::endl;
+	}
+}
+
+/**
+ * Measure throughput of ingesting camera frames in color and in grayscale, and detecting people in them, on a synthetic crowd captured at a higher resolution,
+ * and how well people are detected in each.
+ *
+ * @param calibration     The configuration of the camera and the synthetic crowd
+ * @param frames_measured The amount of camera frames measured
+ **/
+void benchmarkIngestion(ImoveConfiguration* calibration, unsigned int frames_measured) {
+	CameraConfiguration* camera_configuration = calibration->getCameraConfiguration();
+	CaptureConfiguration* capture_configuration = calibration->getCaptureConfiguration();
+	const cv::Size resolution = camera_configuration->getResolution();
+	const float pixels_per_meter = camera_configuration->getMeter();
+	const Backends backends = { "", camera_configuration->getBlobDetector(), camera_configuration->getBackgroundModel() };
+
+	std::cout << "Benchmarking ingestion of " << frames_measured << " camera frames of "
+		<< resolution.width * FACTOR_CAPTURE_INGESTION << "x" << resolution.height * FACTOR_CAPTURE_INGESTION
+		<< " with " << AMOUNT_PEOPLE_INGESTION << " people" << std::endl;
+	std::cout << std::setw(12) << "ingestion"
+		<< std::setw(12) << "ingest p50"
+		<< std::setw(12) << "detect p50"
+		<< std::setw(12) << "detect p99"
+		<< std::setw(8) << "fps"
+		<< std::setw(10) << "recall"
+		<< std::setw(11) << "precision"
+		<< std::setw(10) << "error px" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	for (unsigned int grayscale = 0; grayscale < 2; ++grayscale) {
+		// the same crowd for both, at a multiple of the camera resolution
+		SyntheticFrameSource source(
+			cv::Size(resolution.width * FACTOR_CAPTURE_INGESTION, resolution.height * FACTOR_CAPTURE_INGESTION),
+			pixels_per_meter * FACTOR_CAPTURE_INGESTION,
+			AMOUNT_PEOPLE_INGESTION,
+			capture_configuration->getSyntheticFps(),
+			false,
+			capture_configuration->getSyntheticFloorContrast(),
+			capture_configuration->getSyntheticPattern(),
+			SEED
+		);
+		PeopleDetector detector = createDetector(camera_configuration, backends);
+
+		cv::Mat frame_captured;
+		cv::Mat frame_camera;
+		std::vector<double> milliseconds_ingest;
+		std::vector<double> milliseconds_detect;
+		Accuracy accuracy;
+		std::vector<Vector2> truths;
+		for (unsigned int i = 0; i < FRAMES_WARMUP + frames_measured; ++i) {
+			source.read(frame_captured);
+			const std::chrono::steady_clock::time_point time_ingest = std::chrono::steady_clock::now();
+			Ingestion::ingest(frame_captured, frame_camera, resolution, grayscale != 0);
+			const double millisecond_ingest = millisecondsSince(time_ingest);
+			const std::chrono::steady_clock::time_point time_detect = std::chrono::steady_clock::now();
+			std::vector<Vector2> locations = detector.detect(frame_camera);
+			const double millisecond_detect = millisecondsSince(time_detect);
+			if (i < FRAMES_WARMUP) {
+				continue;
+			}
+
+			milliseconds_ingest.push_back(millisecond_ingest);
+			milliseconds_detect.push_back(millisecond_detect);
+			// true locations of the captured camera frame in the camera resolution
+			truths.clear();
+			for (const Vector2& location : source.getLocations()) {
+				truths.push_back(Vector2(location.x / FACTOR_CAPTURE_INGESTION, location.y / FACTOR_CAPTURE_INGESTION));
+			}
+			count(truths, locations, DISTANCE_MATCH_METERS * pixels_per_meter, accuracy);
+		}
+
+		double milliseconds_total = 0;
+		for (unsigned int i = 0; i < frames_measured; ++i) {
+			milliseconds_total += milliseconds_ingest[i] + milliseconds_detect[i];
+		}
+		std::sort(milliseconds_ingest.begin(), milliseconds_ingest.end());
+		std::sort(milliseconds_detect.begin(), milliseconds_detect.end());
+		std::cout << std::setw(12) << (grayscale != 0 ? "gray" : "bgr")
+			<< std::setw(12) << percentile(milliseconds_ingest, 50)
+			<< std::setw(12) << percentile(milliseconds_detect, 50)
+			<< std::setw(12) << percentile(milliseconds_detect, 99)
+			<< std::setw(8) << (milliseconds_total > 0 ? 1000.0 * frames_measured / milliseconds_total : 0.0)
+			<< std::setw(10) << (double) accuracy.matched / std::max(1ULL, accuracy.truths)
+			<< std::setw(11) << (double) accuracy.matched / std::max(1ULL, accuracy.found)
+			<< std::setw(10) << accuracy.distance_matched / std::max(1ULL, accuracy.matched)
+			<< std::endl;
+	}
+}
+
+/**
+ * Measure throughput of detecting people with the connected components blob detector on the gaussian background model on growing amounts of threads,
+ * and whether the blobs found are exactly the same as on one thread.
+ *
+ * @param calibration     The configuration of the camera and the synthetic crowd
+ * @param frames_measured The amount of camera frames measured
+ **/
+void benchmarkThreads(ImoveConfiguration* calibration, unsigned int frames_measured) {
+	CameraConfiguration* camera_configuration = calibration->getCameraConfiguration();
+	CaptureConfiguration* capture_configuration = calibration->getCaptureConfiguration();
+
+	// the same camera frames for every amount of threads
+	SyntheticFrameSource source(
+		camera_configuration->getResolution(),
+		camera_configuration->getMeter(),
+		AMOUNT_PEOPLE_BACKGROUND,
+		capture_configuration->getSyntheticFps(),
+		false,
+		capture_configuration->getSyntheticFloorContrast(),
+		capture_configuration->getSyntheticPattern(),
+		SEED
+	);
+	std::vector<cv::Mat> frames(FRAMES_WARMUP + frames_measured);
+	for (cv::Mat& frame : frames) {
+		source.read(frame);
+	}
+
+	std::cout << "Benchmarking threads of " << BACKENDS[2].name << " on " << frames_measured << " camera frames of " << AMOUNT_PEOPLE_BACKGROUND
+		<< " people, " << cv::getNumberOfCPUs() << " cores" << std::endl;
+	std::cout << std::setw(12) << "threads"
+		<< std::setw(12) << "detect p50"
+		<< std::setw(12) << "detect p99"
+		<< std::setw(8) << "fps"
+		<< std::setw(10) << "speedup"
+		<< std::setw(11) << "identical" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+
+	const int threads_previous = cv::getNumThreads();
+	// blobs of every measured camera frame found on one thread, and the frames per second there
+	std::vector<std::vector<Blob> > blobs_reference(frames_measured);
+	double fps_reference = 0;
+	for (int threads : AMOUNTS_THREADS) {
+		cv::setNumThreads(threads);
+		PeopleDetector detector = createDetector(camera_configuration, BACKENDS[2]);
+
+		std::vector<double> milliseconds_detect;
+		unsigned int frames_identical = 0;
+		for (unsigned int i = 0; i < frames.size(); ++i) {
+			const std::chrono::steady_clock::time_point time_detect = std::chrono::steady_clock::now();
+			detector.detect(frames[i]);
+			const double millisecond_detect = millisecondsSince(time_detect);
+			if (i < FRAMES_WARMUP) {
+				continue;
+			}
+
+			milliseconds_detect.push_back(millisecond_detect);
+			const std::vector<Blob>& blobs = detector.getBlobs();
+			std::vector<Blob>& blobs_expected = blobs_reference[i - FRAMES_WARMUP];
+			if (threads == AMOUNTS_THREADS[0]) {
+				blobs_expected = blobs;
+				continue;
+			}
+			bool identical = blobs.size() == blobs_expected.size();
+			for (unsigned int b = 0; identical && b < blobs.size(); ++b) {
+				identical = blobs[b].location.x == blobs_expected[b].location.x && blobs[b].location.y == blobs_expected[b].location.y
+					&& blobs[b].area == blobs_expected[b].area && blobs[b].bounding_box == blobs_expected[b].bounding_box;
+			}
+			frames_identical += identical;
+		}
+
+		double milliseconds_total = 0;
+		for (double millisecond_detect : milliseconds_detect) {
+			milliseconds_total += millisecond_detect;
+		}
+		const double fps = milliseconds_total > 0 ? 1000.0 * frames_measured / milliseconds_total : 0.0;
+		if (threads == AMOUNTS_THREADS[0]) {
+			fps_reference = fps;
+		}
+		std::sort(milliseconds_detect.begin(), milliseconds_detect.end());
+		std::cout << std::setw(12) << threads
+			<< std::setw(12) << percentile(milliseconds_detect, 50)
+			<< std::setw(12) << percentile(milliseconds_detect, 99)
+			<< std::setw(8) << fps
+			<< std::setw(10) << (fps_reference > 0 ? fps / fps_reference : 0.0);
+		if (threads == AMOUNTS_THREADS[0]) {
+			std::cout << std::setw(11) << "-";
+		} else {
+			std::cout << std::setw(11) << (double) frames_identical / frames_measured;
+		}
+		std::cout << std::endl;
+	}
+	cv::setNumThreads(threads_previous);
+}
+
+// Measure throughput and accuracy of detecting and identifying people in synthetic crowds, and optionally of detecting on a recording
+int main(int argc, char* argv[]) {
+	// show parameters if not given 1 to 3 parameters
+	if (argc < 2 || argc > 4) {
+		std::cerr << "Usage: <path to configuration file> [<camera frames per crowd> [<path to recording file>]]" << std::endl;
+		return EXIT_SUCCESS;
+	}
+	ImoveConfiguration* calibration = ImoveConfiguration::readFile(argv[CONFIGURATION_ARGN]);
+	const unsigned int frames_measured = argc >= 3 ? static_cast<unsigned int>(std::max(1, std::atoi(argv[FRAMES_ARGN]))) : FRAMES_DEFAULT;
+
+	benchmarkSynthetic(calibration, frames_measured);
+	std::cout << std::endl;
+	benchmarkBackgroundModels(calibration, frames_measured);
+	std::cout << std::endl;
+	benchmarkIngestion(calibration, frames_measured);
+	std::cout << std::endl;
+	benchmarkThreads(calibration, frames_measured);
+	if (argc == 4) {
+		std::cout << std::endl;
+		benchmarkRecording(calibration, argv[RECORDING_ARGN]);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,46 @@
+#include <iostream>
+
+#include "CameraFrameSource.hpp"
+
+CameraFrameSource::CameraFrameSource(int deviceid, bool yuv) : video_capture(deviceid), yuv(yuv) {
+	if (this->yuv) {
+		this->size = cv::Size(
+			static_cast<int>(this->video_capture.get(cv::CAP_PROP_FRAME_WIDTH)),
+			static_cast<int>(this->video_capture.get(cv::CAP_PROP_FRAME_HEIGHT))
+		);
+		this->video_capture.set(cv::CAP_PROP_CONVERT_RGB, 0);
+	}
+}
+
+CameraFrameSource::~CameraFrameSource() {
+	// safe release video capture
+	this->video_capture.release();
+}
+
+bool CameraFrameSource::read(cv::Mat& frame) {
+	return this->grab() && this->retrieve(frame);
+}
+
+bool CameraFrameSource::grab() {
+	return this->video_capture.grab();
+}
+
+bool CameraFrameSource::retrieve(cv::Mat& frame) {
+	if (!this->video_capture.retrieve(frame)) {
+		return false;
+	}
+	if (!this->yuv || (frame.type() == CV_8UC2 && frame.size() == this->size)) {
+		return true;
+	}
+	// backends hand out unconverted camera frames as one row of raw bytes, which is packed YUYV when it holds 2 bytes per pixel
+	if (frame.isContinuous() && frame.depth() == CV_8U && frame.total() * frame.elemSize() == this->size.area() * 2u) {
+		frame = frame.reshape(2, this->size.height);
+		return true;
+	}
+	// compressed or other formats are converted to BGR by the backend from now on
+	std::cerr << "Camera delivers no YUYV camera frames, converting them to BGR" << std::endl;
+	this->yuv = false;
+	this->video_capture.set(cv::CAP_PROP_CONVERT_RGB, 1);
+	// the grabbed camera frame is of the old format, take the next one converted
+	return this->video_capture.read(frame);
+}
@@ -0,0 +1,34 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_CAMERAFRAMESOURCE_H
+#define IMOVE_PEOPLEEXTRACTOR_CAMERAFRAMESOURCE_H
+
+#include <opencv2/opencv.hpp>
+
+#include "FrameSource.hpp"
+
+// Camera frames from a camera device
+class CameraFrameSource : public FrameSource {
+	public:
+		/**
+		 * Open the camera device.
+		 *
+		 * @param deviceid The id of the camera device
+		 * @param yuv      Whether to read the native packed YUYV camera frames as 2 channels of luma and alternating chroma instead of converting them to BGR
+		 **/
+		CameraFrameSource(int deviceid, bool yuv = false);
+		~CameraFrameSource();
+
+		bool read(cv::Mat& frame);
+
+		bool grab();
+
+		bool retrieve(cv::Mat& frame);
+
+	private:
+		cv::VideoCapture video_capture;
+		// whether camera frames are read as packed YUYV, which stops when the camera delivers another format
+		bool yuv;
+		// size of the camera frames, to recognize raw YUYV buffers
+		cv::Size size;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_CAMERAFRAMESOURCE_H
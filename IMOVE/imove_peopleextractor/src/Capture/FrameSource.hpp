@@ -0,0 +1,44 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_FRAMESOURCE_H
+#define IMOVE_PEOPLEEXTRACTOR_FRAMESOURCE_H
+
+#include <opencv2/opencv.hpp>
+
+// Source of camera frames for the people extractor
+class FrameSource {
+	public:
+		virtual ~FrameSource() {}
+
+		/**
+		 * Read the next camera frame, waits till it is available.
+		 *
+		 * @param frame The read camera frame, only valid till the next read
+		 * @return false when there are no more camera frames
+		 **/
+		virtual bool read(cv::Mat& frame) = 0;
+
+		/**
+		 * Grab the next camera frame without decoding it, waits till it is available. Sources which decode on reading read it into a buffer of their own.
+		 *
+		 * @return false when there are no more camera frames
+		 **/
+		virtual bool grab() {
+			return this->read(this->frame_grabbed);
+		}
+
+		/**
+		 * Decode the camera frame grabbed last, so camera frames which are skipped are never decoded.
+		 *
+		 * @param frame The grabbed camera frame, owned by the caller
+		 * @return false when the camera frame can not be decoded
+		 **/
+		virtual bool retrieve(cv::Mat& frame) {
+			this->frame_grabbed.copyTo(frame);
+			return !frame.empty();
+		}
+
+	protected:
+		// camera frame read by grab, only valid till the next grab
+		cv::Mat frame_grabbed;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_FRAMESOURCE_H
@@ -0,0 +1,102 @@
+#include <chrono>
+
+#include "FreshestFrameSource.hpp"
+
+static long long nowNanoseconds() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FreshestFrameSource::FreshestFrameSource(FrameSource* source) :
+	source(source),
+	frame_reader(NULL),
+	timestamp_grabbed(0),
+	finished(false),
+	stopping(false),
+	dropped(0),
+	grabbed(0),
+	timestamp_capture(0),
+	thread_grab(&FreshestFrameSource::grabContinuously, this)
+{}
+
+FreshestFrameSource::~FreshestFrameSource() {
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stopping = true;
+	}
+	// the grabber stops after the camera frame it is grabbing
+	this->thread_grab.join();
+	delete this->source;
+}
+
+bool FreshestFrameSource::read(cv::Mat& frame) {
+	std::unique_lock<std::mutex> lock(this->mutex);
+	if (this->finished) {
+		return false;
+	}
+	// the grabber decodes the next camera frame in the frame and clears the pointer once done
+	this->frame_reader = &frame;
+	this->condition.wait(lock, [this] { return this->frame_reader == NULL || this->finished; });
+	if (this->frame_reader != NULL) {
+		this->frame_reader = NULL;
+		return false;
+	}
+	this->timestamp_capture = this->timestamp_grabbed;
+	return true;
+}
+
+long long FreshestFrameSource::getTimestampCapture() const {
+	return this->timestamp_capture;
+}
+
+unsigned long long FreshestFrameSource::getDropped() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->dropped;
+}
+
+unsigned long long FreshestFrameSource::getGrabbed() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->grabbed;
+}
+
+void FreshestFrameSource::grabContinuously() {
+	while (true) {
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			if (this->stopping) {
+				return;
+			}
+		}
+		bool available = this->source->grab();
+		// time the camera frame when it is grabbed, decoding it takes time after
+		const long long timestamp = nowNanoseconds();
+		cv::Mat* frame_reader = NULL;
+		if (available) {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			++this->grabbed;
+			frame_reader = this->frame_reader;
+			if (frame_reader == NULL) {
+				++this->dropped;
+			}
+		}
+		// decode outside the lock, straight into the frame of the reader which only waits meanwhile
+		if (frame_reader != NULL) {
+			available = this->source->retrieve(*frame_reader);
+		}
+		if (!available) {
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->finished = true;
+			}
+			this->condition.notify_one();
+			return;
+		}
+		if (frame_reader != NULL) {
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->frame_reader = NULL;
+				this->timestamp_grabbed = timestamp;
+			}
+			this->condition.notify_one();
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_FRESHESTFRAMESOURCE_H
+#define IMOVE_PEOPLEEXTRACTOR_FRESHESTFRAMESOURCE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "FrameSource.hpp"
+
+// Camera frames from another source grabbed continuously on a grabber thread, of which only the first grabbed while the reader waits is decoded and handed off, so a slow pipeline never works on camera frames buffered by the source
+class FreshestFrameSource : public FrameSource {
+	public:
+		/**
+		 * Start grabbing camera frames.
+		 *
+		 * @param source The source to grab camera frames from, deleted with this source
+		 **/
+		FreshestFrameSource(FrameSource* source);
+		~FreshestFrameSource();
+
+		/**
+		 * Take the next grabbed camera frame, which is decoded straight into the frame while waiting.
+		 *
+		 * @param frame The newest camera frame, owned by the caller
+		 * @return false when the source has no more camera frames
+		 **/
+		bool read(cv::Mat& frame);
+
+		// Gets the steady clock nanoseconds on which the last read camera frame was grabbed
+		long long getTimestampCapture() const;
+
+		// Gets the amount of grabbed camera frames skipped without decoding, as no read was waiting for them
+		unsigned long long getDropped() const;
+
+		// Gets the amount of grabbed camera frames
+		unsigned long long getGrabbed() const;
+
+	private:
+		FrameSource* source;
+
+		// frame of the waiting reader the next grabbed camera frame is decoded in, NULL while no reader waits, and the grab time of it; guarded by the mutex
+		cv::Mat* frame_reader;
+		long long timestamp_grabbed;
+		// whether the source has no more camera frames or this source is deleted
+		bool finished;
+		bool stopping;
+		unsigned long long dropped;
+		unsigned long long grabbed;
+		mutable std::mutex mutex;
+		// notifies the reader on a decoded camera frame
+		std::condition_variable condition;
+
+		// grab time of the last read camera frame, only used by the reader
+		long long timestamp_capture;
+
+		std::thread thread_grab;
+
+		// Grab camera frames from the source and decode the ones a reader waits for, till it has no more or this source is deleted
+		void grabContinuously();
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_FRESHESTFRAMESOURCE_H
@@ -0,0 +1,187 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "Recording.hpp"
+
+using namespace recording;
+
+/**
+ * Write all bytes, continuing after partial writes.
+ *
+ * @return false on failure
+ **/
+static bool writeAll(int file, const void* data, std::size_t size) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	while (size > 0) {
+		const ssize_t written = ::write(file, bytes, size);
+		if (written <= 0) {
+			return false;
+		}
+		bytes += written;
+		size -= written;
+	}
+	return true;
+}
+
+RecordingWriter::RecordingWriter(const std::string& filepath) {
+	this->file = open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (this->file < 0) {
+		std::cerr << "Failing to create recording " << filepath << ": " << std::strerror(errno) << std::endl;
+		return;
+	}
+	FileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	if (!writeAll(this->file, &header, sizeof(header))) {
+		std::cerr << "Failing to write recording " << filepath << std::endl;
+		close(this->file);
+		this->file = -1;
+	}
+}
+
+RecordingWriter::~RecordingWriter() {
+	if (this->file >= 0) {
+		close(this->file);
+	}
+}
+
+bool RecordingWriter::isOpen() const {
+	return this->file >= 0;
+}
+
+bool RecordingWriter::write(const cv::Mat& frame, long long timestamp_capture, const scene_interface::People& people) {
+	if (this->file < 0) {
+		return false;
+	}
+	const std::size_t size_row = frame.cols * frame.elemSize();
+	const std::size_t size_pixels = align(size_row * frame.rows);
+	const std::size_t size_people = people.size() * sizeof(RecordedPerson);
+
+	RecordHeader header;
+	std::memset(&header, 0, sizeof(header));
+	header.size_record = sizeof(RecordHeader) + size_pixels + size_people;
+	header.timestamp_capture = timestamp_capture;
+	header.rows = frame.rows;
+	header.cols = frame.cols;
+	header.type = frame.type();
+	header.step = size_row;
+	header.amount_people = people.size();
+	if (!writeAll(this->file, &header, sizeof(header))) {
+		return false;
+	}
+
+	// pixels in one write when continuous, otherwise row by row, padded to the record alignment
+	if (frame.isContinuous()) {
+		if (!writeAll(this->file, frame.data, size_row * frame.rows)) {
+			return false;
+		}
+	} else {
+		for (int y = 0; y < frame.rows; ++y) {
+			if (!writeAll(this->file, frame.ptr(y), size_row)) {
+				return false;
+			}
+		}
+	}
+	const unsigned char padding[8] = { 0 };
+	if (!writeAll(this->file, padding, size_pixels - size_row * frame.rows)) {
+		return false;
+	}
+
+	this->buffer_people.resize(size_people);
+	RecordedPerson* recorded_people = reinterpret_cast<RecordedPerson*>(this->buffer_people.data());
+	for (std::size_t i = 0; i < people.size(); ++i) {
+		const scene_interface::Person& person = people[i];
+		std::memset(&recorded_people[i], 0, sizeof(RecordedPerson));
+		recorded_people[i].id = person.getId();
+		recorded_people[i].x = person.getLocation().getX();
+		recorded_people[i].y = person.getLocation().getY();
+		recorded_people[i].person_type = person.getPersonType();
+		recorded_people[i].movement_type = person.getMovementType();
+		recorded_people[i].velocity_x = person.getVelocity().getX();
+		recorded_people[i].velocity_y = person.getVelocity().getY();
+	}
+	return writeAll(this->file, this->buffer_people.data(), size_people);
+}
+
+RecordingReader::RecordingReader(const std::string& filepath) : memory(NULL), size_memory(0) {
+	const int file = open(filepath.c_str(), O_RDONLY);
+	if (file < 0) {
+		std::cerr << "Failing to open recording " << filepath << ": " << std::strerror(errno) << std::endl;
+		return;
+	}
+	struct stat status;
+	if (fstat(file, &status) != 0 || (std::size_t) status.st_size < sizeof(FileHeader)) {
+		std::cerr << "Failing to read recording " << filepath << std::endl;
+		close(file);
+		return;
+	}
+	// private mapping so camera frames can be changed in place without changing the file
+	void* memory = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+	close(file);
+	if (memory == MAP_FAILED) {
+		std::cerr << "Failing to map recording " << filepath << ": " << std::strerror(errno) << std::endl;
+		return;
+	}
+	madvise(memory, status.st_size, MADV_SEQUENTIAL);
+	this->memory = static_cast<unsigned char*>(memory);
+	this->size_memory = status.st_size;
+
+	const FileHeader* header = reinterpret_cast<const FileHeader*>(this->memory);
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+		std::cerr << "Not a recording of this version " << filepath << std::endl;
+		munmap(this->memory, this->size_memory);
+		this->memory = NULL;
+		return;
+	}
+
+	// index all complete records, a record cut off by stopping while recording is skipped
+	std::size_t offset = sizeof(FileHeader);
+	while (offset + sizeof(RecordHeader) <= this->size_memory) {
+		const RecordHeader* record = reinterpret_cast<const RecordHeader*>(this->memory + offset);
+		if (record->size_record < sizeof(RecordHeader) || offset + record->size_record > this->size_memory) {
+			break;
+		}
+		this->offsets.push_back(offset);
+		offset += record->size_record;
+	}
+}
+
+RecordingReader::~RecordingReader() {
+	if (this->memory != NULL) {
+		munmap(this->memory, this->size_memory);
+	}
+}
+
+bool RecordingReader::isOpen() const {
+	return this->memory != NULL;
+}
+
+unsigned int RecordingReader::size() const {
+	return this->offsets.size();
+}
+
+void RecordingReader::read(unsigned int index, cv::Mat& frame, long long& timestamp_capture, scene_interface::People& people) const {
+	unsigned char* record = this->memory + this->offsets[index];
+	const RecordHeader* header = reinterpret_cast<const RecordHeader*>(record);
+	unsigned char* pixels = record + sizeof(RecordHeader);
+	frame = cv::Mat(header->rows, header->cols, header->type, pixels, header->step);
+	timestamp_capture = header->timestamp_capture;
+
+	const RecordedPerson* recorded_people = reinterpret_cast<const RecordedPerson*>(pixels + align((std::size_t) header->step * header->rows));
+	people.clear();
+	for (uint32_t i = 0; i < header->amount_people; ++i) {
+		people.push_back(scene_interface::Person(
+			recorded_people[i].id,
+			scene_interface::Location(recorded_people[i].x, recorded_people[i].y),
+			(scene_interface::Person::PersonType) recorded_people[i].person_type,
+			(scene_interface::Person::MovementType) recorded_people[i].movement_type,
+			scene_interface::Location(recorded_people[i].velocity_x, recorded_people[i].velocity_y)
+		));
+	}
+}
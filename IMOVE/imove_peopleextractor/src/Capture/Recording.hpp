@@ -0,0 +1,124 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_RECORDING_H
+#define IMOVE_PEOPLEEXTRACTOR_RECORDING_H
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../../scene_interface/src/People.h"
+
+/**
+ * Container file of camera frames with their capture time and the people extracted from them.
+ * The file starts with a header, followed by one record per camera frame: a record header, the pixels row after row
+ * and the extracted people. Records are padded to 8 bytes so the file can be memory mapped and read in place.
+ **/
+namespace recording {
+	// Identifies a recording file and the version of its layout
+	const char MAGIC[8] = { 'I', 'M', 'O', 'V', 'E', 'R', 'E', 'C' };
+	const uint32_t VERSION = 1;
+
+	struct FileHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t reserved;
+	};
+
+	struct RecordHeader {
+		// bytes of the whole record including this header
+		uint64_t size_record;
+		// steady clock nanoseconds on which the camera frame is captured
+		int64_t timestamp_capture;
+		// camera frame layout
+		int32_t rows;
+		int32_t cols;
+		int32_t type;
+		uint32_t step;
+		uint32_t amount_people;
+		uint32_t reserved;
+	};
+
+	struct RecordedPerson {
+		uint32_t id;
+		float x;
+		float y;
+		int32_t person_type;
+		int32_t movement_type;
+		// velocity in the units of the location per second, 0 when the people extractor does not estimate it
+		float velocity_x;
+		float velocity_y;
+		uint32_t reserved;
+	};
+	static_assert(sizeof(RecordedPerson) % 8 == 0, "Recorded people keep records aligned");
+
+	// Rounds a size up to the record alignment
+	inline std::size_t align(std::size_t size) {
+		return (size + 7) & ~static_cast<std::size_t>(7);
+	}
+}
+
+// Appends camera frames and extracted people to a recording file
+class RecordingWriter {
+	public:
+		/**
+		 * Create recording file, overwriting an existing one.
+		 *
+		 * @param filepath The path of the recording file
+		 **/
+		RecordingWriter(const std::string& filepath);
+		~RecordingWriter();
+
+		// Whether the recording file could be created
+		bool isOpen() const;
+
+		/**
+		 * Append a camera frame with the people extracted from it.
+		 *
+		 * @param frame             The camera frame as captured
+		 * @param timestamp_capture The steady clock nanoseconds on which the camera frame is captured
+		 * @param people            The people extracted from the camera frame
+		 * @return false when the record could not be written completely
+		 **/
+		bool write(const cv::Mat& frame, long long timestamp_capture, const scene_interface::People& people);
+
+	private:
+		int file;
+		std::vector<unsigned char> buffer_people;
+};
+
+// Reads camera frames and extracted people from a memory mapped recording file without copying
+class RecordingReader {
+	public:
+		/**
+		 * Map recording file in memory and find all complete records.
+		 *
+		 * @param filepath The path of the recording file
+		 **/
+		RecordingReader(const std::string& filepath);
+		~RecordingReader();
+
+		// Whether the recording file could be mapped and is a recording
+		bool isOpen() const;
+
+		// Amount of complete records
+		unsigned int size() const;
+
+		/**
+		 * Read a record.
+		 *
+		 * @param index             The index of the record
+		 * @param frame             The camera frame, pointing into the mapped file
+		 * @param timestamp_capture The steady clock nanoseconds on which the camera frame is captured
+		 * @param people            The people extracted from the camera frame
+		 **/
+		void read(unsigned int index, cv::Mat& frame, long long& timestamp_capture, scene_interface::People& people) const;
+
+	private:
+		unsigned char* memory;
+		std::size_t size_memory;
+		// offset of every complete record
+		std::vector<std::size_t> offsets;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_RECORDING_H
@@ -0,0 +1,45 @@
+#include <iostream>
+#include <thread>
+
+#include "ReplayFrameSource.hpp"
+
+ReplayFrameSource::ReplayFrameSource(const std::string& filepath, bool realtime) :
+	reader(filepath),
+	realtime(realtime),
+	index(0),
+	timestamp_capture(0),
+	timestamp_capture_replayed(0),
+	timestamp_capture_start(0)
+{
+	std::cout << "Replaying " << this->reader.size() << " camera frames from " << filepath << std::endl;
+}
+
+bool ReplayFrameSource::read(cv::Mat& frame) {
+	if (!this->reader.isOpen() || this->index >= this->reader.size()) {
+		return false;
+	}
+	this->reader.read(this->index, frame, this->timestamp_capture, this->people);
+	if (this->realtime) {
+		if (this->index == 0) {
+			this->time_start = std::chrono::steady_clock::now();
+			this->timestamp_capture_start = this->timestamp_capture;
+		} else {
+			// wait till the time the camera frame was captured relative to the first one
+			std::this_thread::sleep_until(this->time_start + std::chrono::nanoseconds(this->timestamp_capture - this->timestamp_capture_start));
+		}
+		this->timestamp_capture_replayed = std::chrono::duration_cast<std::chrono::nanoseconds>(this->time_start.time_since_epoch()).count()
+			+ this->timestamp_capture - this->timestamp_capture_start;
+	} else {
+		this->timestamp_capture_replayed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	++this->index;
+	return true;
+}
+
+const scene_interface::People& ReplayFrameSource::getPeople() const {
+	return this->people;
+}
+
+long long ReplayFrameSource::getTimestampCapture() const {
+	return this->timestamp_capture_replayed;
+}
@@ -0,0 +1,46 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_REPLAYFRAMESOURCE_H
+#define IMOVE_PEOPLEEXTRACTOR_REPLAYFRAMESOURCE_H
+
+#include <chrono>
+#include <string>
+
+#include "FrameSource.hpp"
+#include "Recording.hpp"
+
+// Camera frames and extracted people from a recording, on recorded speed or as fast as possible
+class ReplayFrameSource : public FrameSource {
+	public:
+		/**
+		 * Open the recording.
+		 *
+		 * @param filepath The path of the recording file
+		 * @param realtime Whether to wait between camera frames like when recorded
+		 **/
+		ReplayFrameSource(const std::string& filepath, bool realtime);
+
+		bool read(cv::Mat& frame);
+
+		// Gets the people extracted when recording the last read camera frame
+		const scene_interface::People& getPeople() const;
+
+		// Gets the steady clock nanoseconds on which the last read camera frame is captured on the clock of replaying: its recorded capture time
+		// moved to the start of the replay when replaying on recorded speed, so camera frames keep their recorded spacing, otherwise the time it is read
+		long long getTimestampCapture() const;
+
+	private:
+		RecordingReader reader;
+		const bool realtime;
+		// index of next record
+		unsigned int index;
+
+		// recorded capture time of the last read camera frame, and the same on the clock of replaying
+		long long timestamp_capture;
+		long long timestamp_capture_replayed;
+		scene_interface::People people;
+
+		// time of replaying the first record and its recorded capture time, to replay the rest relative to it
+		std::chrono::steady_clock::time_point time_start;
+		long long timestamp_capture_start;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_REPLAYFRAMESOURCE_H
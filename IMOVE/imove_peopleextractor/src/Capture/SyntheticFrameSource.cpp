@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "SyntheticFrameSource.hpp"
+
+// Radius of a person seen from above in meters, about the width of the shoulders
+const float RADIUS_PERSON_METERS = 0.25;
+// Walking speed of people in meters per second
+const float SPEED_MINIMUM_METERS = 0.6;
+const float SPEED_MAXIMUM_METERS = 1.6;
+// Maximum change of walking direction in radians per second
+const float TURN_MAXIMUM_RADIANS = 1.0;
+// Chance per second that a walking person stops, and how long for in seconds
+const float CHANCE_STOP = 0.1;
+const float SECONDS_STOP_MINIMUM = 1.0;
+const float SECONDS_STOP_MAXIMUM = 4.0;
+// Chance per second that a walking person walks up to another, and how long they stay together in seconds
+const float CHANCE_GROUP = 0.05;
+const float SECONDS_GROUP_MINIMUM = 2.0;
+const float SECONDS_GROUP_MAXIMUM = 6.0;
+// Camera frames per second people move at when camera frames are generated as fast as possible
+const unsigned int FPS_UNPACED = 30;
+
+// Gray level of the floor around which the texture varies
+const int GRAY_FLOOR = 120;
+// Range of gray levels of the clothing of people
+const int GRAY_PERSON_MINIMUM = 20;
+const int GRAY_PERSON_MAXIMUM = 90;
+// Amount of precomputed sensor noise frames and their amplitude in gray levels
+const unsigned int AMOUNT_FRAMES_NOISE = 8;
+const int AMPLITUDE_NOISE = 4;
+// Width in meters of the bands of the projected pattern, their speed in meters per second and their brightness in gray levels
+const float WIDTH_PATTERN_METERS = 1.5;
+const float SPEED_PATTERN_METERS = 0.5;
+const float AMPLITUDE_PATTERN = 60;
+
+SyntheticFrameSource::SyntheticFrameSource(const cv::Size& resolution, float pixels_per_meter, unsigned int amount_people, unsigned int fps, bool realtime, unsigned int floor_contrast, bool pattern, unsigned int seed) :
+	resolution(resolution),
+	pixels_per_meter(pixels_per_meter),
+	seconds_frame(1.f / (fps == 0 ? FPS_UNPACED : fps)),
+	realtime(realtime && fps != 0),
+	pattern(pattern),
+	rng(seed),
+	people(amount_people),
+	locations(amount_people),
+	frames(0)
+{
+	const float radius = this->getRadius();
+	// place people randomly on the floor
+	for (SyntheticPerson& person : this->people) {
+		person.location = cv::Point2f(
+			this->rng.uniform(radius, std::max(radius + 1, resolution.width - radius)),
+			this->rng.uniform(radius, std::max(radius + 1, resolution.height - radius))
+		);
+		person.velocity = this->createVelocity();
+		person.frames_stopped = 0;
+		person.index_group = -1;
+		person.frames_grouped = 0;
+		person.gray = static_cast<unsigned char>(this->rng.uniform(GRAY_PERSON_MINIMUM, GRAY_PERSON_MAXIMUM));
+	}
+
+	// floor of tiles of half a meter with slightly different gray levels and grain
+	this->frame_floor = cv::Mat(resolution, CV_8UC3, cv::Scalar::all(GRAY_FLOOR));
+	const int contrast = floor_contrast;
+	if (contrast > 0) {
+		const int size_tile = std::max(1, static_cast<int>(pixels_per_meter / 2));
+		for (int y = 0; y < resolution.height; y += size_tile) {
+			for (int x = 0; x < resolution.width; x += size_tile) {
+				const int gray_tile = GRAY_FLOOR + this->rng.uniform(-contrast / 2, contrast / 2 + 1);
+				cv::rectangle(this->frame_floor, cv::Rect(x, y, size_tile, size_tile), cv::Scalar::all(gray_tile), CV_FILLED);
+			}
+		}
+		cv::Mat grain(resolution, CV_8UC3);
+		this->rng.fill(grain, cv::RNG::UNIFORM, 0, contrast / 2 + 1);
+		cv::add(this->frame_floor, grain, this->frame_floor);
+		cv::subtract(this->frame_floor, cv::Scalar::all(contrast / 4), this->frame_floor);
+	}
+
+	// sensor noise around zero, added and then subtracted by its amplitude as frames are unsigned
+	this->frames_noise.resize(AMOUNT_FRAMES_NOISE);
+	for (cv::Mat& frame_noise : this->frames_noise) {
+		frame_noise.create(resolution, CV_8UC3);
+		this->rng.fill(frame_noise, cv::RNG::UNIFORM, 0, 2 * AMPLITUDE_NOISE + 1);
+	}
+	this->row_pattern.create(1, resolution.width, CV_8UC3);
+}
+
+bool SyntheticFrameSource::read(cv::Mat& frame) {
+	if (this->realtime) {
+		if (this->frames == 0) {
+			this->time_start = std::chrono::steady_clock::now();
+		} else {
+			// wait till the time of the camera frame relative to the first one
+			std::this_thread::sleep_until(this->time_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(this->frames * this->seconds_frame)));
+		}
+	}
+	this->step();
+	this->render(frame);
+	++this->frames;
+	return true;
+}
+
+const std::vector<Vector2>& SyntheticFrameSource::getLocations() const {
+	return this->locations;
+}
+
+float SyntheticFrameSource::getRadius() const {
+	return std::max(1.f, this->pixels_per_meter * RADIUS_PERSON_METERS);
+}
+
+long long SyntheticFrameSource::getTimestamp() const {
+	return this->frames == 0 ? 0 : static_cast<long long>((this->frames - 1) * this->seconds_frame * 1e9);
+}
+
+void SyntheticFrameSource::step() {
+	const float radius = this->getRadius();
+	for (unsigned int i = 0; i < this->people.size(); ++i) {
+		SyntheticPerson& person = this->people[i];
+		if (person.frames_stopped > 0) {
+			--person.frames_stopped;
+		} else if (person.index_group >= 0) {
+			if (person.frames_grouped == 0) {
+				// leave the group in a new direction
+				person.index_group = -1;
+				person.velocity = this->createVelocity();
+			} else {
+				--person.frames_grouped;
+				// walk up to the other person till their blobs touch and merge
+				const cv::Point2f difference = this->people[person.index_group].location - person.location;
+				const float distance = std::sqrt(difference.dot(difference));
+				const float speed = std::sqrt(person.velocity.dot(person.velocity));
+				if (distance > 2 * radius) {
+					person.location += difference * (std::min(speed, distance - 2 * radius) / distance);
+				}
+			}
+		} else if (this->rng.uniform(0.f, 1.f) < CHANCE_STOP * this->seconds_frame) {
+			person.frames_stopped = this->createFrames(SECONDS_STOP_MINIMUM, SECONDS_STOP_MAXIMUM);
+		} else if (this->people.size() > 1 && this->rng.uniform(0.f, 1.f) < CHANCE_GROUP * this->seconds_frame) {
+			// pick anyone but this person
+			const int index_other = this->rng.uniform(0, static_cast<int>(this->people.size()) - 1);
+			person.index_group = index_other >= static_cast<int>(i) ? index_other + 1 : index_other;
+			person.frames_grouped = this->createFrames(SECONDS_GROUP_MINIMUM, SECONDS_GROUP_MAXIMUM);
+		} else {
+			// wander slightly off the walking direction
+			const float angle = this->rng.uniform(-TURN_MAXIMUM_RADIANS, TURN_MAXIMUM_RADIANS) * this->seconds_frame;
+			person.velocity = cv::Point2f(
+				person.velocity.x * std::cos(angle) - person.velocity.y * std::sin(angle),
+				person.velocity.x * std::sin(angle) + person.velocity.y * std::cos(angle)
+			);
+			person.location += person.velocity;
+		}
+
+		// bounce off the edges of the camera frame
+		if (person.location.x < radius) {
+			person.location.x = radius;
+			person.velocity.x = std::abs(person.velocity.x);
+		} else if (person.location.x > this->resolution.width - radius) {
+			person.location.x = this->resolution.width - radius;
+			person.velocity.x = -std::abs(person.velocity.x);
+		}
+		if (person.location.y < radius) {
+			person.location.y = radius;
+			person.velocity.y = std::abs(person.velocity.y);
+		} else if (person.location.y > this->resolution.height - radius) {
+			person.location.y = this->resolution.height - radius;
+			person.velocity.y = -std::abs(person.velocity.y);
+		}
+		this->locations[i] = Vector2(person.location.x, person.location.y);
+	}
+}
+
+void SyntheticFrameSource::render(cv::Mat& frame) {
+	this->frame_floor.copyTo(frame);
+
+	// people seen from above as shoulders with a lighter head
+	const float radius = this->getRadius();
+	for (const SyntheticPerson& person : this->people) {
+		cv::circle(frame, person.location, radius, cv::Scalar(person.gray, person.gray, person.gray + 20), CV_FILLED);
+		cv::circle(frame, person.location, radius * 0.45f, cv::Scalar::all(person.gray + 40), CV_FILLED);
+	}
+
+	// bands of light moving sideways, which fall on the floor and people alike
+	if (this->pattern) {
+		const float width_pattern = std::max(1.f, WIDTH_PATTERN_METERS * this->pixels_per_meter);
+		const float offset = this->frames * this->seconds_frame * SPEED_PATTERN_METERS * this->pixels_per_meter;
+		for (int x = 0; x < this->resolution.width; ++x) {
+			const float light = AMPLITUDE_PATTERN * (0.5f + 0.5f * std::sin(2 * CV_PI * (x + offset) / width_pattern));
+			this->row_pattern.at<cv::Vec3b>(0, x) = cv::Vec3b::all(static_cast<unsigned char>(light));
+		}
+		cv::repeat(this->row_pattern, this->resolution.height, 1, this->frame_pattern);
+		cv::add(frame, this->frame_pattern, frame);
+	}
+
+	cv::add(frame, this->frames_noise[this->frames % AMOUNT_FRAMES_NOISE], frame);
+	cv::subtract(frame, cv::Scalar::all(AMPLITUDE_NOISE), frame);
+}
+
+cv::Point2f SyntheticFrameSource::createVelocity() {
+	const float angle = this->rng.uniform(0.f, static_cast<float>(2 * CV_PI));
+	const float speed = this->rng.uniform(SPEED_MINIMUM_METERS, SPEED_MAXIMUM_METERS) * this->pixels_per_meter * this->seconds_frame;
+	return cv::Point2f(speed * std::cos(angle), speed * std::sin(angle));
+}
+
+unsigned int SyntheticFrameSource::createFrames(float seconds_minimum, float seconds_maximum) {
+	return static_cast<unsigned int>(this->rng.uniform(seconds_minimum, seconds_maximum) / this->seconds_frame);
+}
@@ -0,0 +1,90 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_SYNTHETICFRAMESOURCE_H
+#define IMOVE_PEOPLEEXTRACTOR_SYNTHETICFRAMESOURCE_H
+
+#include <chrono>
+#include <vector>
+
+#include "FrameSource.hpp"
+#include "../../../util/src/Vector2.h"
+
+// Generated camera frames of a crowd walking, stopping and grouping on a textured floor, with the true locations of the people
+class SyntheticFrameSource : public FrameSource {
+	public:
+		/**
+		 * Setup the synthetic crowd.
+		 *
+		 * @param resolution       The resolution of the generated camera frames
+		 * @param pixels_per_meter The amount of pixels in the camera frames which equal one meter on the floor
+		 * @param amount_people    The amount of people in the crowd
+		 * @param fps              The camera frames per second, which sets how far people move per camera frame
+		 * @param realtime         Whether to wait between camera frames to keep the camera frames per second
+		 * @param floor_contrast   The contrast in gray levels of the texture of the floor, 0 for a plain floor
+		 * @param pattern          Whether to project a moving pattern of light over the floor and the crowd
+		 * @param seed             The seed of the random generator, the same seed generates the same camera frames
+		 **/
+		SyntheticFrameSource(const cv::Size& resolution, float pixels_per_meter, unsigned int amount_people, unsigned int fps, bool realtime, unsigned int floor_contrast, bool pattern, unsigned int seed);
+
+		bool read(cv::Mat& frame);
+
+		// Gets the true locations in pixels of the people in the last read camera frame
+		const std::vector<Vector2>& getLocations() const;
+
+		// Gets the radius in pixels of a person seen from above
+		float getRadius() const;
+
+		// Gets the time in nanoseconds people moved from the first read camera frame to the last, also when not waiting between camera frames
+		long long getTimestamp() const;
+
+	private:
+		// Person of the synthetic crowd
+		struct SyntheticPerson {
+			cv::Point2f location;
+			// direction and speed in pixels per camera frame
+			cv::Point2f velocity;
+			// camera frames left to stand still
+			unsigned int frames_stopped;
+			// index of the person to walk to and stand next to, -1 when walking alone
+			int index_group;
+			// camera frames left to stay with the group
+			unsigned int frames_grouped;
+			// gray level of the clothing
+			unsigned char gray;
+		};
+
+		// Move every person one camera frame
+		void step();
+
+		// Draw the floor, the people and the pattern in the camera frame
+		void render(cv::Mat& frame);
+
+		// Gets a random velocity of walking speed in pixels per camera frame
+		cv::Point2f createVelocity();
+
+		// Gets the amount of camera frames for a random duration in seconds
+		unsigned int createFrames(float seconds_minimum, float seconds_maximum);
+
+		const cv::Size resolution;
+		const float pixels_per_meter;
+		// seconds a camera frame takes when moving people, also when not waiting between camera frames
+		const float seconds_frame;
+		const bool realtime;
+		const bool pattern;
+
+		cv::RNG rng;
+		std::vector<SyntheticPerson> people;
+		std::vector<Vector2> locations;
+
+		// floor texture which is the same in every camera frame
+		cv::Mat frame_floor;
+		// sensor noise which is cycled through, precomputed so generating stays cheap next to extracting
+		std::vector<cv::Mat> frames_noise;
+		// one row of the projected pattern of light which is repeated over all rows
+		cv::Mat row_pattern;
+		cv::Mat frame_pattern;
+
+		// amount of camera frames read
+		unsigned long long frames;
+		std::chrono::steady_clock::time_point time_start;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_SYNTHETICFRAMESOURCE_H
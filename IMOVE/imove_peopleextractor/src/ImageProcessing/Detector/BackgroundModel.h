@@ -0,0 +1,19 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_BACKGROUNDMODEL_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_BACKGROUNDMODEL_H_
+
+#include <opencv2/opencv.hpp>
+
+// Backend of PeopleDetector which models the background of frames to find the foreground
+class BackgroundModel {
+ public:
+  // Value in the foreground mask of pixels which are shadows, like the opencv background subtractors
+  static const unsigned char SHADOW = 127;
+
+  virtual ~BackgroundModel() {}
+
+  // Update the model with a frame, unless it should not learn from it, and get its foreground mask: 255 for foreground, SHADOW for shadows and 0 for background
+  // Frames change size when people are detected at another scale of the camera resolution; the model keeps what it learned of the background then instead of starting over
+  virtual void apply(const cv::Mat& frame, cv::Mat& foreground, bool learn) = 0;
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_BACKGROUNDMODEL_H_
@@ -0,0 +1,28 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_BLOBDETECTOR_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_BLOBDETECTOR_H_
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "../../../../util/src/Vector2.h"
+
+// Blob of foreground pixels which is a person
+struct Blob {
+  // Center of the blob in pixels
+  Vector2 location;
+  // Area of the blob in pixels
+  float area;
+  // Bounding box of the blob
+  cv::Rect bounding_box;
+};
+
+// Backend of PeopleDetector which finds blobs in the foreground mask
+class BlobDetector {
+ public:
+  virtual ~BlobDetector() {}
+
+  // Detect blobs in a binary foreground mask, replacing the given blobs
+  virtual void detect(const cv::Mat& foreground, std::vector<Blob>& blobs) = 0;
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_BLOBDETECTOR_H_
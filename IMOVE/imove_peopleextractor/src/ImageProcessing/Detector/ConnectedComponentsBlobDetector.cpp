@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ConnectedComponentsBlobDetector.h"
+
+namespace {
+
+// Cleanup and labelling of tiles of the foreground, which opencv spreads over its threads
+class LabelTiles : public cv::ParallelLoopBody {
+ private:
+  const cv::Mat& foreground;
+  const cv::Mat& kernel;
+  const int rows_around;
+  std::vector<ForegroundTile>& tiles;
+
+ public:
+  LabelTiles(const cv::Mat& foreground, const cv::Mat& kernel, int rows_around, std::vector<ForegroundTile>& tiles) :
+      foreground(foreground),
+      kernel(kernel),
+      rows_around(rows_around),
+      tiles(tiles) {}
+
+  void operator()(const cv::Range& range) const {
+    for (int t = range.start; t < range.end; ++t) {
+      ForegroundTile& tile = tiles[t];
+      cv::Mat mask = foreground.rowRange(tile.row_start, tile.row_end);
+      if (!kernel.empty()) {
+        // Also clean up the rows around the tile, so the rows of the tile come out the same as when cleaning up the whole foreground
+        const int row_start_around = std::max(0, tile.row_start - rows_around);
+        const int row_end_around = std::min(foreground.rows, tile.row_end + rows_around);
+        cv::morphologyEx(foreground.rowRange(row_start_around, row_end_around), tile.cleaned, cv::MORPH_OPEN, kernel);
+        cv::morphologyEx(tile.cleaned, tile.cleaned, cv::MORPH_CLOSE, kernel);
+        mask = tile.cleaned.rowRange(tile.row_start - row_start_around, tile.row_end - row_start_around);
+      }
+      cv::connectedComponentsWithStats(mask, tile.labels, tile.stats, tile.centroids, 8, CV_32S);
+    }
+  }
+};
+
+// Order of blobs from large to small, with ties in an order of all other fields so the order does not depend on the order components are labelled in
+bool isLargerBlob(const Blob& a, const Blob& b) {
+  if (a.area != b.area) {
+    return a.area > b.area;
+  }
+  if (a.bounding_box.y != b.bounding_box.y) {
+    return a.bounding_box.y < b.bounding_box.y;
+  }
+  if (a.bounding_box.x != b.bounding_box.x) {
+    return a.bounding_box.x < b.bounding_box.x;
+  }
+  if (a.bounding_box.height != b.bounding_box.height) {
+    return a.bounding_box.height < b.bounding_box.height;
+  }
+  if (a.bounding_box.width != b.bounding_box.width) {
+    return a.bounding_box.width < b.bounding_box.width;
+  }
+  if (a.location.y != b.location.y) {
+    return a.location.y < b.location.y;
+  }
+  return a.location.x < b.location.x;
+}
+
+}  // namespace
+
+ConnectedComponentsBlobDetector::ConnectedComponentsBlobDetector(float minBlobArea, float minBlobDist, unsigned int size_morphology) :
+    minBlobArea(minBlobArea),
+    minBlobDist(minBlobDist) {
+  if (size_morphology > 0) {
+    kernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(size_morphology, size_morphology));
+  }
+}
+
+void ConnectedComponentsBlobDetector::detect(const cv::Mat& foreground, std::vector<Blob>& blobs) {
+  detect(foreground, blobs, cv::getNumThreads());
+}
+
+void ConnectedComponentsBlobDetector::detect(const cv::Mat& foreground, std::vector<Blob>& blobs, int amount_tiles_maximum) {
+  blobs.clear();
+
+  components.clear();
+  const int amount_tiles = getAmountTiles(foreground.rows, amount_tiles_maximum);
+  if (amount_tiles > 1) {
+    labelTiles(foreground, amount_tiles);
+  } else {
+    labelWhole(foreground);
+  }
+
+  // Like SimpleBlobDetector, blobs closer than the minimum distance are one; the largest is kept
+  std::sort(components.begin(), components.end(), isLargerBlob);
+  for (Blob& component : components) {
+    bool separate = true;
+    for (Blob& blob : blobs) {
+      if (component.location.distance(blob.location) < minBlobDist) {
+        separate = false;
+        break;
+      }
+    }
+    if (separate) {
+      blobs.push_back(component);
+    }
+  }
+}
+
+int ConnectedComponentsBlobDetector::getAmountTiles(int rows, int amount_tiles_maximum) const {
+  // Opening and closing move every edge of the foreground by up to half the kernel four times
+  const int rows_around = kernel.empty() ? 0 : 4 * (kernel.rows / 2);
+  return std::max(1, std::min(amount_tiles_maximum, rows / std::max(ROWS_TILE_MINIMUM, rows_around)));
+}
+
+void ConnectedComponentsBlobDetector::labelWhole(const cv::Mat& foreground) {
+  // Remove specks and fill small holes so one person is one component
+  const cv::Mat* mask = &foreground;
+  if (!kernel.empty()) {
+    cv::morphologyEx(foreground, cleaned, cv::MORPH_OPEN, kernel);
+    cv::morphologyEx(cleaned, cleaned, cv::MORPH_CLOSE, kernel);
+    mask = &cleaned;
+  }
+
+  // Label all components at once, label 0 is the background
+  const int amount_labels = cv::connectedComponentsWithStats(*mask, labels, stats, centroids, 8, CV_32S);
+  for (int label = 1; label < amount_labels; ++label) {
+    const int area = stats.at<int>(label, cv::CC_STAT_AREA);
+    if (area < minBlobArea || area > MAXIMUM_AREA) {
+      continue;
+    }
+    Blob blob;
+    blob.location = Vector2(centroids.at<double>(label, 0), centroids.at<double>(label, 1));
+    blob.area = area;
+    blob.bounding_box = cv::Rect(
+      stats.at<int>(label, cv::CC_STAT_LEFT),
+      stats.at<int>(label, cv::CC_STAT_TOP),
+      stats.at<int>(label, cv::CC_STAT_WIDTH),
+      stats.at<int>(label, cv::CC_STAT_HEIGHT)
+    );
+    components.push_back(blob);
+  }
+}
+
+void ConnectedComponentsBlobDetector::labelTiles(const cv::Mat& foreground, int amount_tiles) {
+  tiles.resize(amount_tiles);
+  for (int t = 0; t < amount_tiles; ++t) {
+    tiles[t].row_start = foreground.rows * t / amount_tiles;
+    tiles[t].row_end = foreground.rows * (t + 1) / amount_tiles;
+  }
+  const int rows_around = kernel.empty() ? 0 : 4 * (kernel.rows / 2);
+  cv::parallel_for_(cv::Range(0, amount_tiles), LabelTiles(foreground, kernel, rows_around, tiles), amount_tiles);
+
+  // Parts of all tiles after each other, with the sums of their coordinates taken back from their centroids, which are exact as the sums are whole numbers
+  std::vector<int> offsets(amount_tiles);
+  parts.clear();
+  for (int t = 0; t < amount_tiles; ++t) {
+    const ForegroundTile& tile = tiles[t];
+    offsets[t] = parts.size();
+    for (int label = 1; label < tile.stats.rows; ++label) {
+      Part part;
+      part.area = tile.stats.at<int>(label, cv::CC_STAT_AREA);
+      part.sum_x = std::llround(tile.centroids.at<double>(label, 0) * part.area);
+      part.sum_y = std::llround(tile.centroids.at<double>(label, 1) * part.area) + part.area * tile.row_start;
+      part.left = tile.stats.at<int>(label, cv::CC_STAT_LEFT);
+      part.top = tile.stats.at<int>(label, cv::CC_STAT_TOP) + tile.row_start;
+      part.right = part.left + tile.stats.at<int>(label, cv::CC_STAT_WIDTH) - 1;
+      part.bottom = part.top + tile.stats.at<int>(label, cv::CC_STAT_HEIGHT) - 1;
+      parts.push_back(part);
+    }
+  }
+
+  // Stitch parts which touch across the seam between two tiles, including diagonally
+  parents.resize(parts.size());
+  for (unsigned int i = 0; i < parents.size(); ++i) {
+    parents[i] = i;
+  }
+  for (int t = 0; t + 1 < amount_tiles; ++t) {
+    const int* row_above = tiles[t].labels.ptr<int>(tiles[t].labels.rows - 1);
+    const int* row_below = tiles[t + 1].labels.ptr<int>(0);
+    for (int x = 0; x < foreground.cols; ++x) {
+      if (row_above[x] == 0) {
+        continue;
+      }
+      for (int x_below = std::max(0, x - 1); x_below <= std::min(foreground.cols - 1, x + 1); ++x_below) {
+        if (row_below[x_below] == 0) {
+          continue;
+        }
+        const int root_above = findRoot(offsets[t] + row_above[x] - 1);
+        const int root_below = findRoot(offsets[t + 1] + row_below[x_below] - 1);
+        if (root_above != root_below) {
+          parents[std::max(root_above, root_below)] = std::min(root_above, root_below);
+        }
+      }
+    }
+  }
+
+  // Add every stitched part to the part it is merged into, which comes before it
+  for (unsigned int i = 0; i < parts.size(); ++i) {
+    const int root = findRoot(i);
+    if (root == static_cast<int>(i)) {
+      continue;
+    }
+    Part& merged = parts[root];
+    merged.area += parts[i].area;
+    merged.sum_x += parts[i].sum_x;
+    merged.sum_y += parts[i].sum_y;
+    merged.left = std::min(merged.left, parts[i].left);
+    merged.top = std::min(merged.top, parts[i].top);
+    merged.right = std::max(merged.right, parts[i].right);
+    merged.bottom = std::max(merged.bottom, parts[i].bottom);
+  }
+
+  // Components like labelling the whole foreground finds them, with the centroid computed the same way
+  for (unsigned int i = 0; i < parts.size(); ++i) {
+    const Part& part = parts[i];
+    if (parents[i] != static_cast<int>(i) || part.area < minBlobArea || part.area > MAXIMUM_AREA) {
+      continue;
+    }
+    Blob blob;
+    blob.location = Vector2(static_cast<double>(part.sum_x) / part.area, static_cast<double>(part.sum_y) / part.area);
+    blob.area = part.area;
+    blob.bounding_box = cv::Rect(part.left, part.top, part.right - part.left + 1, part.bottom - part.top + 1);
+    components.push_back(blob);
+  }
+}
+
+int ConnectedComponentsBlobDetector::findRoot(int part) {
+  while (parents[part] != part) {
+    // Halve the path on the way, so later searches are shorter
+    parents[part] = parents[parents[part]];
+    part = parents[part];
+  }
+  return part;
+}
@@ -0,0 +1,81 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_CONNECTEDCOMPONENTSBLOBDETECTOR_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_CONNECTEDCOMPONENTSBLOBDETECTOR_H_
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "BlobDetector.h"
+
+// Rows of the foreground which are cleaned up and labelled on one core, with the buffers of the last detection
+struct ForegroundTile {
+  // Rows of the foreground labelled in this tile; cleaning up also reads the rows around them
+  int row_start;
+  int row_end;
+
+  cv::Mat cleaned;
+  cv::Mat labels;
+  cv::Mat stats;
+  cv::Mat centroids;
+};
+
+// Blob detection by labelling connected components of the foreground in a single pass, in tiles of rows on every core which are stitched together
+class ConnectedComponentsBlobDetector : public BlobDetector {
+ private:
+  // Maximum area of a blob, like SimpleBlobDetector is set up
+  static constexpr float MAXIMUM_AREA = 1000000;
+  // Minimum rows of a tile, fewer rows spend more time on the rows around them than they save
+  static const int ROWS_TILE_MINIMUM = 32;
+
+  // Component labelled in a tile, to which the parts of the same component in the other tiles are added
+  struct Part {
+    long long area;
+    // sums of the coordinates of the pixels, which the centroid is the average of
+    long long sum_x;
+    long long sum_y;
+    int left;
+    int top;
+    int right;
+    int bottom;
+  };
+
+  float minBlobArea;
+  float minBlobDist;
+
+  // Structuring element of the morphological cleanup, empty for no cleanup
+  cv::Mat kernel;
+
+  // Buffers of the last detection, kept to reuse their memory
+  cv::Mat cleaned;
+  cv::Mat labels;
+  cv::Mat stats;
+  cv::Mat centroids;
+  std::vector<Blob> components;
+  std::vector<ForegroundTile> tiles;
+  std::vector<Part> parts;
+  // Part every part is merged into, itself when it is not merged
+  std::vector<int> parents;
+
+  // Clean up and label the foreground as a whole into the components
+  void labelWhole(const cv::Mat& foreground);
+
+  // Clean up and label the foreground in tiles on every core into the components, the same as labelling it as a whole
+  void labelTiles(const cv::Mat& foreground, int amount_tiles);
+
+  // Gets the part a part is merged into in the end
+  int findRoot(int part);
+
+ public:
+  // Constructor with minimum area of blobs, minimum distance between blobs and size of the morphological cleanup in pixels, 0 for none
+  ConnectedComponentsBlobDetector(float minBlobArea, float minBlobDist, unsigned int size_morphology);
+
+  // Detect blobs in tiles on every core of opencv
+  void detect(const cv::Mat& foreground, std::vector<Blob>& blobs);
+
+  // Detect blobs in at most the given amount of tiles, the blobs are the same for every amount
+  void detect(const cv::Mat& foreground, std::vector<Blob>& blobs, int amount_tiles_maximum);
+
+  // Gets the amount of tiles to split a foreground of an amount of rows in, at most the given amount and 1 to not split it
+  int getAmountTiles(int rows, int amount_tiles_maximum) const;
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_CONNECTEDCOMPONENTSBLOBDETECTOR_H_
@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "GaussianBackgroundModel.h"
+
+// Vector instructions are compiled per function, so the build needs no flags and the processor is asked at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define IMOVE_BACKGROUND_X86
+#include <immintrin.h>
+#define IMOVE_TARGET_SSE2 __attribute__((target("sse2")))
+#define IMOVE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+// Squared distance in variances above which a pixel is foreground, like the opencv MOG2 background subtractor
+const float THRESHOLD = 16;
+// Minimum brightness of a shadow relative to the background, like the opencv MOG2 background subtractor
+const float SHADOW_RATIO = 0.5;
+// Variance per channel of a new model and its bounds
+const float VARIANCE_INITIAL = 15 * 15;
+const float VARIANCE_MINIMUM = 4 * 4;
+const float VARIANCE_MAXIMUM = 75 * 75;
+// Smallest squared brightness of the background to compare shadows with
+const float EPSILON = 1e-3;
+// Labels of the foreground mask
+const unsigned char LABEL_FOREGROUND = 255;
+
+// Pointers to one row of the frame, the model and the foreground mask
+struct Row {
+  const unsigned char* pixels[3];
+  float* means[3];
+  float* variances;
+  unsigned char* foreground;
+};
+
+typedef GaussianBackgroundModel::Parameters Parameters;
+
+// Update pixels begin to end of a row one by one, the reference for the vector instructions which compute the same in the same order
+template <int CHANNELS>
+void updateScalar(const Row& row, int begin, int end, const Parameters& parameters) {
+  for (int x = begin; x < end; ++x) {
+    float values[CHANNELS];
+    float differences[CHANNELS];
+    float distance = 0;
+    float dot = 0;
+    float norm = 0;
+    for (int c = 0; c < CHANNELS; ++c) {
+      values[c] = row.pixels[c][x];
+      const float mean = row.means[c][x];
+      differences[c] = values[c] - mean;
+      distance = distance + differences[c] * differences[c];
+      dot = dot + values[c] * mean;
+      norm = norm + mean * mean;
+    }
+    const float variance = row.variances[x];
+    const float bound = parameters.threshold * variance;
+
+    unsigned char label = 0;
+    if (distance > bound) {
+      label = LABEL_FOREGROUND;
+      // A shadow is the background scaled darker, so it is close to the scaled mean
+      if (parameters.shadows) {
+        const float ratio = dot / std::max(norm, EPSILON);
+        float distance_shadow = 0;
+        for (int c = 0; c < CHANNELS; ++c) {
+          const float difference = values[c] - ratio * row.means[c][x];
+          distance_shadow = distance_shadow + difference * difference;
+        }
+        if (ratio >= parameters.shadow_ratio && ratio <= 1 && distance_shadow < bound * ratio * ratio) {
+          label = BackgroundModel::SHADOW;
+        }
+      }
+    }
+    row.foreground[x] = label;
+
+    for (int c = 0; c < CHANNELS; ++c) {
+      row.means[c][x] = row.means[c][x] + parameters.learning_rate * differences[c];
+    }
+    const float variance_updated = variance + parameters.learning_rate * (distance - variance);
+    row.variances[x] = std::max(std::min(variance_updated, parameters.variance_maximum), parameters.variance_minimum);
+  }
+}
+
+#ifdef IMOVE_BACKGROUND_X86
+// Update 4 pixels at a time, returns the amount of pixels updated
+template <int CHANNELS>
+IMOVE_TARGET_SSE2 int updateSse2(const Row& row, int width, const Parameters& parameters) {
+  const __m128 learning_rate = _mm_set1_ps(parameters.learning_rate);
+  const __m128 threshold = _mm_set1_ps(parameters.threshold);
+  const __m128 shadow_ratio = _mm_set1_ps(parameters.shadow_ratio);
+  const __m128 variance_minimum = _mm_set1_ps(parameters.variance_minimum);
+  const __m128 variance_maximum = _mm_set1_ps(parameters.variance_maximum);
+  const __m128 one = _mm_set1_ps(1);
+  const __m128 epsilon = _mm_set1_ps(EPSILON);
+  const __m128i label_foreground = _mm_set1_epi32(LABEL_FOREGROUND);
+  const __m128i label_shadow = _mm_set1_epi32(BackgroundModel::SHADOW);
+  const __m128i zero = _mm_setzero_si128();
+
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    __m128 values[CHANNELS];
+    __m128 means[CHANNELS];
+    __m128 differences[CHANNELS];
+    __m128 distance = _mm_setzero_ps();
+    __m128 dot = _mm_setzero_ps();
+    __m128 norm = _mm_setzero_ps();
+    for (int c = 0; c < CHANNELS; ++c) {
+      int bytes;
+      std::memcpy(&bytes, row.pixels[c] + x, sizeof(bytes));
+      values[c] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero));
+      means[c] = _mm_loadu_ps(row.means[c] + x);
+      differences[c] = _mm_sub_ps(values[c], means[c]);
+      distance = _mm_add_ps(distance, _mm_mul_ps(differences[c], differences[c]));
+      dot = _mm_add_ps(dot, _mm_mul_ps(values[c], means[c]));
+      norm = _mm_add_ps(norm, _mm_mul_ps(means[c], means[c]));
+    }
+    const __m128 variance = _mm_loadu_ps(row.variances + x);
+    const __m128 bound = _mm_mul_ps(threshold, variance);
+
+    const __m128 foreground = _mm_cmpgt_ps(distance, bound);
+    __m128 shadow = _mm_setzero_ps();
+    if (parameters.shadows) {
+      const __m128 ratio = _mm_div_ps(dot, _mm_max_ps(norm, epsilon));
+      __m128 distance_shadow = _mm_setzero_ps();
+      for (int c = 0; c < CHANNELS; ++c) {
+        const __m128 difference = _mm_sub_ps(values[c], _mm_mul_ps(ratio, means[c]));
+        distance_shadow = _mm_add_ps(distance_shadow, _mm_mul_ps(difference, difference));
+      }
+      shadow = _mm_and_ps(foreground, _mm_and_ps(
+        _mm_and_ps(_mm_cmpge_ps(ratio, shadow_ratio), _mm_cmple_ps(ratio, one)),
+        _mm_cmplt_ps(distance_shadow, _mm_mul_ps(_mm_mul_ps(bound, ratio), ratio))
+      ));
+    }
+    // Labels as 32 bit integers, packed to bytes
+    const __m128i labels = _mm_or_si128(
+      _mm_andnot_si128(_mm_castps_si128(shadow), _mm_and_si128(_mm_castps_si128(foreground), label_foreground)),
+      _mm_and_si128(_mm_castps_si128(shadow), label_shadow)
+    );
+    const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(labels, zero), zero));
+    std::memcpy(row.foreground + x, &packed, sizeof(packed));
+
+    for (int c = 0; c < CHANNELS; ++c) {
+      _mm_storeu_ps(row.means[c] + x, _mm_add_ps(means[c], _mm_mul_ps(learning_rate, differences[c])));
+    }
+    const __m128 variance_updated = _mm_add_ps(variance, _mm_mul_ps(learning_rate, _mm_sub_ps(distance, variance)));
+    _mm_storeu_ps(row.variances + x, _mm_max_ps(_mm_min_ps(variance_updated, variance_maximum), variance_minimum));
+  }
+  return x;
+}
+
+// Update 8 pixels at a time, returns the amount of pixels updated
+template <int CHANNELS>
+IMOVE_TARGET_AVX2 int updateAvx2(const Row& row, int width, const Parameters& parameters) {
+  const __m256 learning_rate = _mm256_set1_ps(parameters.learning_rate);
+  const __m256 threshold = _mm256_set1_ps(parameters.threshold);
+  const __m256 shadow_ratio = _mm256_set1_ps(parameters.shadow_ratio);
+  const __m256 variance_minimum = _mm256_set1_ps(parameters.variance_minimum);
+  const __m256 variance_maximum = _mm256_set1_ps(parameters.variance_maximum);
+  const __m256 one = _mm256_set1_ps(1);
+  const __m256 epsilon = _mm256_set1_ps(EPSILON);
+  const __m256i label_foreground = _mm256_set1_epi32(LABEL_FOREGROUND);
+  const __m256i label_shadow = _mm256_set1_epi32(BackgroundModel::SHADOW);
+
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    __m256 values[CHANNELS];
+    __m256 means[CHANNELS];
+    __m256 differences[CHANNELS];
+    __m256 distance = _mm256_setzero_ps();
+    __m256 dot = _mm256_setzero_ps();
+    __m256 norm = _mm256_setzero_ps();
+    for (int c = 0; c < CHANNELS; ++c) {
+      values[c] = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row.pixels[c] + x))));
+      means[c] = _mm256_loadu_ps(row.means[c] + x);
+      differences[c] = _mm256_sub_ps(values[c], means[c]);
+      distance = _mm256_add_ps(distance, _mm256_mul_ps(differences[c], differences[c]));
+      dot = _mm256_add_ps(dot, _mm256_mul_ps(values[c], means[c]));
+      norm = _mm256_add_ps(norm, _mm256_mul_ps(means[c], means[c]));
+    }
+    const __m256 variance = _mm256_loadu_ps(row.variances + x);
+    const __m256 bound = _mm256_mul_ps(threshold, variance);
+
+    const __m256 foreground = _mm256_cmp_ps(distance, bound, _CMP_GT_OQ);
+    __m256 shadow = _mm256_setzero_ps();
+    if (parameters.shadows) {
+      const __m256 ratio = _mm256_div_ps(dot, _mm256_max_ps(norm, epsilon));
+      __m256 distance_shadow = _mm256_setzero_ps();
+      for (int c = 0; c < CHANNELS; ++c) {
+        const __m256 difference = _mm256_sub_ps(values[c], _mm256_mul_ps(ratio, means[c]));
+        distance_shadow = _mm256_add_ps(distance_shadow, _mm256_mul_ps(difference, difference));
+      }
+      shadow = _mm256_and_ps(foreground, _mm256_and_ps(
+        _mm256_and_ps(_mm256_cmp_ps(ratio, shadow_ratio, _CMP_GE_OQ), _mm256_cmp_ps(ratio, one, _CMP_LE_OQ)),
+        _mm256_cmp_ps(distance_shadow, _mm256_mul_ps(_mm256_mul_ps(bound, ratio), ratio), _CMP_LT_OQ)
+      ));
+    }
+    // Labels as 32 bit integers, packed to bytes per half as packing stays within 128 bit lanes
+    const __m256i labels = _mm256_or_si256(
+      _mm256_andnot_si256(_mm256_castps_si256(shadow), _mm256_and_si256(_mm256_castps_si256(foreground), label_foreground)),
+      _mm256_and_si256(_mm256_castps_si256(shadow), label_shadow)
+    );
+    const __m128i labels_16 = _mm_packs_epi32(_mm256_castsi256_si128(labels), _mm256_extracti128_si256(labels, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(row.foreground + x), _mm_packus_epi16(labels_16, _mm_setzero_si128()));
+
+    for (int c = 0; c < CHANNELS; ++c) {
+      _mm256_storeu_ps(row.means[c] + x, _mm256_add_ps(means[c], _mm256_mul_ps(learning_rate, differences[c])));
+    }
+    const __m256 variance_updated = _mm256_add_ps(variance, _mm256_mul_ps(learning_rate, _mm256_sub_ps(distance, variance)));
+    _mm256_storeu_ps(row.variances + x, _mm256_max_ps(_mm256_min_ps(variance_updated, variance_maximum), variance_minimum));
+  }
+  return x;
+}
+#endif
+
+// Update of the model in tiles of rows, which opencv spreads over its threads
+template <int CHANNELS>
+class UpdateTiles : public cv::ParallelLoopBody {
+ private:
+  GaussianBackgroundModel::InstructionSet instruction_set;
+  const Parameters& parameters;
+  const std::vector<cv::Mat>& planes;
+  std::vector<cv::Mat>& means;
+  cv::Mat& variances;
+  cv::Mat& foreground;
+
+ public:
+  UpdateTiles(GaussianBackgroundModel::InstructionSet instruction_set, const Parameters& parameters, const std::vector<cv::Mat>& planes, std::vector<cv::Mat>& means, cv::Mat& variances, cv::Mat& foreground) :
+      instruction_set(instruction_set),
+      parameters(parameters),
+      planes(planes),
+      means(means),
+      variances(variances),
+      foreground(foreground) {}
+
+  void operator()(const cv::Range& rows) const {
+    const int width = foreground.cols;
+    for (int y = rows.start; y < rows.end; ++y) {
+      Row row;
+      for (int c = 0; c < CHANNELS; ++c) {
+        row.pixels[c] = planes[c].ptr<unsigned char>(y);
+        row.means[c] = means[c].ptr<float>(y);
+      }
+      row.variances = variances.ptr<float>(y);
+      row.foreground = foreground.ptr<unsigned char>(y);
+
+      int x = 0;
+#ifdef IMOVE_BACKGROUND_X86
+      if (instruction_set == GaussianBackgroundModel::INSTRUCTION_SET_AVX2) {
+        x = updateAvx2<CHANNELS>(row, width, parameters);
+      } else if (instruction_set == GaussianBackgroundModel::INSTRUCTION_SET_SSE2) {
+        x = updateSse2<CHANNELS>(row, width, parameters);
+      }
+#endif
+      // Pixels left over at the end of the row
+      updateScalar<CHANNELS>(row, x, width, parameters);
+    }
+  }
+};
+
+}  // namespace
+
+GaussianBackgroundModel::GaussianBackgroundModel(float learning_rate, bool shadows) :
+    learning_rate(learning_rate),
+    shadows(shadows),
+    instruction_set(getSupportedInstructionSet()),
+    frames(0) {}
+
+void GaussianBackgroundModel::apply(const cv::Mat& frame, cv::Mat& foreground, bool learn) {
+  CV_Assert(frame.depth() == CV_8U && (frame.channels() == 1 || frame.channels() == 3));
+  if (means.empty() || static_cast<int>(means.size()) != frame.channels()) {
+    initialize(frame);
+  } else if (variances.size() != frame.size()) {
+    resize(frame.size());
+  }
+
+  // Channels are updated plane by plane, so vector instructions load consecutive pixels of one channel
+  if (frame.channels() == 1) {
+    planes.assign(1, frame);
+  } else {
+    cv::split(frame, planes);
+  }
+  foreground.create(frame.size(), CV_8UC1);
+
+  // Learn faster while the model has seen few frames, so people are found soon after starting
+  // A frame which is not learned from still initializes the model, as there is nothing to compare it with otherwise
+  Parameters parameters;
+  if (learn || frames == 0) {
+    ++frames;
+    parameters.learning_rate = std::max(learning_rate, 1.f / frames);
+  } else {
+    parameters.learning_rate = 0;
+  }
+  parameters.threshold = THRESHOLD;
+  // A gray shadow can not be told apart from a darker person, so shadows are only recognized in color
+  parameters.shadows = shadows && frame.channels() == 3;
+  parameters.shadow_ratio = SHADOW_RATIO;
+  parameters.variance_minimum = VARIANCE_MINIMUM * frame.channels();
+  parameters.variance_maximum = VARIANCE_MAXIMUM * frame.channels();
+
+  const cv::Range rows(0, frame.rows);
+  const double tiles = (frame.rows + ROWS_TILE - 1) / ROWS_TILE;
+  if (frame.channels() == 1) {
+    cv::parallel_for_(rows, UpdateTiles<1>(instruction_set, parameters, planes, means, variances, foreground), tiles);
+  } else {
+    cv::parallel_for_(rows, UpdateTiles<3>(instruction_set, parameters, planes, means, variances, foreground), tiles);
+  }
+}
+
+GaussianBackgroundModel::InstructionSet GaussianBackgroundModel::getSupportedInstructionSet() {
+#ifdef IMOVE_BACKGROUND_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return INSTRUCTION_SET_AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return INSTRUCTION_SET_SSE2;
+  }
+#endif
+  return INSTRUCTION_SET_SCALAR;
+}
+
+GaussianBackgroundModel::InstructionSet GaussianBackgroundModel::getInstructionSet() const {
+  return instruction_set;
+}
+
+void GaussianBackgroundModel::setInstructionSet(InstructionSet instruction_set) {
+  this->instruction_set = std::min(instruction_set, getSupportedInstructionSet());
+}
+
+const char* GaussianBackgroundModel::getName(InstructionSet instruction_set) {
+  switch (instruction_set) {
+    case INSTRUCTION_SET_AVX2:
+      return "avx2";
+    case INSTRUCTION_SET_SSE2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+void GaussianBackgroundModel::initialize(const cv::Mat& frame) {
+  // The first frame is the mean, with a wide variance till the model has learned the noise
+  std::vector<cv::Mat> channels;
+  cv::split(frame, channels);
+  means.resize(channels.size());
+  for (unsigned int c = 0; c < channels.size(); ++c) {
+    channels[c].convertTo(means[c], CV_32F);
+  }
+  variances = cv::Mat(frame.size(), CV_32FC1, cv::Scalar::all(VARIANCE_INITIAL * frame.channels()));
+  frames = 0;
+}
+
+void GaussianBackgroundModel::resize(const cv::Size& size) {
+  // Averaging the pixels when shrinking keeps the noise of the background learned, interpolating when growing does not invent any
+  const int interpolation = size.area() < variances.size().area() ? cv::INTER_AREA : cv::INTER_LINEAR;
+  for (cv::Mat& mean : means) {
+    cv::Mat mean_resized;
+    cv::resize(mean, mean_resized, size, 0, 0, interpolation);
+    mean = mean_resized;
+  }
+  cv::Mat variances_resized;
+  cv::resize(variances, variances_resized, size, 0, 0, interpolation);
+  variances = variances_resized;
+}
@@ -0,0 +1,75 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_GAUSSIANBACKGROUNDMODEL_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_GAUSSIANBACKGROUNDMODEL_H_
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "BackgroundModel.h"
+
+// Background model of one running gaussian per pixel, updated with vector instructions in tiles of rows on all cores
+class GaussianBackgroundModel : public BackgroundModel {
+ public:
+  // Instruction sets the model can be updated with, from slowest to fastest
+  enum InstructionSet {
+    INSTRUCTION_SET_SCALAR = 0,
+    INSTRUCTION_SET_SSE2 = 1,
+    INSTRUCTION_SET_AVX2 = 2
+  };
+
+  // Parameters of the update of a pixel, shared by all instruction sets
+  struct Parameters {
+    // Part of the model updated by the frame
+    float learning_rate;
+    // Squared distance in variances from the mean above which a pixel is foreground
+    float threshold;
+    // Whether foreground which is only darker than the background is marked as shadow
+    bool shadows;
+    // Minimum brightness of a shadow relative to the background
+    float shadow_ratio;
+    // Bounds of the variance, so the model neither freezes nor takes everything as background
+    float variance_minimum;
+    float variance_maximum;
+  };
+
+  // Constructor with the part of the model updated per frame and whether shadows are recognized
+  GaussianBackgroundModel(float learning_rate, bool shadows);
+
+  void apply(const cv::Mat& frame, cv::Mat& foreground, bool learn);
+
+  // Get the fastest instruction set the processor supports
+  static InstructionSet getSupportedInstructionSet();
+
+  // Get the instruction set the model is updated with
+  InstructionSet getInstructionSet() const;
+
+  // Update the model with a slower instruction set, bounded by the supported instruction set
+  void setInstructionSet(InstructionSet instruction_set);
+
+  // Get the name of an instruction set
+  static const char* getName(InstructionSet instruction_set);
+
+ private:
+  // Rows of frames per tile which is updated by one core
+  static const int ROWS_TILE = 16;
+
+  float learning_rate;
+  bool shadows;
+  InstructionSet instruction_set;
+
+  // Amount of frames the model is updated with, to learn faster while it has seen few frames
+  unsigned long long frames;
+
+  // Channels of the last frame, split so every channel is contiguous
+  std::vector<cv::Mat> planes;
+  // Mean per channel and variance per pixel, a plane of floats each
+  std::vector<cv::Mat> means;
+  cv::Mat variances;
+
+  // (Re)start the model from a frame
+  void initialize(const cv::Mat& frame);
+
+  // Scale the learned means and variances to frames of another size, keeping the amount of frames learned from
+  void resize(const cv::Size& size);
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_GAUSSIANBACKGROUNDMODEL_H_
@@ -0,0 +1,19 @@
+#include <algorithm>
+#include <cmath>
+
+#include "KnnBackgroundModel.h"
+
+KnnBackgroundModel::KnnBackgroundModel(float learning_rate, bool shadows) :
+    // The subtractor learns at one over its history, and faster while its history is not filled yet
+    history(std::max(1, static_cast<int>(std::lround(1 / std::max(learning_rate, 1e-6f))))),
+    shadows(shadows) {}
+
+void KnnBackgroundModel::apply(const cv::Mat& frame, cv::Mat& foreground, bool learn) {
+  cv::Ptr<cv::BackgroundSubtractorKNN>& background_subtractor = background_subtractors[std::make_pair(frame.cols, frame.rows)];
+  if (!background_subtractor) {
+    background_subtractor = cv::createBackgroundSubtractorKNN(history);
+    background_subtractor->setDetectShadows(shadows);
+  }
+  // A learning rate of 0 leaves the samples as they are, which skips most of the work of the subtractor
+  background_subtractor->apply(frame, foreground, learn ? -1 : 0);
+}
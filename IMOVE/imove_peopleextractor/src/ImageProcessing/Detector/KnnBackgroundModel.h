@@ -0,0 +1,27 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_KNNBACKGROUNDMODEL_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_KNNBACKGROUNDMODEL_H_
+
+#include <opencv2/opencv.hpp>
+#include <opencv2/video.hpp>
+#include <map>
+#include <utility>
+
+#include "BackgroundModel.h"
+
+// Background model of the opencv KNN background subtractor, which keeps a history of samples per pixel
+class KnnBackgroundModel : public BackgroundModel {
+ private:
+  // Samples can not be scaled, so there is a subtractor per frame size, by width and height, which learns on when frames are of its size again
+  std::map<std::pair<int, int>, cv::Ptr<cv::BackgroundSubtractorKNN> > background_subtractors;
+
+  int history;
+  bool shadows;
+
+ public:
+  // Constructor with the part of the model updated per frame and whether shadows are recognized
+  KnnBackgroundModel(float learning_rate, bool shadows);
+
+  void apply(const cv::Mat& frame, cv::Mat& foreground, bool learn);
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_KNNBACKGROUNDMODEL_H_
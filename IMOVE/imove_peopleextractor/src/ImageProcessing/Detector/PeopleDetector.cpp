@@ -1,69 +1,152 @@
+#include <cmath>
 #include <vector>
 
 #include "PeopleDetector.h"
+#include "SimpleBlobDetectorBackend.h"
+#include "ConnectedComponentsBlobDetector.h"
+#include "KnnBackgroundModel.h"
+#include "GaussianBackgroundModel.h"
 #include "../../../../util/src/Vector2.h"
 
-PeopleDetector::PeopleDetector() {}
+namespace {
+
+// Level above which the background model labels a pixel foreground, below are shadows and background
+const unsigned char LEVEL_FOREGROUND = 200;
+// Rows thresholded by one core at a time
+const int ROWS_TILE = 32;
+
+// Thresholding of the foreground and masking it by the region of interest in one pass, in tiles of rows which opencv spreads over its threads
+class ThresholdTiles : public cv::ParallelLoopBody {
+ private:
+  const cv::Mat& foreground;
+  const cv::Mat& mask;
+  cv::Mat& thresholded;
+
+ public:
+  ThresholdTiles(const cv::Mat& foreground, const cv::Mat& mask, cv::Mat& thresholded) :
+      foreground(foreground),
+      mask(mask),
+      thresholded(thresholded) {}
+
+  void operator()(const cv::Range& rows) const {
+    for (int y = rows.start; y < rows.end; ++y) {
+      const unsigned char* row_foreground = foreground.ptr<unsigned char>(y);
+      unsigned char* row_thresholded = thresholded.ptr<unsigned char>(y);
+      if (mask.empty()) {
+        for (int x = 0; x < foreground.cols; ++x) {
+          row_thresholded[x] = row_foreground[x] > LEVEL_FOREGROUND ? 255 : 0;
+        }
+      } else {
+        const unsigned char* row_mask = mask.ptr<unsigned char>(y);
+        for (int x = 0; x < foreground.cols; ++x) {
+          row_thresholded[x] = (row_foreground[x] > LEVEL_FOREGROUND ? 255 : 0) & row_mask[x];
+        }
+      }
+    }
+  }
+};
 
-PeopleDetector::PeopleDetector(float pixels_per_meter, float minBlobArea, float minBlobDist) : pixels_per_meter(pixels_per_meter) {
-  // Initialize background subtractor
-  background_subtractor = cv::createBackgroundSubtractorKNN();
+}  // namespace
 
-  // Set parameters for SimpleBlobDetector
-  params.filterByCircularity = false;
-  params.filterByColor = false;
-  params.filterByConvexity = false;
-  params.filterByInertia = false;
-  params.filterByArea = true;
-  params.maxArea = 1000000;
+PeopleDetector::PeopleDetector() {}
 
-  // Set parameters for SimpleBlobDetector according to the camera height
-  params.minArea = minBlobArea;
-  params.minDistBetweenBlobs = minBlobDist;
+PeopleDetector::PeopleDetector(float pixels_per_meter, float minBlobArea, float minBlobDist, CameraConfiguration::BlobDetector blob_detector_type, unsigned int size_morphology, CameraConfiguration::BackgroundModel background_model_type, float learning_rate, bool shadows) : blob_detector_type(blob_detector_type) {
+  // Create background model backend according to the camera configuration
+  if (background_model_type == CameraConfiguration::BACKGROUND_MODEL_GAUSSIAN) {
+    background_model = cv::Ptr<BackgroundModel>(new GaussianBackgroundModel(learning_rate, shadows));
+  } else {
+    background_model = cv::Ptr<BackgroundModel>(new KnnBackgroundModel(learning_rate, shadows));
+  }
+
+  setScale(pixels_per_meter, minBlobArea, minBlobDist, size_morphology);
+}
 
-  // Create SimpleBlobDetector
-  blob_detector = cv::SimpleBlobDetector::create(params);
+void PeopleDetector::setScale(float pixels_per_meter, float minBlobArea, float minBlobDist, unsigned int size_morphology) {
+  this->pixels_per_meter = pixels_per_meter;
+  // Create blob detector backend according to the camera configuration
+  if (blob_detector_type == CameraConfiguration::BLOB_DETECTOR_CONNECTED_COMPONENTS) {
+    blob_detector = cv::Ptr<BlobDetector>(new ConnectedComponentsBlobDetector(minBlobArea, minBlobDist, size_morphology));
+  } else {
+    blob_detector = cv::Ptr<BlobDetector>(new SimpleBlobDetectorBackend(minBlobArea, minBlobDist));
+  }
 }
 
 PeopleDetector::~PeopleDetector() {}
 
 // Detect people in frame
-std::vector<Vector2> PeopleDetector::detect(cv::Mat& frame) {
+std::vector<Vector2> PeopleDetector::detect(const cv::Mat& frame, bool learn) {
   // Vector to store newly detected locations
   std::vector<Vector2> new_locations;
 
   // Initialize frames for operations
   cv::Mat background_subtr_frame;
-  cv::Mat thresh_frame;
-  cv::Mat keypoints_frame;
-
-  // Apply background subtractor to frame
-  background_subtractor->apply(frame, background_subtr_frame);
-  // Filter out shadows
-  threshold(background_subtr_frame, thresh_frame, 200, 255, 0);
-
-  // Vector to store keypoints
-  std::vector<cv::KeyPoint> keypoints;
-  // Detect blobs as keypoints
-  blob_detector->detect(thresh_frame, keypoints);
-  // Draw circle around keypoints
-  cv::drawKeypoints(thresh_frame, keypoints, keypoints_frame, cv::Scalar(0, 0, 255), cv::DrawMatchesFlags::DRAW_RICH_KEYPOINTS);
-
-  // Change keypoint locations according to perspective
-  for (auto &keypoint : keypoints) {
-    Vector2 new_location = changeToPerspective(keypoint.pt.x, keypoint.pt.y, frame.rows, frame.cols);
+  frame_size = frame.size();
+
+  // Only update the background model and threshold within the region of interest
+  const cv::Mat frame_roi = roi_rect.area() > 0 ? frame(roi_rect) : frame;
+
+  // Apply background model to frame
+  background_model->apply(frame_roi, background_subtr_frame, learn);
+  // Filter out shadows and ignore foreground in the bounding rect outside the region of interest, in tiles on every core
+  thresh_frame.create(background_subtr_frame.size(), CV_8UC1);
+  const double tiles = (background_subtr_frame.rows + ROWS_TILE - 1) / ROWS_TILE;
+  cv::parallel_for_(cv::Range(0, background_subtr_frame.rows), ThresholdTiles(background_subtr_frame, roi_mask, thresh_frame), tiles);
+
+  // Detect blobs, which the connected components backend also does in tiles on every core
+  blob_detector->detect(thresh_frame, blobs);
+
+  // Change blob locations from region of interest to frame and according to perspective
+  for (Blob& blob : blobs) {
+    blob.location = Vector2(blob.location.x + roi_rect.x, blob.location.y + roi_rect.y);
+    blob.bounding_box.x += roi_rect.x;
+    blob.bounding_box.y += roi_rect.y;
+    Vector2 new_location = changeToPerspective(blob.location.x, blob.location.y, frame.rows, frame.cols);
     new_locations.push_back(new_location);
   }
 
-  // Set frame with visible keyoints as frame to display
-  display_frame = keypoints_frame;
-
   // Return all new locations
   return new_locations;
 }
 
-cv::Mat PeopleDetector::getDisplayFrame() {
-  return display_frame;
+void PeopleDetector::setRegionOfInterest(const cv::Mat& mask) {
+  if (mask.empty()) {
+    roi_rect = cv::Rect();
+    roi_mask = cv::Mat();
+    return;
+  }
+  std::vector<cv::Point> points_roi;
+  cv::findNonZero(mask, points_roi);
+  roi_rect = cv::boundingRect(points_roi);
+  // Masking is only needed when the region of interest is not its bounding rect
+  if (cv::countNonZero(mask(roi_rect)) == roi_rect.area()) {
+    roi_mask = cv::Mat();
+  } else {
+    roi_mask = mask(roi_rect).clone();
+  }
+}
+
+const std::vector<Blob>& PeopleDetector::getBlobs() const {
+  return blobs;
+}
+
+cv::Mat PeopleDetector::getDisplayFrame() const {
+  // Thresholded region of interest in the whole frame
+  cv::Mat foreground_frame;
+  if (roi_rect.area() > 0) {
+    foreground_frame = cv::Mat::zeros(frame_size, thresh_frame.type());
+    thresh_frame.copyTo(foreground_frame(roi_rect));
+  } else {
+    foreground_frame = thresh_frame;
+  }
+
+  // Draw circle around blobs
+  std::vector<cv::KeyPoint> keypoints;
+  for (const Blob& blob : blobs) {
+    keypoints.push_back(cv::KeyPoint(blob.location.x, blob.location.y, 2 * std::sqrt(blob.area / CV_PI)));
+  }
+  cv::Mat keypoints_frame;
+  cv::drawKeypoints(foreground_frame, keypoints, keypoints_frame, cv::Scalar(0, 0, 255), cv::DrawMatchesFlags::DRAW_RICH_KEYPOINTS);
+  return keypoints_frame;
 }
 
 Vector2 PeopleDetector::changeToPerspective(int keypoint_x, int keypoint_y, float frame_height, float frame_width) {
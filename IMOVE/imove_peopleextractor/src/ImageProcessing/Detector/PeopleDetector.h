@@ -11,38 +11,56 @@
 #include "opencv2/imgproc.hpp"
 #include "opencv2/videoio.hpp"
 #include "../../../../util/src/Vector2.h"
+#include "../../../../util/src/configuration/CameraConfiguration.hpp"
+#include "BackgroundModel.h"
+#include "BlobDetector.h"
 
 class PeopleDetector {
  private:
-  // Parameters for SimpleBlobDetector
-  cv::SimpleBlobDetector::Params params;
+  // Background model backend
+  cv::Ptr<BackgroundModel> background_model;
 
-  // KNN background subtractor
-  cv::Ptr<cv::BackgroundSubtractorKNN> background_subtractor;
-
-  // Blob Detector
-  cv::Ptr<cv::SimpleBlobDetector> blob_detector;
+  // Blob Detector backend
+  cv::Ptr<BlobDetector> blob_detector;
+  CameraConfiguration::BlobDetector blob_detector_type;
 
   // Nr of pixels equal to one meter on the Scene
   float pixels_per_meter;
 
-  // Frame to display to check tracking
-  cv::Mat display_frame;
+  // Thresholded foreground and blobs of the last frame, drawn only when the display frame is asked for
+  cv::Mat thresh_frame;
+  std::vector<Blob> blobs;
+
+  // Bounding rect of the region of interest, empty for the whole frame
+  cv::Rect roi_rect;
+  // Mask of the region of interest within its bounding rect, empty when the whole rect is of interest
+  cv::Mat roi_mask;
+  // Size of the last frame
+  cv::Size frame_size;
 
   // Change location coordinates according to perspective
   Vector2 changeToPerspective(int keypoint_x, int keypoint_y, float frame_height, float frame_width);
 
  public:
   PeopleDetector();
-  // Constructor with number of pixels that represent one meter and wether the camera height is low or not
-  PeopleDetector(float pixels_per_meter, float minBlobArea, float minBlobDist);
+  // Constructor with number of pixels that represent one meter, blob size limits, the blob detector backend and the background model backend
+  PeopleDetector(float pixels_per_meter, float minBlobArea, float minBlobDist, CameraConfiguration::BlobDetector blob_detector_type, unsigned int size_morphology, CameraConfiguration::BackgroundModel background_model_type, float learning_rate, bool shadows);
   ~PeopleDetector();
 
-  // Detect people in frame
-  std::vector<Vector2> detect(cv::Mat& frame);
+  // Set up the blob detector for frames of another scale with sizes in pixels of that scale, keeping the background model which follows the frame size itself
+  void setScale(float pixels_per_meter, float minBlobArea, float minBlobDist, unsigned int size_morphology);
+
+  // Detect people in frame, learning the background from it unless told not to
+  std::vector<Vector2> detect(const cv::Mat& frame, bool learn = true);
+
+  // Only detect people in the non zero pixels of a mask of the frame size, in its bounding rect; empty mask for the whole frame
+  void setRegionOfInterest(const cv::Mat& mask);
+
+  // Get blobs of the last frame, in the same order as the returned locations
+  const std::vector<Blob>& getBlobs() const;
 
-  // Get display frame
-  cv::Mat getDisplayFrame();
+  // Get display frame, which is drawn on asking so detecting does not draw outside debug mode
+  cv::Mat getDisplayFrame() const;
 };
 
 #endif  // IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_PEOPLEDETECTOR_H_
@@ -0,0 +1,37 @@
+#include <cmath>
+#include <vector>
+
+#include "SimpleBlobDetectorBackend.h"
+
+SimpleBlobDetectorBackend::SimpleBlobDetectorBackend(float minBlobArea, float minBlobDist) {
+  // Set parameters for SimpleBlobDetector
+  params.filterByCircularity = false;
+  params.filterByColor = false;
+  params.filterByConvexity = false;
+  params.filterByInertia = false;
+  params.filterByArea = true;
+  params.maxArea = 1000000;
+
+  // Set parameters for SimpleBlobDetector according to the camera height
+  params.minArea = minBlobArea;
+  params.minDistBetweenBlobs = minBlobDist;
+
+  // Create SimpleBlobDetector
+  blob_detector = cv::SimpleBlobDetector::create(params);
+}
+
+void SimpleBlobDetectorBackend::detect(const cv::Mat& foreground, std::vector<Blob>& blobs) {
+  blobs.clear();
+  // Detect blobs as keypoints
+  blob_detector->detect(foreground, keypoints);
+
+  // Keypoints only have a diameter, so area and bounding box are of the circle around the blob
+  for (const cv::KeyPoint& keypoint : keypoints) {
+    const float radius = keypoint.size / 2;
+    Blob blob;
+    blob.location = Vector2(keypoint.pt.x, keypoint.pt.y);
+    blob.area = CV_PI * radius * radius;
+    blob.bounding_box = cv::Rect(keypoint.pt.x - radius, keypoint.pt.y - radius, keypoint.size, keypoint.size);
+    blobs.push_back(blob);
+  }
+}
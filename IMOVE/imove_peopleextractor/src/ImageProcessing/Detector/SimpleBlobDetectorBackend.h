@@ -0,0 +1,28 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_SIMPLEBLOBDETECTORBACKEND_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_SIMPLEBLOBDETECTORBACKEND_H_
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "BlobDetector.h"
+
+// Blob detection with opencv SimpleBlobDetector, which thresholds and extracts contours on several levels
+class SimpleBlobDetectorBackend : public BlobDetector {
+ private:
+  // Parameters for SimpleBlobDetector
+  cv::SimpleBlobDetector::Params params;
+
+  // Blob Detector
+  cv::Ptr<cv::SimpleBlobDetector> blob_detector;
+
+  // Keypoints of the last detection, kept to reuse their memory
+  std::vector<cv::KeyPoint> keypoints;
+
+ public:
+  // Constructor with minimum area of blobs and minimum distance between blobs in pixels
+  SimpleBlobDetectorBackend(float minBlobArea, float minBlobDist);
+
+  void detect(const cv::Mat& foreground, std::vector<Blob>& blobs);
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_DETECTOR_SIMPLEBLOBDETECTORBACKEND_H_
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "HungarianSolver.h"
+
+void HungarianSolver::solve(unsigned int rows, unsigned int columns, const std::vector<unsigned int>& edge_starts, const std::vector<Edge>& edges, double cost_unassigned, std::vector<int>& assignments) {
+  // Every row has a column of its own after the others, which assigning it to leaves it unassigned
+  const unsigned int columns_all = columns + rows;
+  potentials_rows.assign(rows, 0);
+  potentials_columns.assign(columns_all, 0);
+  column_rows.assign(columns_all, -1);
+  distances.assign(columns_all, std::numeric_limits<double>::infinity());
+  column_previous.assign(columns_all, -1);
+  column_done.assign(columns_all, 0);
+
+  // Add rows one by one, every time along the shortest path of reduced costs to a free column
+  for (unsigned int row = 0; row < rows; ++row) {
+    columns_reached.clear();
+    queue.clear();
+    reach(row, columns, edge_starts, edges, cost_unassigned, 0, -1);
+
+    // Dijkstra over the columns, through the rows assigned to them; the own column of the row is always free so a path is found
+    unsigned int column_free = 0;
+    double distance_free = 0;
+    while (!queue.empty()) {
+      std::pop_heap(queue.begin(), queue.end(), std::greater<std::pair<double, unsigned int> >());
+      const std::pair<double, unsigned int> next = queue.back();
+      queue.pop_back();
+      const unsigned int column = next.second;
+      if (column_done[column] || next.first > distances[column]) {
+        continue;
+      }
+      column_done[column] = 1;
+      if (column_rows[column] < 0) {
+        column_free = column;
+        distance_free = next.first;
+        break;
+      }
+      // The edge to the assigned row has a reduced cost of 0, so its other columns are reached from the same distance
+      reach(column_rows[column], columns, edge_starts, edges, cost_unassigned, next.first, column);
+    }
+
+    // Shift the potentials so every edge on a shortest path has a reduced cost of 0
+    potentials_rows[row] += distance_free;
+    for (unsigned int column : columns_reached) {
+      if (column_done[column] && column != column_free) {
+        const double shift = distance_free - distances[column];
+        potentials_columns[column] -= shift;
+        potentials_rows[column_rows[column]] += shift;
+      }
+    }
+
+    // Flip the assignments along the path
+    int column = column_free;
+    while (true) {
+      const int column_before = column_previous[column];
+      column_rows[column] = column_before < 0 ? row : column_rows[column_before];
+      if (column_before < 0) {
+        break;
+      }
+      column = column_before;
+    }
+
+    for (unsigned int column_reached : columns_reached) {
+      distances[column_reached] = std::numeric_limits<double>::infinity();
+      column_previous[column_reached] = -1;
+      column_done[column_reached] = 0;
+    }
+  }
+
+  assignments.assign(rows, -1);
+  for (unsigned int column = 0; column < columns; ++column) {
+    if (column_rows[column] >= 0) {
+      assignments[column_rows[column]] = column;
+    }
+  }
+}
+
+void HungarianSolver::reach(unsigned int row, unsigned int columns, const std::vector<unsigned int>& edge_starts, const std::vector<Edge>& edges, double cost_unassigned, double distance, int column_from) {
+  for (unsigned int e = edge_starts[row]; e < edge_starts[row + 1]; ++e) {
+    const unsigned int column = edges[e].column;
+    reach(column, distance + edges[e].cost - potentials_rows[row] - potentials_columns[column], column_from);
+  }
+  const unsigned int column_own = columns + row;
+  reach(column_own, distance + cost_unassigned - potentials_rows[row] - potentials_columns[column_own], column_from);
+}
+
+void HungarianSolver::reach(unsigned int column, double distance, int column_from) {
+  if (column_done[column] || distance >= distances[column]) {
+    return;
+  }
+  if (distances[column] == std::numeric_limits<double>::infinity()) {
+    columns_reached.push_back(column);
+  }
+  distances[column] = distance;
+  column_previous[column] = column_from;
+  queue.push_back(std::make_pair(distance, column));
+  std::push_heap(queue.begin(), queue.end(), std::greater<std::pair<double, unsigned int> >());
+}
@@ -0,0 +1,51 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_HUNGARIANSOLVER_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_HUNGARIANSOLVER_H_
+
+#include <utility>
+#include <vector>
+
+// Solver of the assignment problem with the hungarian method, which finds the assignment of least total cost.
+// Only the given pairs of rows and columns can be assigned, so the work stays with the rows which compete for columns.
+class HungarianSolver {
+ public:
+  // Pair of a row and a column which can be assigned, at a cost of at least 0
+  struct Edge {
+    unsigned int column;
+    double cost;
+  };
+
+  /**
+   * Assign rows to different columns, or leave them unassigned.
+   *
+   * @param rows            The amount of rows
+   * @param columns         The amount of columns
+   * @param edge_starts     The first edge of every row, and after those the end of the edges of the last row
+   * @param edges           The edges of all rows, row after row
+   * @param cost_unassigned The cost of leaving a row unassigned
+   * @param assignments     The column assigned to every row, -1 for none
+   **/
+  void solve(unsigned int rows, unsigned int columns, const std::vector<unsigned int>& edge_starts, const std::vector<Edge>& edges, double cost_unassigned, std::vector<int>& assignments);
+
+ private:
+  // Potentials of rows and columns, which keep the cost of every edge minus the potentials of its row and column at least 0
+  std::vector<double> potentials_rows;
+  std::vector<double> potentials_columns;
+  // Row assigned to every column, -1 for none
+  std::vector<int> column_rows;
+
+  // Shortest path search of the last row: per column the distance, the column before it and whether its distance is final
+  std::vector<double> distances;
+  std::vector<int> column_previous;
+  std::vector<char> column_done;
+  // Columns reached, and columns not final yet by distance
+  std::vector<unsigned int> columns_reached;
+  std::vector<std::pair<double, unsigned int> > queue;
+
+  // Reach the columns of the edges of a row at a distance, coming from a column or -1 for the row itself
+  void reach(unsigned int row, unsigned int columns, const std::vector<unsigned int>& edge_starts, const std::vector<Edge>& edges, double cost_unassigned, double distance, int column_from);
+
+  // Reach a column at a distance, when that is shorter than before
+  void reach(unsigned int column, double distance, int column_from);
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_HUNGARIANSOLVER_H_
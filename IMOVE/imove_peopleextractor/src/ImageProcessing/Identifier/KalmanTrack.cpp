@@ -0,0 +1,79 @@
+#include "KalmanTrack.h"
+
+KalmanTrack::KalmanTrack() : KalmanTrack(Vector2(0, 0), 0, 0) {}
+
+KalmanTrack::KalmanTrack(const Vector2& location, float variance_location, float variance_velocity) {
+  x.position = location.x;
+  y.position = location.y;
+  x.velocity = y.velocity = 0;
+  x.variance_position = y.variance_position = variance_location;
+  x.covariance = y.covariance = 0;
+  x.variance_velocity = y.variance_velocity = variance_velocity;
+}
+
+void KalmanTrack::Axis::predict(float seconds, float noise_acceleration) {
+  // Covariance through the motion, plus the noise of a random acceleration during the interval
+  const float seconds_squared = seconds * seconds;
+  position += velocity * seconds;
+  variance_position += 2 * seconds * covariance + seconds_squared * variance_velocity + noise_acceleration * seconds_squared * seconds / 3;
+  covariance += seconds * variance_velocity + noise_acceleration * seconds_squared / 2;
+  variance_velocity += noise_acceleration * seconds;
+}
+
+void KalmanTrack::Axis::update(float measurement, float variance_measurement) {
+  // Only the position is measured, the velocity is corrected through its covariance with the position
+  const float innovation = measurement - position;
+  const float variance_innovation = variance_position + variance_measurement;
+  if (variance_innovation <= 0) {
+    position = measurement;
+    return;
+  }
+  const float gain_position = variance_position / variance_innovation;
+  const float gain_velocity = covariance / variance_innovation;
+  position += gain_position * innovation;
+  velocity += gain_velocity * innovation;
+  variance_velocity -= gain_velocity * covariance;
+  variance_position *= 1 - gain_position;
+  covariance *= 1 - gain_position;
+}
+
+void KalmanTrack::predict(float seconds, float noise_acceleration) {
+  x.predict(seconds, noise_acceleration);
+  y.predict(seconds, noise_acceleration);
+}
+
+void KalmanTrack::update(const Vector2& location, float variance_measurement) {
+  x.update(location.x, variance_measurement);
+  y.update(location.y, variance_measurement);
+}
+
+void KalmanTrack::damp(float factor) {
+  x.velocity *= factor;
+  y.velocity *= factor;
+}
+
+Vector2 KalmanTrack::getLocation() const {
+  return Vector2(x.position, y.position);
+}
+
+void KalmanTrack::setLocation(const Vector2& location) {
+  x.position = location.x;
+  y.position = location.y;
+}
+
+Vector2 KalmanTrack::getVelocity() const {
+  return Vector2(x.velocity, y.velocity);
+}
+
+void KalmanTrack::getCovariance(float covariance[16]) const {
+  // State order x, y, velocity x, velocity y; the axes do not covary
+  for (int i = 0; i < 16; ++i) {
+    covariance[i] = 0;
+  }
+  covariance[0 * 4 + 0] = x.variance_position;
+  covariance[0 * 4 + 2] = covariance[2 * 4 + 0] = x.covariance;
+  covariance[2 * 4 + 2] = x.variance_velocity;
+  covariance[1 * 4 + 1] = y.variance_position;
+  covariance[1 * 4 + 3] = covariance[3 * 4 + 1] = y.covariance;
+  covariance[3 * 4 + 3] = y.variance_velocity;
+}
@@ -0,0 +1,69 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_KALMANTRACK_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_KALMANTRACK_H_
+
+#include "../../../../util/src/Vector2.h"
+
+// Constant velocity Kalman filter of the location of a person, in pixels and seconds.
+// The axes move independently, so the filter is kept as one small filter per axis without matrices or allocations.
+class KalmanTrack {
+ private:
+  // Position and velocity along one axis, and their covariance
+  struct Axis {
+    float position;
+    float velocity;
+    float variance_position;
+    float covariance;
+    float variance_velocity;
+
+    void predict(float seconds, float noise_acceleration);
+    void update(float measurement, float variance_measurement);
+  };
+
+  Axis x;
+  Axis y;
+
+ public:
+  KalmanTrack();
+
+  /**
+   * Start a track at a detected location with an unknown velocity.
+   *
+   * @param location             The detected location in pixels
+   * @param variance_location    The variance of the location in pixels squared
+   * @param variance_velocity    The variance of the velocity in pixels per second squared
+   **/
+  KalmanTrack(const Vector2& location, float variance_location, float variance_velocity);
+
+  /**
+   * Move the track along its velocity, and grow its uncertainty.
+   *
+   * @param seconds            The seconds since the last prediction
+   * @param noise_acceleration The variance of the acceleration in pixels squared per second cubed
+   **/
+  void predict(float seconds, float noise_acceleration);
+
+  /**
+   * Correct the track with a detected location.
+   *
+   * @param location             The detected location in pixels
+   * @param variance_measurement The variance of the detected location in pixels squared
+   **/
+  void update(const Vector2& location, float variance_measurement);
+
+  // Slow down by a factor between 0 and 1, when the person is not detected
+  void damp(float factor);
+
+  // Get the filtered location in pixels
+  Vector2 getLocation() const;
+
+  // Move the track to a location, keeping its velocity and uncertainty
+  void setLocation(const Vector2& location);
+
+  // Get the filtered velocity in pixels per second
+  Vector2 getVelocity() const;
+
+  // Get the covariance of x, y, velocity x and velocity y, row after row
+  void getCovariance(float covariance[16]) const;
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_KALMANTRACK_H_
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "LocationGrid.h"
+
+LocationGrid::LocationGrid(float size_cell) :
+    size_cell(std::max(1.f, size_cell)),
+    size_cell_used(this->size_cell),
+    origin_x(0),
+    origin_y(0),
+    columns(0),
+    rows(0) {}
+
+void LocationGrid::build(const std::vector<Vector2>& locations) {
+  this->locations = locations;
+  columns = 0;
+  rows = 0;
+  if (locations.empty()) {
+    return;
+  }
+
+  // The grid only spans the locations, so it needs no frame size
+  float minimum_x = locations[0].x;
+  float minimum_y = locations[0].y;
+  float maximum_x = minimum_x;
+  float maximum_y = minimum_y;
+  for (const Vector2& location : locations) {
+    minimum_x = std::min(minimum_x, location.x);
+    minimum_y = std::min(minimum_y, location.y);
+    maximum_x = std::max(maximum_x, location.x);
+    maximum_y = std::max(maximum_y, location.y);
+  }
+  origin_x = minimum_x;
+  origin_y = minimum_y;
+  size_cell_used = std::max(size_cell, std::sqrt((maximum_x - minimum_x) * (maximum_y - minimum_y) / MAXIMUM_CELLS));
+  size_cell_used = std::max(size_cell_used, std::max(maximum_x - minimum_x, maximum_y - minimum_y) / MAXIMUM_CELLS);
+  columns = static_cast<int>((maximum_x - minimum_x) / size_cell_used) + 1;
+  rows = static_cast<int>((maximum_y - minimum_y) / size_cell_used) + 1;
+
+  // Counting sort of the locations by cell
+  cell_starts.assign(columns * rows + 1, 0);
+  location_cells.resize(locations.size());
+  for (unsigned int i = 0; i < locations.size(); ++i) {
+    location_cells[i] = getRow(locations[i].y) * columns + getColumn(locations[i].x);
+    ++cell_starts[location_cells[i] + 1];
+  }
+  for (unsigned int c = 1; c < cell_starts.size(); ++c) {
+    cell_starts[c] += cell_starts[c - 1];
+  }
+  cell_locations.resize(locations.size());
+  std::vector<unsigned int> cell_ends(cell_starts.begin(), cell_starts.end() - 1);
+  for (unsigned int i = 0; i < locations.size(); ++i) {
+    cell_locations[cell_ends[location_cells[i]]++] = i;
+  }
+}
+
+void LocationGrid::query(const Vector2& point, float distance, std::vector<unsigned int>& indices) const {
+  if (columns == 0) {
+    return;
+  }
+  // Only the cells around the cell of the point can be within the distance
+  const int column_first = getColumn(point.x - distance);
+  const int column_last = getColumn(point.x + distance);
+  const int row_first = getRow(point.y - distance);
+  const int row_last = getRow(point.y + distance);
+  const float distance_squared = distance * distance;
+  for (int row = row_first; row <= row_last; ++row) {
+    for (int column = column_first; column <= column_last; ++column) {
+      const unsigned int cell = row * columns + column;
+      for (unsigned int k = cell_starts[cell]; k < cell_starts[cell + 1]; ++k) {
+        const Vector2& location = locations[cell_locations[k]];
+        const float dx = location.x - point.x;
+        const float dy = location.y - point.y;
+        if (dx * dx + dy * dy <= distance_squared) {
+          indices.push_back(cell_locations[k]);
+        }
+      }
+    }
+  }
+}
+
+int LocationGrid::getColumn(float x) const {
+  // Clamp before converting, as points far outside the grid do not fit an int
+  return static_cast<int>(std::min<float>(columns - 1, std::max(0.f, std::floor((x - origin_x) / size_cell_used))));
+}
+
+int LocationGrid::getRow(float y) const {
+  return static_cast<int>(std::min<float>(rows - 1, std::max(0.f, std::floor((y - origin_y) / size_cell_used))));
+}
@@ -0,0 +1,47 @@
+#ifndef IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_LOCATIONGRID_H_
+#define IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_LOCATIONGRID_H_
+
+#include <vector>
+
+#include "../../../../util/src/Vector2.h"
+
+// Uniform grid of cells over locations, to find the locations near a point without going over all of them
+class LocationGrid {
+ private:
+  // Maximum amount of cells, the cells grow when the locations are spread further
+  static const int MAXIMUM_CELLS = 4096;
+
+  // Size of a cell in pixels as asked and as used
+  float size_cell;
+  float size_cell_used;
+
+  // Top left of the grid and its amount of cells
+  float origin_x;
+  float origin_y;
+  int columns;
+  int rows;
+
+  // Locations of the last build
+  std::vector<Vector2> locations;
+  // Indices of locations sorted by cell, those of cell c from cell_starts[c] up to cell_starts[c + 1]
+  std::vector<unsigned int> cell_starts;
+  std::vector<unsigned int> cell_locations;
+  // Cell of every location
+  std::vector<unsigned int> location_cells;
+
+  // Get the cell column or row of a coordinate, clamped to the grid
+  int getColumn(float x) const;
+  int getRow(float y) const;
+
+ public:
+  // Constructor with the size of a cell in pixels, best the distance locations are usually searched within
+  explicit LocationGrid(float size_cell = 1);
+
+  // Sort locations into the cells, replacing the previous locations
+  void build(const std::vector<Vector2>& locations);
+
+  // Add the indices of the locations within a distance of a point
+  void query(const Vector2& point, float distance, std::vector<unsigned int>& indices) const;
+};
+
+#endif  // IMOVE_SRC_IMAGE_PROCESSING_IDENTIFIER_LOCATIONGRID_H_
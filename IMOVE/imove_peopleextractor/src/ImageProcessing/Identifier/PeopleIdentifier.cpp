@@ -1,23 +1,56 @@
+#include <algorithm>
+
 #include "PeopleIdentifier.h"
 
+// Factor the velocity of a person who is not detected is slowed down by, so people who stop are not predicted further
+const float DAMPING_UNDETECTED = 0.5;
+// Maximum seconds people are predicted ahead at once, so a paused pipeline does not send people off
+const float MAXIMUM_SECONDS_PREDICTION = 1.0;
 
-PeopleIdentifier::PeopleIdentifier() {}
+PeopleIdentifier::PeopleIdentifier() :
+    match_distance(std::numeric_limits<float>::max()),
+    noise_acceleration(0),
+    variance_measurement(0),
+    variance_velocity_initial(0),
+    timestamp_last(-1) {}
 
-PeopleIdentifier::PeopleIdentifier(const Boundary &projection_boundary) : projection_boundary(projection_boundary) {}
+PeopleIdentifier::PeopleIdentifier(const Boundary &projection_boundary, float match_distance, float acceleration, float measurement_noise) :
+    projection_boundary(projection_boundary),
+    match_distance(match_distance),
+    noise_acceleration(acceleration * acceleration),
+    variance_measurement(measurement_noise * measurement_noise),
+    // A new person may already walk at the speed reached by accelerating for a second
+    variance_velocity_initial(acceleration * acceleration),
+    timestamp_last(-1),
+    grid(match_distance) {}
 
 PeopleIdentifier::~PeopleIdentifier() {}
 
-std::vector<Person> PeopleIdentifier::match(std::vector<Vector2> &locations) {
-    // Go over all people detected in the previous frame and determine their new location or delete them
-    for (unsigned int i = 0; i < detected_people.size(); i++) {
-        // Get closest location to a person
-        int index_closest = getClosest(i, locations);
-        // If no close location is found, the person is standing still or left the scene
-        if (index_closest < 0) {
-            // If a person's type is 'None', the person is deleted
+std::vector<Person> PeopleIdentifier::match(const std::vector<Vector2> &locations, long long timestamp) {
+    // Predict where every person is now, so people are matched where they walked to rather than where they were
+    const float seconds = timestamp_last < 0 ? 0 : std::min(MAXIMUM_SECONDS_PREDICTION, std::max(0.f, (timestamp - timestamp_last) / 1e9f));
+    timestamp_last = timestamp;
+    for (Person& person : detected_people) {
+        person.getTrack().predict(seconds, noise_acceleration);
+    }
+
+    // Determine the new location of every person detected in the previous frame
+    classify(locations);
+    assign(locations);
+
+    // Go over all people detected in the previous frame and update them or delete them
+    for (unsigned int i = 0; i < detected_people.size();) {
+        const int index_location = person_locations[i];
+        // If no location is assigned, the person is standing still or left the scene
+        if (index_location < 0) {
+            detected_people[i].getTrack().damp(DAMPING_UNDETECTED);
+            // If a person's type is 'None', the person is deleted by moving the last person in its place
             if (detected_people[i].person_type == Person::PersonType::None) {
-                detected_people.erase(detected_people.begin() + i);
-                --i;
+                std::swap(detected_people[i], detected_people.back());
+                detected_people.pop_back();
+                person_locations[i] = person_locations.back();
+                person_locations.pop_back();
+                continue;
                 // If the person was standing outside the projection field when no new location was found, change type to 'None'
             } else if (detected_people[i].person_type == Person::PersonType::Bystander) {
                 detected_people[i].person_type = Person::PersonType::None;
@@ -35,49 +68,71 @@ std::vector<Person> PeopleIdentifier::match(std::vector<Vector2> &locations) {
                 detected_people[i].movement_type = Person::MovementType::StandingStill;
                 detected_people[i].resetNotMovedCount();
             }
-            // If a close location is found ...
+            // If a location is assigned ...
         } else {
             // ... determine if person is a bystander or a Participant based on location and boundary
-            if (projection_boundary.inBounds(locations[index_closest])) {
+            if (locations_inside[index_location]) {
                 detected_people[i].person_type = Person::PersonType::Participant;
             } else {
                 detected_people[i].person_type = Person::PersonType::Bystander;
             }
-            //Set location of person to new location
-            detected_people[i].setLocation(locations[index_closest]);
+            // Correct the predicted location of person with the new location
+            detected_people[i].getTrack().update(locations[index_location], variance_measurement);
             detected_people[i].movement_type = Person::MovementType::Moving;
-            // Delete locations that have been taken
-            locations.erase(locations.begin() + index_closest);
         }
+        ++i;
     }
-    // Go over all remaining locations
+    // Go over all locations which are not assigned
     for (unsigned int j = 0; j < locations.size(); j++) {
         // Turn locations into a new person if loction is close to the edge of the frame
-        if (!projection_boundary.inBounds(locations[j])) {
-            Person new_person = Person(locations[j], Person::PersonType::Bystander);
+        if (!location_taken[j] && !locations_inside[j]) {
+            Person new_person = Person(KalmanTrack(locations[j], variance_measurement, variance_velocity_initial), Person::PersonType::Bystander);
             detected_people.push_back(new_person);
         }
     }
     return detected_people;
 }
 
-int PeopleIdentifier::getClosest(unsigned int index, std::vector<Vector2> &new_locations) {
-    Person person = detected_people[index];
-    // Initialize minimum distance
-    float min_distance = std::numeric_limits<float>::max();
-    // Initialize min index
-    int min_index = -1;
+void PeopleIdentifier::classify(const std::vector<Vector2> &locations) {
+    locations_x.resize(locations.size());
+    locations_y.resize(locations.size());
+    locations_inside.resize(locations.size());
+    for (unsigned int j = 0; j < locations.size(); ++j) {
+        locations_x[j] = locations[j].x;
+        locations_y[j] = locations[j].y;
+    }
+    projection_boundary.getHalfPlanes().contains(locations_x.data(), locations_y.data(), locations.size(), locations_inside.data());
+}
+
+void PeopleIdentifier::assign(const std::vector<Vector2> &locations) {
+    const unsigned int amount_people = detected_people.size();
+    const double cost_maximum = static_cast<double>(match_distance) * match_distance;
+
+    // Find the locations within reach of every person
+    grid.build(locations);
+    candidates.clear();
+    candidate_starts.assign(amount_people + 1, 0);
+    for (unsigned int i = 0; i < amount_people; ++i) {
+        const Vector2 location_person = detected_people[i].getLocation();
+        nearby.clear();
+        grid.query(location_person, match_distance, nearby);
+        for (unsigned int j : nearby) {
+            const double dx = locations[j].x - location_person.x;
+            const double dy = locations[j].y - location_person.y;
+            HungarianSolver::Edge candidate;
+            candidate.column = j;
+            candidate.cost = dx * dx + dy * dy;
+            candidates.push_back(candidate);
+        }
+        candidate_starts[i + 1] = candidates.size();
+    }
 
-    for (unsigned int i = 0; i < new_locations.size(); i++) {
-        // Calculate distance between current person and location
-        float distance = person.getLocation().distance(new_locations[i]);
-        // Check if location is closer than previous locations and the threshold
-        if (distance < min_distance) {
-            // Set distance as minimum and index as closest index
-            min_distance = distance;
-            min_index = i;
+    // Leaving a person unassigned costs two squared match distances, one for the person and one for the location it could have had
+    solver.solve(amount_people, locations.size(), candidate_starts, candidates, 2 * cost_maximum, person_locations);
+    location_taken.assign(locations.size(), 0);
+    for (int index_location : person_locations) {
+        if (index_location >= 0) {
+            location_taken[index_location] = 1;
         }
     }
-    // Return index of closest location
-    return min_index;
 }
@@ -10,6 +10,8 @@
 
 #include "../../../../util/src/Boundary.h"
 #include "../../Person.h"
+#include "HungarianSolver.h"
+#include "LocationGrid.h"
 
 class PeopleIdentifier {
  private:
@@ -19,16 +21,57 @@ class PeopleIdentifier {
   // Boundary of projection to seperate bystanders from participants
   Boundary projection_boundary;
 
-  // Get closest location to a Person
-  int getClosest(unsigned int index, std::vector<Vector2>& new_locations);
+  // Maximum distance in pixels between where a person is predicted and its new location
+  float match_distance;
+
+  // Variance of the acceleration of people in pixels squared per second cubed, and of detected locations in pixels squared
+  float noise_acceleration;
+  float variance_measurement;
+  // Variance of the velocity of new people in pixels per second squared
+  float variance_velocity_initial;
+
+  // Steady clock time in nanoseconds of the last locations, -1 before the first
+  long long timestamp_last;
+
+  // Grid of the new locations to find candidates with
+  LocationGrid grid;
+  HungarianSolver solver;
+
+  // Locations within the match distance of every person and their squared distance, kept to reuse their memory
+  std::vector<unsigned int> candidate_starts;
+  std::vector<HungarianSolver::Edge> candidates;
+  std::vector<unsigned int> nearby;
+
+  // Index of the location assigned to every person, -1 for none, and whether every location is assigned
+  std::vector<int> person_locations;
+  std::vector<char> location_taken;
+
+  // Coordinates of the new locations and whether they are within the projection boundary, classified at once
+  std::vector<float> locations_x;
+  std::vector<float> locations_y;
+  std::vector<unsigned char> locations_inside;
+
+  // Classify all new locations against the projection boundary
+  void classify(const std::vector<Vector2>& locations);
+
+  // Assign locations to people so the sum of squared distances is least, only within the match distance
+  void assign(const std::vector<Vector2>& locations);
 
  public:
   PeopleIdentifier();
-  PeopleIdentifier(const Boundary& projection_boundary);
+  /**
+   * Constructor with the boundary of the projection and the motion of people.
+   *
+   * @param projection_boundary The boundary of the projection to seperate bystanders from participants
+   * @param match_distance      The maximum distance in pixels a person moves from where it is predicted between frames
+   * @param acceleration        The typical acceleration of a person in pixels per second squared
+   * @param measurement_noise   The typical error of a detected location in pixels
+   **/
+  PeopleIdentifier(const Boundary& projection_boundary, float match_distance, float acceleration, float measurement_noise);
   ~PeopleIdentifier();
 
-  // Match people to new locations and locations to (new) people
-  std::vector<Person> match(std::vector<Vector2>& locations);
+  // Match people to new locations, detected at a steady clock time in nanoseconds, and locations to (new) people
+  std::vector<Person> match(const std::vector<Vector2>& locations, long long timestamp);
 };
 
 
@@ -1,7 +1,20 @@
+#include <chrono>
+#include <cmath>
+
 #include "PeopleExtractor.h"
 
+// Steady clock time in nanoseconds, which is the same clock in every process
+static long long nowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Size of frames people are detected in at a scale of the frame size
+static cv::Size getDetectionSize(const cv::Size& frame_size, float detection_scale) {
+  return cv::Size(std::lround(frame_size.width * detection_scale), std::lround(frame_size.height * detection_scale));
+}
+
 // PeopleExtractor::PeopleExtractor(const cv::Size& frame_size, float pixels_per_meter, float resolution_resize_height, const Boundary& boundary) {
-PeopleExtractor::PeopleExtractor(CameraConfiguration* camConfig) {
+PeopleExtractor::PeopleExtractor(CameraConfiguration* camConfig) : camera_configuration(camConfig) {
   // Get values from camera configuration
   frame_size = camConfig->getResolution();
   float pixels_per_meter = camConfig->getMeter();
@@ -10,11 +23,15 @@ PeopleExtractor::PeopleExtractor(CameraConfiguration* camConfig) {
   // Calculate resize ratio
   resize_ratio = 1;
 
+  timestamp_detected = 0;
+  timestamp_matched = 0;
+
   // Initialize empty frame
   frame = cv::Mat::zeros(frame_size.height, frame_size.width, CV_8UC1);
 
   // Initialize Detector
-  detector = PeopleDetector(pixels_per_meter, camConfig->getMinBlobArea(), camConfig->getMinBlobDistance());
+  detection_scale = 0;
+  setupDetector(1);
 
   // Initialize projector boundary
   Boundary proj_bound = Boundary(Vector2(boundary.getUpperLeft().x, boundary.getUpperLeft().y),
@@ -23,24 +40,94 @@ PeopleExtractor::PeopleExtractor(CameraConfiguration* camConfig) {
                             Vector2(boundary.getLowerRight().x, boundary.getLowerRight().y));
 
   // Initialize Identifier
-  identifier = PeopleIdentifier(proj_bound);
+  identifier = PeopleIdentifier(proj_bound, camConfig->getMatchDistance() * pixels_per_meter, camConfig->getTrackAcceleration() * pixels_per_meter, camConfig->getTrackMeasurementNoise() * pixels_per_meter);
 }
 
 PeopleExtractor::~PeopleExtractor() {}
 
-const scene_interface::People PeopleExtractor::extractPeople(cv::Mat& new_frame) {
-  // Convert frame to grayscale
-  //cvtColor(new_frame, new_frame, CV_RGB2GRAY);
-  // Downscale frame
-  resize(new_frame, new_frame, frame_size);
+void PeopleExtractor::setupDetector(float detection_scale) {
+  const bool first = this->detection_scale == 0;
+  this->detection_scale = detection_scale;
+  // Sizes in pixels shrink with the frame, areas by the square
+  const float pixels_per_meter = camera_configuration->getMeter() * detection_scale;
+  const unsigned int size_morphology = std::lround(camera_configuration->getBlobMorphologySize() * detection_scale);
+  if (first) {
+    detector = PeopleDetector(pixels_per_meter, camera_configuration->getMinBlobArea() * detection_scale * detection_scale, camera_configuration->getMinBlobDistance() * detection_scale, camera_configuration->getBlobDetector(), size_morphology, camera_configuration->getBackgroundModel(), camera_configuration->getBackgroundLearningRate(), camera_configuration->getBackgroundShadows());
+  } else {
+    detector.setScale(pixels_per_meter, camera_configuration->getMinBlobArea() * detection_scale * detection_scale, camera_configuration->getMinBlobDistance() * detection_scale, size_morphology);
+  }
+  // Only detect on the projection and the bystanders around it if configured
+  if (camera_configuration->getRoi()) {
+    const Boundary projection = camera_configuration->getProjection();
+    const Boundary projection_scaled(
+      Vector2(projection.getUpperLeft().x * detection_scale, projection.getUpperLeft().y * detection_scale),
+      Vector2(projection.getUpperRight().x * detection_scale, projection.getUpperRight().y * detection_scale),
+      Vector2(projection.getLowerLeft().x * detection_scale, projection.getLowerLeft().y * detection_scale),
+      Vector2(projection.getLowerRight().x * detection_scale, projection.getLowerRight().y * detection_scale)
+    );
+    detector.setRegionOfInterest(createRegionOfInterest(projection_scaled, camera_configuration->getRoiMargin() * pixels_per_meter, getDetectionSize(frame_size, detection_scale)));
+  }
+}
 
-  // Start working with new frame
-  frame = new_frame;
+cv::Mat PeopleExtractor::createRegionOfInterest(const Boundary& projection, float margin, const cv::Size& frame_size) {
+  // Fill the projection quad
+  cv::Mat outside_projection(frame_size, CV_8UC1, cv::Scalar(255));
+  std::vector<cv::Point> corners;
+  corners.push_back(cv::Point(projection.getUpperLeft().x, projection.getUpperLeft().y));
+  corners.push_back(cv::Point(projection.getUpperRight().x, projection.getUpperRight().y));
+  corners.push_back(cv::Point(projection.getLowerRight().x, projection.getLowerRight().y));
+  corners.push_back(cv::Point(projection.getLowerLeft().x, projection.getLowerLeft().y));
+  cv::fillConvexPoly(outside_projection, corners, cv::Scalar(0));
+
+  // Grow the quad by the margin using the distance of every pixel to it, which is linear in pixels unlike dilating with a large kernel
+  cv::Mat distance_projection;
+  cv::distanceTransform(outside_projection, distance_projection, cv::DIST_L2, 3);
+  cv::Mat mask;
+  cv::threshold(distance_projection, mask, margin, 255, cv::THRESH_BINARY_INV);
+  mask.convertTo(mask, CV_8UC1);
+  return mask;
+}
+
+const scene_interface::People PeopleExtractor::extractPeople(const cv::Mat& new_frame) {
   // Get a vector with every Person in the Scene, generated by the Identifier from the locations provided by the Detector
-  std::vector<Vector2> locations = detector.detect(frame);
-  std::vector<Person> people = identifier.match(locations);
+  std::vector<Vector2> locations = detectPeople(new_frame);
+  return identifyPeople(locations, timestamp_detected);
+}
 
-  debug_frame = detector.getDisplayFrame();
+std::vector<Vector2> PeopleExtractor::detectPeople(const cv::Mat& new_frame) {
+  return detectPeople(new_frame, 1, true);
+}
+
+std::vector<Vector2> PeopleExtractor::detectPeople(const cv::Mat& new_frame, float detection_scale, bool learn) {
+  if (detection_scale != this->detection_scale) {
+    setupDetector(detection_scale);
+  }
+
+  // Frames are converted to grayscale on ingestion when configured, the detector works on any amount of channels
+  // Downscale frame, frames which are already of the detection size are used as is instead of copied
+  const cv::Size size_detection = getDetectionSize(frame_size, detection_scale);
+  if (new_frame.size() == size_detection) {
+    frame = new_frame;
+  } else {
+    resize(new_frame, frame_resized, size_detection);
+    frame = frame_resized;
+  }
+
+  // Start working with new frame
+  std::vector<Vector2> locations = detector.detect(frame, learn);
+  timestamp_detected = nowNanoseconds();
+  // Locations of the frame size, so people are identified the same at every scale
+  if (detection_scale != 1) {
+    for (Vector2& location : locations) {
+      location = Vector2(location.x / detection_scale, location.y / detection_scale);
+    }
+  }
+  return locations;
+}
+
+const scene_interface::People PeopleExtractor::identifyPeople(std::vector<Vector2>& locations, long long timestamp_capture) {
+  std::vector<Person> people = identifier.match(locations, timestamp_capture);
+  timestamp_matched = nowNanoseconds();
 
   // Rescale location of every person based on downscaling
   for (Person& p : people) {
@@ -83,6 +170,7 @@ const scene_interface::People PeopleExtractor::convert(std::vector<Person>& peop
       }
 
 		Vector2 location = person.getLocation();
+		Vector2 velocity = person.getVelocity();
     // Add converted person to interface_people
 	  interface_people.push_back(scene_interface::Person(
 	      person.getId(),
@@ -91,12 +179,24 @@ const scene_interface::People PeopleExtractor::convert(std::vector<Person>& peop
 					location.y
 				),
 	      interface_person_type,
-	      interface_movement_type
+	      interface_movement_type,
+	      scene_interface::Location(
+					velocity.x * resize_ratio,
+					velocity.y * resize_ratio
+				)
 	  ));
   }
   return interface_people;
 }
 
 const cv::Mat PeopleExtractor::getDebugFrame() const {
-  return debug_frame;
+  return detector.getDisplayFrame();
+}
+
+long long PeopleExtractor::getTimestampDetected() const {
+  return timestamp_detected;
+}
+
+long long PeopleExtractor::getTimestampMatched() const {
+  return timestamp_matched;
 }
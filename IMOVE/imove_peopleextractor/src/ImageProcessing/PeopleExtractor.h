@@ -31,27 +31,62 @@ class PeopleExtractor {
 
   // Current frame
   cv::Mat frame;
-  // Debug frame
-  cv::Mat debug_frame;
+  // Frame resized to the frame size, only used when frames are of another size
+  cv::Mat frame_resized;
 
   // Size of the frame after resizing
   cv::Size frame_size;
 
+  // Camera configuration the detector is set up from
+  CameraConfiguration* camera_configuration;
+  // Factor of the frame size people are detected in, which the detector is set up for
+  float detection_scale;
+
+  // Set up the detector for frames of the frame size scaled by a factor; the background model is created once and scales along with the frames
+  void setupDetector(float detection_scale);
+
+  // Create the mask of the projection plus a margin in pixels around it, in a frame of the given size
+  static cv::Mat createRegionOfInterest(const Boundary& projection, float margin, const cv::Size& frame_size);
+
   // Convert objects from the People class to the scene interface People class
   const scene_interface::People convert(std::vector<Person>& people);
 
   // Ratio with which the frame is resized
   float resize_ratio;
 
+  // Steady clock nanoseconds on which detecting and matching of the last frame finished
+  long long timestamp_detected;
+  long long timestamp_matched;
+
  public:
   PeopleExtractor(CameraConfiguration* camConfig);
   ~PeopleExtractor();
 
   // Main extraction function to extract people from a frame
-  const scene_interface::People extractPeople(cv::Mat& new_frame);
+  const scene_interface::People extractPeople(const cv::Mat& new_frame);
 
-  // Display image processing results
+  // Detect locations of people in a frame, first half of extractPeople which can run on another thread than the second; the frame is not changed
+  std::vector<Vector2> detectPeople(const cv::Mat& new_frame);
+
+  /**
+   * Detect locations of people in a frame with less work when the pipeline can not keep up.
+   *
+   * @param new_frame       The frame, which is not changed
+   * @param detection_scale The factor of the frame size people are detected in; the locations are of the frame size still
+   * @param learn           Whether the background model learns from the frame
+   **/
+  std::vector<Vector2> detectPeople(const cv::Mat& new_frame, float detection_scale, bool learn);
+
+  // Identify people from detected locations in a frame captured at a steady clock time in nanoseconds, second half of extractPeople
+  const scene_interface::People identifyPeople(std::vector<Vector2>& locations, long long timestamp_capture);
+
+  // Display image processing results of the last detected frame, drawn on asking
   const cv::Mat getDebugFrame() const;
+
+  // Steady clock nanoseconds on which detecting people in the last frame finished
+  long long getTimestampDetected() const;
+  // Steady clock nanoseconds on which matching people in the last frame finished
+  long long getTimestampMatched() const;
 };
 
 #endif  // IMOVE_SRC_IMAGE_PROCESSING_PEOPLEEXTRACTOR_H_
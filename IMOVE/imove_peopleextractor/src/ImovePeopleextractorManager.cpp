@@ -1,6 +1,13 @@
 #include <opencv2/opencv.hpp>
 #include <SFML/Graphics.hpp>
 #include <thread>
+#include <chrono>
+#include <iostream>
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "ImovePeopleextractorManager.hpp"
 
@@ -12,9 +19,32 @@
 #include "Windows/DetectedPeopleCameraWindow.hpp"
 #include "Windows/DetectedPeopleProjectionWindow.hpp"
 #include "Windows/ImageWindow.hpp"
+#include "Capture/CameraFrameSource.hpp"
+#include "Capture/FreshestFrameSource.hpp"
+#include "Capture/ReplayFrameSource.hpp"
+#include "Capture/SyntheticFrameSource.hpp"
+#include "Pipeline/Ingestion.hpp"
 #include "../../scene_interface_sma/src/SharedMemory.hpp"
 
-ImovePeopleextractorManager::ImovePeopleextractorManager(ImoveConfiguration* calibration) : calibration(calibration), projection(Projection(calibration)) {
+ImovePeopleextractorManager::ImovePeopleextractorManager(ImoveConfiguration* calibration) :
+	calibration(calibration),
+	projection(calibration),
+	queue_preprocess(calibration->getPipelineConfiguration()->getQueueCapacity(), calibration->getPipelineConfiguration()->getDropPolicy()),
+	queue_detect(calibration->getPipelineConfiguration()->getQueueCapacity(), calibration->getPipelineConfiguration()->getDropPolicy()),
+	queue_identify(calibration->getPipelineConfiguration()->getQueueCapacity(), calibration->getPipelineConfiguration()->getDropPolicy()),
+	// debug windows only show the freshest camera frame and never hold back the other stages
+	queue_debug(1, PipelineConfiguration::DROP_POLICY_OLDEST),
+	timing_capture("capture"),
+	timing_preprocess("preprocess"),
+	timing_detect("detect"),
+	timing_identify("identify"),
+	timing_debug("debug"),
+	load_controller(calibration->getPipelineConfiguration()->getBudgetMs() * 1000000LL),
+	frames_dropped_load(0),
+	people_left_out(0),
+	recording_writer(NULL),
+	receiving_sceneframes(false)
+{
 	CameraConfiguration* camera_configuration = this->calibration->getCameraConfiguration();
 	// setup people extractor
 	//this->people_extractor = new PeopleExtractor(camera_configuration->getResolution(), camera_configuration->getMeter(), 216, camera_configuration->getProjection().createReorientedTopLeftBoundary());
@@ -24,124 +54,433 @@ ImovePeopleextractorManager::ImovePeopleextractorManager(ImoveConfiguration* cal
 	this->segment = new boost::interprocess::managed_shared_memory(boost::interprocess::open_only, scene_interface_sma::NAME_SHARED_MEMORY);
 	// Get the extracted people queue in the segment
 	this->si_people_queue = this->segment->find<scene_interface_sma::PeopleQueue>(scene_interface_sma::NAME_PEOPLE_QUEUE).first;
-	// Get the people extractor scene frames queue in the segment
-	this->pi_sceneframe_queue = this->segment->find<peopleextractor_interface_sma::SceneframeQueue>(peopleextractor_interface_sma::NAME_SCENEFRAME_QUEUE).first;
+	// Get the latest extracted people snapshot in the segment
+	this->si_people_snapshot = this->segment->find<scene_interface_sma::PeopleSnapshot>(scene_interface_sma::NAME_PEOPLE_SNAPSHOT).first;
+	// Get the trace of camera frames in the segment
+	this->si_trace_ring = this->segment->find<scene_interface_sma::TraceRing>(scene_interface_sma::NAME_TRACE_RING).first;
+	// Get the sequence of camera frames in the segment, which outlives restarts of the people extractor
+	this->si_frame_sequence = this->segment->find<scene_interface_sma::FrameSequence>(scene_interface_sma::NAME_FRAME_SEQUENCE).first;
+	// Get the people extractor scene frames buffer in the segment
+	this->pi_sceneframe_buffer = this->segment->find<peopleextractor_interface_sma::SceneframeBuffer>(peopleextractor_interface_sma::NAME_SCENEFRAME_BUFFER).first;
 	this->running = this->segment->find<Running>(NAME_SHARED_MEMORY_RUNNING).first;
+	this->heartbeat = this->segment->find<Heartbeat>(NAME_SHARED_MEMORY_HEARTBEAT_PEOPLEEXTRACTOR).first;
+	// Lock shared memory in memory of this process if configured
+	if (this->calibration->getLockSharedMemory()) {
+		peopleextractor_interface_sma::SharedMemoryArena::prefault(this->segment, true);
+	}
 }
 
 void ImovePeopleextractorManager::receiveSceneFrameAndFeedProjectionThread(ImovePeopleextractorManager* imove_peopleextractor_manager) {
 	imove_peopleextractor_manager->receiveSceneFrameAndFeedProjection();
 }
 
-void ImovePeopleextractorManager::run() {
-	const unsigned int& iterations_delay_peopleextracting = this->calibration->getProjectioneliminationConfiguration()->getIterationsDelayPeopleextracting();
-
-	// debug windows
-	PeopleextractorWindow* window_peopleextractor;
-	DetectedPeopleCameraWindow* detectedpeople_camera_window;
-	ImageWindow* eliminatedprojection_camera_window;
-	DetectedPeopleProjectionWindow* detectedpeople_projection_window;
-	if (this->calibration->getDebugMode()) {
-		float width_resolution_projector = this->calibration->getProjectorConfiguration()->getResolution().width;
-		 window_peopleextractor = new PeopleextractorWindow(
-			cv::Point2i(width_resolution_projector, 0),
-			cv::Size(600, 600),
-			this->people_extractor
-		);
-		detectedpeople_camera_window = new DetectedPeopleCameraWindow(
-			cv::Point2i(width_resolution_projector + 600, 0),
-			cv::Size(600, 600)
-		);
-		eliminatedprojection_camera_window = new ImageWindow(
-			"Eliminated projection camera frame",
-			cv::Point2i(width_resolution_projector, 600),
-			cv::Size(300, 300)
-		);
-		detectedpeople_projection_window = new DetectedPeopleProjectionWindow(
-			cv::Point2i(width_resolution_projector + 300, 600),
-			cv::Size(300, 300)
-		);
+bool ImovePeopleextractorManager::run() {
+	CaptureConfiguration* capture_configuration = this->calibration->getCaptureConfiguration();
+	if (capture_configuration->getSource() == CaptureConfiguration::SOURCE_REPLAY_PEOPLE) {
+		this->replayExtractedpeople();
+		return true;
 	}
 
-	// setup camera
-	cv::VideoCapture video_capture(this->calibration->getCameraConfiguration()->getDeviceid());
+	unsigned long long allocations_warmup = 0;
 
-	cv::Mat frame_camera;
-	cv::Mat frame_projection;
-	cv::Mat detectpeople_frame;
-	scene_interface::People people_camera;
-	CameraConfiguration* camera_configuration = this->calibration->getCameraConfiguration();
-	// while no key pressed
-	while (video_capture.read(frame_camera)) {
-		cv::resize(frame_camera, frame_camera, camera_configuration->getResolution());
+	// setup camera or replay
+	FrameSource* frame_source = this->createFrameSource();
+	// grab camera frames on a thread of their own and only take the newest, so buffered camera frames never lag behind
+	FreshestFrameSource* frame_source_freshest = NULL;
+	if (capture_configuration->getFreshest()) {
+		frame_source_freshest = new FreshestFrameSource(frame_source);
+		frame_source = frame_source_freshest;
+	}
+	// setup recording camera frames and extracted people
+	if (!capture_configuration->getRecordingFile().empty()) {
+		this->recording_writer = new RecordingWriter(capture_configuration->getRecordingFile());
+	}
 
-		// debug projection frame
-		this->projection.createFrameProjectionFromFrameCamera(
-				frame_projection,
-				frame_camera
-				//frame_resized
-		);
+	// receive the scene frames the projection is eliminated with while capturing
+	this->receiving_sceneframes = true;
+	std::thread thread_sceneframes(&ImovePeopleextractorManager::receiveSceneFrameAndFeedProjectionThread, this);
+
+	// start the stages after capturing, each waiting on camera frames from the previous one
+	std::thread thread_preprocess(&ImovePeopleextractorManager::preprocessThread, this);
+	std::thread thread_detect(&ImovePeopleextractorManager::detectThread, this);
+	std::thread thread_identify(&ImovePeopleextractorManager::identifyThread, this);
+	std::thread thread_debug(&ImovePeopleextractorManager::debugThread, this);
+
+	// only some camera frames are drawn in the debug windows, the others skip all debug work
+	const bool debug_mode = this->calibration->getDebugMode();
+	const unsigned int debug_fps = this->calibration->getPipelineConfiguration()->getDebugFps();
+	const long long nanoseconds_debug = debug_fps == 0 ? 0 : 1000000000LL / debug_fps;
+	long long timestamp_debug = 0;
 
-		// delay for syncing processing projection elimination
-		for (unsigned int i = 0; i < iterations_delay_peopleextracting; ++i) {}
-		// eliminate projection from camera frame
-		cv::Mat frame_eliminatedprojection;
-		this->projection.eliminateProjectionFeedbackFromFrameCamera(frame_eliminatedprojection, frame_camera);
-		if (this->calibration->getDebugMode()) {
-			eliminatedprojection_camera_window->drawImage(frame_eliminatedprojection);
+	unsigned long long processed = 0;
+	unsigned long long captured = 0;
+	// whether the camera frames ended while still running
+	bool ended = false;
+	// while no key pressed and application running
+	while (this->running->running) {
+		// new camera frame every time, as queued camera frames are still used by later stages; only its own frames come from the pool
+		PipelineFrame frame(&this->frame_pool);
+		this->timing_capture.begin();
+		if (!frame_source->read(frame.frame_captured)) {
+			ended = true;
+			break;
 		}
+		// drop the camera frames the pipeline has no time for at the current load
+		const LoadController::Level& level = LoadController::getSettings(this->load_controller.getLevel());
+		if (++captured % level.frames_keep != 0) {
+			++this->frames_dropped_load;
+			continue;
+		}
+		// number and time the camera frame so the scene can detect skipped frames and age, continuing after a restart
+		frame.sequence = this->si_frame_sequence->next();
+		frame.timestamp_capture = frame_source_freshest != NULL ? frame_source_freshest->getTimestampCapture() : scene_interface_sma::TraceRing::now();
+		this->si_trace_ring->record(frame.sequence, scene_interface_sma::TRACE_STAGE_CAPTURE, frame.timestamp_capture);
+		frame.debug = debug_mode && (timestamp_debug == 0 || frame.timestamp_capture - timestamp_debug >= nanoseconds_debug);
+		if (frame.debug) {
+			timestamp_debug = frame.timestamp_capture;
+		}
+		frame.detection_scale = level.detection_scale;
+		frame.learn = frame.sequence % level.frames_learn == 0;
+		this->timing_capture.end();
+		this->queue_preprocess.push(frame);
+		// every buffer in flight exists once the pipeline is filled
+		if (++processed == ImovePeopleextractorManager::FRAMES_WARMUP_POOL) {
+			allocations_warmup = this->frame_pool.getAllocations();
+		}
+	}
+
+	// let every stage finish its queued camera frames and close the queue into the next one
+	this->queue_preprocess.close();
+	thread_preprocess.join();
+	thread_detect.join();
+	thread_identify.join();
+	thread_debug.join();
+	// no projection is eliminated anymore, also when the camera frames ended while still running
+	this->receiving_sceneframes = false;
+	thread_sceneframes.join();
+
+	if (frame_source_freshest != NULL) {
+		std::cout << "Peopleextractor freshest capture dropped: " << frame_source_freshest->getDropped()
+			<< " of " << frame_source_freshest->getGrabbed() << " grabbed" << std::endl;
+	}
+
+	// safe release camera and finish recording
+	delete frame_source;
+	delete this->recording_writer;
+	this->recording_writer = NULL;
+
+	ImovePeopleextractorManager::printStage(this->timing_capture, NULL);
+	ImovePeopleextractorManager::printStage(this->timing_preprocess, &this->queue_preprocess);
+	ImovePeopleextractorManager::printStage(this->timing_detect, &this->queue_detect);
+	ImovePeopleextractorManager::printStage(this->timing_identify, &this->queue_identify);
+	ImovePeopleextractorManager::printStage(this->timing_debug, &this->queue_debug);
+	this->printPeopleSent();
+	std::cout << "Peopleextractor load level changes: " << this->load_controller.getChanges()
+		<< " highest level: " << this->load_controller.getLevelMaximum()
+		<< " dropped: " << this->frames_dropped_load << " of " << captured << std::endl;
+
+	std::cout << "Peopleextractor frame pool buffers: " << this->frame_pool.getAllocations()
+		<< " freed: " << this->frame_pool.getFrees()
+		<< " bytes: " << this->frame_pool.getBytes()
+		<< " acquired: " << this->frame_pool.getAcquisitions();
+	if (processed >= ImovePeopleextractorManager::FRAMES_WARMUP_POOL) {
+		std::cout << " allocated after " << ImovePeopleextractorManager::FRAMES_WARMUP_POOL << " frames: " << this->frame_pool.getAllocations() - allocations_warmup;
+	}
+	std::cout << std::endl;
+
+	std::cout << "Peopleextractor shared memory free: " << this->segment->get_free_memory() << " bytes";
+	// arena is only constructed once the scene started
+	boost::interprocess::offset_ptr<peopleextractor_interface_sma::SharedMemoryArena> pi_arena = this->segment->find<peopleextractor_interface_sma::SharedMemoryArena>(peopleextractor_interface_sma::NAME_SHARED_MEMORY_ARENA).first;
+	if (pi_arena != NULL) {
+		std::cout << " arena slabs used: " << pi_arena->getUsed()
+			<< " free: " << pi_arena->getFree()
+			<< " high water: " << pi_arena->getHighWater()
+			<< " acknowledged generation: " << pi_arena->getAcknowledged();
+	}
+	std::cout << std::endl;
+
+	if (!ended) {
+		return true;
+	}
+	// a camera which stops delivering camera frames failed, a replay which runs out of them completed
+	if (capture_configuration->getSource() == CaptureConfiguration::SOURCE_CAMERA) {
+		std::cerr << "Peopleextractor camera stopped delivering camera frames" << std::endl;
+		return false;
+	}
+	std::cout << "Peopleextractor replay ended, shutting down" << std::endl;
+	this->running->running = false;
+	this->running->reboot_on_shutdown = false;
+	return true;
+}
+
+void ImovePeopleextractorManager::printPeopleSent() const {
+	std::cout << "Peopleextractor people frames dropped: " << this->si_people_queue->getDropped()
+		<< " people left out of full frames: " << this->people_left_out << std::endl;
+}
+
+void ImovePeopleextractorManager::preprocessThread(ImovePeopleextractorManager* imove_peopleextractor_manager) {
+	imove_peopleextractor_manager->preprocess();
+}
+
+void ImovePeopleextractorManager::detectThread(ImovePeopleextractorManager* imove_peopleextractor_manager) {
+	imove_peopleextractor_manager->detect();
+}
+
+void ImovePeopleextractorManager::identifyThread(ImovePeopleextractorManager* imove_peopleextractor_manager) {
+	imove_peopleextractor_manager->identify();
+}
+
+void ImovePeopleextractorManager::debugThread(ImovePeopleextractorManager* imove_peopleextractor_manager) {
+	imove_peopleextractor_manager->debug();
+}
+
+void ImovePeopleextractorManager::preprocess() {
+	CameraConfiguration* camera_configuration = this->calibration->getCameraConfiguration();
+	const bool grayscale = this->calibration->getPipelineConfiguration()->getIngestion() != PipelineConfiguration::INGESTION_BGR;
+
+	PipelineFrame frame;
+	while (this->queue_preprocess.pop(frame)) {
+		this->timing_preprocess.begin();
+		// resize once to the camera resolution, in grayscale when configured so every later stage handles a single channel
+		Ingestion::ingest(frame.frame_captured, frame.frame_camera, camera_configuration->getResolution(), grayscale);
+		this->si_trace_ring->record(frame.sequence, scene_interface_sma::TRACE_STAGE_RESIZE);
 
-		// extract people from camera frame
-		detectpeople_frame = frame_eliminatedprojection.clone();
-		people_camera = this->people_extractor->extractPeople(detectpeople_frame);
-		if (this->calibration->getDebugMode()) {
-			window_peopleextractor->drawFrame();
+		// debug projection frame
+		if (frame.debug) {
+			this->projection.createFrameProjectionFromFrameCamera(
+				frame.frame_projection,
+				frame.frame_camera
+			);
 		}
 
-		if (this->calibration->getDebugMode()) {
-			// draw detected people camera image
-			detectedpeople_camera_window->drawImage(frame_camera, people_camera);
+		// eliminate the projector frame displayed when the camera frame was captured
+		this->projection.eliminateProjectionFeedbackFromFrameCamera(frame.frame_eliminatedprojection, frame.frame_camera, frame.timestamp_capture);
+		this->si_trace_ring->record(frame.sequence, scene_interface_sma::TRACE_STAGE_ELIMINATE_PROJECTION);
+		this->timing_preprocess.end();
+		this->queue_detect.push(frame);
+	}
+	this->queue_detect.close();
+}
+
+void ImovePeopleextractorManager::detect() {
+	PipelineFrame frame;
+	while (this->queue_detect.pop(frame)) {
+		this->timing_detect.begin();
+		// detecting leaves the eliminated projection frame as is, so it is still shown without copying it
+		frame.locations = this->people_extractor->detectPeople(frame.frame_eliminatedprojection, frame.detection_scale, frame.learn);
+		this->si_trace_ring->record(frame.sequence, scene_interface_sma::TRACE_STAGE_DETECT, this->people_extractor->getTimestampDetected());
+		if (frame.debug) {
+			frame.frame_detected = this->people_extractor->getDebugFrame();
 		}
+		this->timing_detect.end();
+		this->queue_identify.push(frame);
+	}
+	this->queue_identify.close();
+}
+
+void ImovePeopleextractorManager::identify() {
+	PipelineFrame frame;
+	while (this->queue_identify.pop(frame)) {
+		this->timing_identify.begin();
+		// signal imove that people extracting makes progress
+		this->heartbeat->beat();
+		frame.people_camera = this->people_extractor->identifyPeople(frame.locations, frame.timestamp_capture);
+		this->si_trace_ring->record(frame.sequence, scene_interface_sma::TRACE_STAGE_MATCH, this->people_extractor->getTimestampMatched());
 
 		// change extrated people to projector location from camera location
-		const scene_interface::People people_projector = this->projection.createPeopleProjectorFromPeopleCamera(people_camera);
+		frame.people_projector = this->projection.createPeopleProjectorFromPeopleCamera(frame.people_camera);
+		this->si_trace_ring->record(frame.sequence, scene_interface_sma::TRACE_STAGE_PROJECT_PEOPLE);
 
-		// draw detected people projection image
-		if (this->calibration->getDebugMode()) {
-			detectedpeople_projection_window->drawImage(frame_projection, people_projector);
+		// send extracted people via shared memory to scene
+		this->sendExtractedpeople(frame.people_projector, frame.sequence, frame.timestamp_capture);
+
+		// lower or restore the quality by how long the camera frame took to get here
+		if (this->load_controller.update(scene_interface_sma::TraceRing::now() - frame.timestamp_capture)) {
+			this->printLoadLevel(frame.sequence);
 		}
 
-		// send extracted people via shared memory to scene
-		this->sendExtractedpeople(people_projector);
+		// record camera frame as captured together with its extracted people
+		if (this->recording_writer != NULL) {
+			this->recording_writer->write(frame.frame_captured, frame.timestamp_capture, frame.people_projector);
+		}
+		this->timing_identify.end();
+		if (frame.debug) {
+			this->queue_debug.push(frame);
+		}
+	}
+	this->queue_debug.close();
+}
+
+void ImovePeopleextractorManager::debug() {
+	// no debug windows, so no camera frames nor keys ever arrive
+	if (!this->calibration->getDebugMode()) {
+		PipelineFrame frame;
+		while (this->queue_debug.pop(frame)) {}
+		return;
+	}
+#ifdef __linux__
+	// lower the priority of only this thread, the other stages keep theirs
+	setpriority(PRIO_PROCESS, syscall(SYS_gettid), ImovePeopleextractorManager::NICE_DEBUG);
+#endif
+
+	// debug windows, created on this thread as only this thread draws them
+	float width_resolution_projector = this->calibration->getProjectorConfiguration()->getResolution().width;
+	PeopleextractorWindow window_peopleextractor(
+		cv::Point2i(width_resolution_projector, 0),
+		cv::Size(600, 600),
+		this->people_extractor
+	);
+	DetectedPeopleCameraWindow detectedpeople_camera_window(
+		cv::Point2i(width_resolution_projector + 600, 0),
+		cv::Size(600, 600)
+	);
+	ImageWindow eliminatedprojection_camera_window(
+		"Eliminated projection camera frame",
+		cv::Point2i(width_resolution_projector, 600),
+		cv::Size(300, 300)
+	);
+	DetectedPeopleProjectionWindow detectedpeople_projection_window(
+		cv::Point2i(width_resolution_projector + 300, 600),
+		cv::Size(300, 300)
+	);
+
+	PipelineFrame frame;
+	while (this->queue_debug.pop(frame)) {
+		this->timing_debug.begin();
+		// people are drawn in color on snapshots, as the camera frames may still be shared with the stages
+		cv::Mat frame_camera;
+		cv::Mat frame_projection;
+		if (frame.frame_camera.channels() == 1) {
+			cv::cvtColor(frame.frame_camera, frame_camera, cv::COLOR_GRAY2BGR);
+			cv::cvtColor(frame.frame_projection, frame_projection, cv::COLOR_GRAY2BGR);
+		} else {
+			frame_camera = frame.frame_camera.clone();
+			frame_projection = frame.frame_projection.clone();
+		}
+		eliminatedprojection_camera_window.drawImage(frame.frame_eliminatedprojection);
+		// detector result of this camera frame, not the latest of the people extractor which is already detecting further
+		window_peopleextractor.drawImage(frame.frame_detected);
+		// draw detected people camera image
+		detectedpeople_camera_window.drawImage(frame_camera, frame.people_camera);
+		// draw detected people projection image
+		detectedpeople_projection_window.drawImage(frame_projection, frame.people_projector);
 
 		// shutdown on keypress
 		if (cv::waitKey(1) != OpenCVUtil::NOKEY_ANYKEY) {
 			this->running->running = false;
 			this->running->reboot_on_shutdown = false;
 		}
+		this->timing_debug.end();
 	}
+}
 
-	// safe release video capture
-	video_capture.release();
+void ImovePeopleextractorManager::printStage(const StageTiming& timing, const StageQueue<PipelineFrame>* queue) {
+	std::cout << "Peopleextractor stage " << timing.getName()
+		<< " frames: " << timing.getFrames()
+		<< " average: " << timing.getAverageMilliseconds() << "ms"
+		<< " maximum: " << timing.getMaximumMilliseconds() << "ms";
+	if (queue != NULL) {
+		std::cout << " dropped: " << queue->getDropped() << " of " << queue->getPushed();
+	}
+	std::cout << std::endl;
 }
 
-void ImovePeopleextractorManager::sendExtractedpeople(const scene_interface::People extractedpeople) {
-	//Initialize shared memory STL-compatible allocator
-	scene_interface_sma::PeopleSMA people_sma = scene_interface_sma::PeopleSMA((*this->segment).get_segment_manager());
+void ImovePeopleextractorManager::printLoadLevel(unsigned long long sequence) const {
+	const unsigned int level = this->load_controller.getLevel();
+	const LoadController::Level& settings = LoadController::getSettings(level);
+	std::cout << "Peopleextractor load level: " << level
+		<< " frame: " << sequence
+		<< " average: " << this->load_controller.getAverageMilliseconds() << "ms"
+		<< " detection scale: " << settings.detection_scale
+		<< " learning every: " << settings.frames_learn
+		<< " keeping every: " << settings.frames_keep << std::endl;
+}
 
-	// create shared memory vector of extracted people
-  boost::interprocess::offset_ptr<scene_interface_sma::People> si_people = this->segment->construct<scene_interface_sma::People>(boost::interprocess::anonymous_instance)(people_sma);
+FrameSource* ImovePeopleextractorManager::createFrameSource() const {
+	CaptureConfiguration* capture_configuration = this->calibration->getCaptureConfiguration();
+	if (capture_configuration->getSource() == CaptureConfiguration::SOURCE_REPLAY_FRAMES) {
+		return new ReplayFrameSource(capture_configuration->getReplayFile(), capture_configuration->getReplayRealtime());
+	}
+	if (capture_configuration->getSource() == CaptureConfiguration::SOURCE_SYNTHETIC) {
+		CameraConfiguration* camera_configuration = this->calibration->getCameraConfiguration();
+		return new SyntheticFrameSource(
+			camera_configuration->getResolution(),
+			camera_configuration->getMeter(),
+			capture_configuration->getSyntheticPeople(),
+			capture_configuration->getSyntheticFps(),
+			true,
+			capture_configuration->getSyntheticFloorContrast(),
+			capture_configuration->getSyntheticPattern(),
+			SEED_SYNTHETIC
+		);
+	}
+	return new CameraFrameSource(
+		this->calibration->getCameraConfiguration()->getDeviceid(),
+		this->calibration->getPipelineConfiguration()->getIngestion() == PipelineConfiguration::INGESTION_GRAY_YUV
+	);
+}
+
+void ImovePeopleextractorManager::replayExtractedpeople() {
+	CaptureConfiguration* capture_configuration = this->calibration->getCaptureConfiguration();
+	ReplayFrameSource replay(capture_configuration->getReplayFile(), capture_configuration->getReplayRealtime());
+
+	cv::Mat frame_replayed;
+	unsigned long long replayed = 0;
+	while (this->running->running && replay.read(frame_replayed)) {
+		this->heartbeat->beat();
+		// as fast as possible, but never faster than the scene pops so no recorded frame is dropped
+		while (!capture_configuration->getReplayRealtime() && !this->calibration->getPeopleSnapshotMode()
+			&& this->running->running && this->si_people_queue->size() >= scene_interface_sma::CAPACITY_PEOPLE_QUEUE) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		const unsigned long long sequence = this->si_frame_sequence->next();
+		++replayed;
+		// recorded capture time on the clock of the scene, so the scene extrapolates the people as when they were recorded
+		const long long timestamp_capture = replay.getTimestampCapture();
+		this->si_trace_ring->record(sequence, scene_interface_sma::TRACE_STAGE_CAPTURE, timestamp_capture);
+		// send recorded extracted people via shared memory to scene
+		this->sendExtractedpeople(replay.getPeople(), sequence, timestamp_capture);
+	}
+	std::cout << "Replayed " << replayed << " frames of extracted people" << std::endl;
+	this->printPeopleSent();
+	// the replay ran out of frames, so the application completed instead of restarting the replay
+	if (this->running->running) {
+		this->running->running = false;
+		this->running->reboot_on_shutdown = false;
+	}
+}
 
+void ImovePeopleextractorManager::sendExtractedpeople(const scene_interface::People extractedpeople, unsigned long long sequence, long long timestamp_capture) {
+	if (this->calibration->getPeopleSnapshotMode()) {
+		// overwrite latest shared memory frame of extracted people, scene always reads the newest
+		scene_interface_sma::People& si_people = this->si_people_snapshot->beginWrite();
+		this->countPeopleLeftOut(ImovePeopleextractorManager::copyExtractedpeople(si_people, extractedpeople));
+		si_people.setFrame(sequence, timestamp_capture);
+		this->si_people_snapshot->endWrite();
+		this->si_trace_ring->record(sequence, scene_interface_sma::TRACE_STAGE_PUBLISH);
+	} else {
+		// get preallocated shared memory frame of extracted people
+		scene_interface_sma::People* si_people = this->si_people_queue->back();
+		if (si_people == NULL) {
+			// scene is not keeping up, drop frame instead of growing the queue
+			this->si_people_queue->drop();
+			return;
+		}
+		this->countPeopleLeftOut(ImovePeopleextractorManager::copyExtractedpeople(*si_people, extractedpeople));
+		si_people->setFrame(sequence, timestamp_capture);
+
+		// publish shared memory frame of extracted people on the queue
+		this->si_people_queue->push();
+		this->si_trace_ring->record(sequence, scene_interface_sma::TRACE_STAGE_PUBLISH);
+	}
+}
+
+unsigned int ImovePeopleextractorManager::copyExtractedpeople(scene_interface_sma::People& si_people, const scene_interface::People& extractedpeople) {
+	si_people.clear();
+
+	unsigned int left_out = 0;
 	for (scene_interface::Person person : extractedpeople) {
-		//Initialize shared memory STL-compatible allocator
-		scene_interface_sma::LocationsSMA locations_sma(this->segment->get_segment_manager());
 		scene_interface::Location location = person.getLocation();
-		// create shared memory vector of locations
-		boost::interprocess::offset_ptr<scene_interface_sma::Locations> locations = this->segment->construct<scene_interface_sma::Locations>(boost::interprocess::anonymous_instance)(locations_sma);
-		// put shared memory allocated location in shared memory allocated vector of locations
-		locations->push_back(
-			this->segment->construct<scene_interface_sma::Location>(boost::interprocess::anonymous_instance)(location.getX(), location.getY())
-		);
 
 		// create shared memory allocated person type from person type
 		scene_interface_sma::Person::PersonType person_type;
@@ -166,54 +505,60 @@ void ImovePeopleextractorManager::sendExtractedpeople(const scene_interface::Peo
 				movement_type = scene_interface_sma::Person::MovementType::Moving;
 				break;
 		}
-		// put shared memory allocated extracted person in shared memory allocated vector of extracted people
-		si_people->push_back(
-			this->segment->construct<scene_interface_sma::Person>(boost::interprocess::anonymous_instance)(
-				locations,
+		scene_interface::Location velocity = person.getVelocity();
+		// copy extracted person in shared memory frame of extracted people; people which do not fit are left out
+		if (!si_people.push_back(
+			scene_interface_sma::Person(
+				scene_interface_sma::Location(location.getX(), location.getY()),
 				person_type,
 				movement_type,
-				person.getId()
+				person.getId(),
+				scene_interface_sma::Location(velocity.getX(), velocity.getY())
 			)
-		);
+		)) {
+			++left_out;
+		}
 	}
+	return left_out;
+}
 
-	// push shared memory allocated extracted people on the queue
-	this->si_people_queue->push_back(
-		si_people
-	);
+void ImovePeopleextractorManager::countPeopleLeftOut(unsigned int left_out) {
+	if (left_out == 0) {
+		return;
+	}
+	if (this->people_left_out == 0) {
+		std::cerr << "Peopleextractor extracted more than " << scene_interface_sma::MAXIMUM_PEOPLE << " people, leaving out the rest" << std::endl;
+	}
+	this->people_left_out += left_out;
 }
 
 void ImovePeopleextractorManager::receiveSceneFrameAndFeedProjection() {
-	boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeQueue>& pi_sceneframe_queue = this->pi_sceneframe_queue;
+	boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeBuffer>& pi_sceneframe_buffer = this->pi_sceneframe_buffer;
 	boost::interprocess::offset_ptr<Running>& running = this->running;
-	const float factor_resize_capture_scene = this->calibration->getProjectioneliminationConfiguration()->getFactorResizeCaptureScene();
 	Projection& projection = this->projection;
 
-	while (running->running) {
-		// when scene frame available
-		if (!pi_sceneframe_queue->empty()) {
-			// pop all frames which we are not able to process so fast
-			while (pi_sceneframe_queue->size() > 2) {
-				pi_sceneframe_queue->pop_front();
-			}
-			// convert from sma to opencv mat
-			boost::interprocess::offset_ptr<peopleextractor_interface_sma::Image> pi_sceneframe = pi_sceneframe_queue->front();
-			cv::Mat cv_sceneframe = cv::Mat::zeros(pi_sceneframe->getHeight(), pi_sceneframe->getWidth(), CV_8UC3);
-			for (unsigned int x = 0; x < pi_sceneframe->getWidth(); ++x) {
-				for (unsigned int y = 0; y < pi_sceneframe->getHeight(); ++y) {
-					cv_sceneframe.at<cv::Vec3b>(y, x) = cv::Vec3b(
-						pi_sceneframe->getBlue(x, y),
-						pi_sceneframe->getGreen(x, y),
-						pi_sceneframe->getRed(x, y)
-					);
-				}
-			}
-			cv::Mat cv_sceneframe_resize;
-			cv::resize(cv_sceneframe, cv_sceneframe_resize, cv::Size(pi_sceneframe->getWidth() * factor_resize_capture_scene, pi_sceneframe->getHeight() * factor_resize_capture_scene));
-			// feed opencv image to calibration
-			projection.feedFrameProjector(cv_sceneframe_resize);
-			// remove from queue
-			pi_sceneframe_queue->pop_front();
+	// scene frame converted like the camera frames are ingested, copied into the projection so its buffer is reused
+	const bool grayscale = this->calibration->getPipelineConfiguration()->getIngestion() != PipelineConfiguration::INGESTION_BGR;
+	cv::Mat cv_sceneframe_converted;
+	while (running->running && this->receiving_sceneframes) {
+		// sleep until latest scene frame available, older ones are skipped by the buffer; wake up regularly to check for shutdown
+		if (pi_sceneframe_buffer->waitAndAcquire(ImovePeopleextractorManager::TIMEOUT_WAIT_SCENEFRAME_MS)) {
+			const peopleextractor_interface_sma::Image& pi_sceneframe = pi_sceneframe_buffer->front();
+			// wrap shared memory RGBA pixels as opencv mat without copying
+			const cv::Mat cv_sceneframe(
+				pi_sceneframe.getHeight(),
+				pi_sceneframe.getWidth(),
+				CV_8UC4,
+				const_cast<unsigned char*>(pi_sceneframe.getData()),
+				pi_sceneframe.getStride()
+			);
+			cv::cvtColor(cv_sceneframe, cv_sceneframe_converted, grayscale ? cv::COLOR_RGBA2GRAY : cv::COLOR_RGBA2BGR);
+			// feed opencv image to calibration with the time the scene displayed it
+			projection.feedFrameProjector(cv_sceneframe_converted, pi_sceneframe.getTimestampDisplay());
 		}
 	}
+
+	std::cout << "Scene frame wakeups: " << pi_sceneframe_buffer->getWakeups()
+		<< " average latency: " << pi_sceneframe_buffer->getWakeupLatencyAverage() / 1000 << "us"
+		<< " maximum latency: " << pi_sceneframe_buffer->getWakeupLatencyMaximum() / 1000 << "us" << std::endl;
 }
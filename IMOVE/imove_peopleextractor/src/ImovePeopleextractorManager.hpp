@@ -1,17 +1,38 @@
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/offset_ptr.hpp>
+#include <atomic>
 #include <vector>
 
 #include "../../util/src/configuration/ImoveConfiguration.hpp"
 #include "../../util/src/Projection.hpp"
 #include "ImageProcessing/PeopleExtractor.h"
+#include "Capture/FrameSource.hpp"
+#include "Capture/Recording.hpp"
+#include "Pipeline/FramePool.hpp"
+#include "Pipeline/LoadController.hpp"
+#include "Pipeline/PipelineFrame.hpp"
+#include "Pipeline/StageQueue.hpp"
+#include "Pipeline/StageTiming.hpp"
 #include "../../scene_interface_sma/src/PeopleQueue.hpp"
-#include "../../peopleextractor_interface_sma/src/SceneframeQueue.hpp"
+#include "../../scene_interface_sma/src/PeopleSnapshot.hpp"
+#include "../../scene_interface_sma/src/TraceRing.hpp"
+#include "../../scene_interface_sma/src/FrameSequence.hpp"
+#include "../../peopleextractor_interface_sma/src/SceneframeBuffer.hpp"
 #include "../../imove/src/Running.hpp"
+#include "../../imove/src/Heartbeat.hpp"
 
 // Setups people extractor and Scene, can let the Scene run using constant input of people extractor
 class ImovePeopleextractorManager {
 	public:
+		// Maximum milliseconds to sleep waiting on a scene frame before checking whether still running
+		static const unsigned int TIMEOUT_WAIT_SCENEFRAME_MS = 100;
+		// Seed of the synthetic crowd, fixed so runs generate the same camera frames
+		static const unsigned int SEED_SYNTHETIC = 1;
+		// Camera frames after which the frame pool holds every buffer in flight and should not allocate anymore
+		static const unsigned int FRAMES_WARMUP_POOL = 100;
+		// Niceness of the debug thread, so drawing debug windows yields to extracting people
+		static const int NICE_DEBUG = 10;
+
 		/**
 		 * Setup people extractor and communicate to Scene.
 		 * 
@@ -19,10 +40,17 @@ class ImovePeopleextractorManager {
 		 **/
 		ImovePeopleextractorManager(ImoveConfiguration* calibration);
 
-		// Run the people extractor and Scene frame by frame
-		void run();
+		/**
+		 * Run the people extractor and Scene frame by frame, each stage of the people extractor on its own thread.
+		 * Shuts down the application once a replay runs out of frames.
+		 *
+		 * @return false when the camera stopped delivering camera frames, so the people extractor should be restarted
+		 **/
+		bool run();
 
 	protected:
+		// pool all frames of the pipeline are allocated from, first so it outlives every frame of the other members
+		FramePool frame_pool;
 		ImoveConfiguration* calibration;
 		Projection projection;
 		PeopleExtractor* people_extractor;
@@ -31,17 +59,111 @@ class ImovePeopleextractorManager {
 		boost::interprocess::managed_shared_memory* segment;
 		// shared memory extracted people queue
 		boost::interprocess::offset_ptr<scene_interface_sma::PeopleQueue> si_people_queue;
-		// shared memory people extractor scene frame queue
-		boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeQueue> pi_sceneframe_queue;
+		// shared memory latest extracted people snapshot
+		boost::interprocess::offset_ptr<scene_interface_sma::PeopleSnapshot> si_people_snapshot;
+		// shared memory trace of camera frames through the pipeline
+		boost::interprocess::offset_ptr<scene_interface_sma::TraceRing> si_trace_ring;
+		// shared memory sequence of camera frames, continued by a restarted people extractor
+		boost::interprocess::offset_ptr<scene_interface_sma::FrameSequence> si_frame_sequence;
+		// shared memory people extractor scene frame buffer
+		boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeBuffer> pi_sceneframe_buffer;
 		// shared memory running all processes
 		boost::interprocess::offset_ptr<Running> running;
+		// shared memory heartbeat watched by imove
+		boost::interprocess::offset_ptr<Heartbeat> heartbeat;
+
+		// queues of camera frames into each stage after capturing
+		StageQueue<PipelineFrame> queue_preprocess;
+		StageQueue<PipelineFrame> queue_detect;
+		StageQueue<PipelineFrame> queue_identify;
+		StageQueue<PipelineFrame> queue_debug;
+		// time spent per camera frame by each stage
+		StageTiming timing_capture;
+		StageTiming timing_preprocess;
+		StageTiming timing_detect;
+		StageTiming timing_identify;
+		StageTiming timing_debug;
+		// quality of extracting people lowered while camera frames take longer than the budget
+		LoadController load_controller;
+		// camera frames dropped on capture by the load controller
+		unsigned long long frames_dropped_load;
+		// extracted people left out of full shared memory people frames, only written by the thread sending them
+		unsigned long long people_left_out;
+		// recording of camera frames and extracted people, NULL when not recording
+		RecordingWriter* recording_writer;
+		// whether camera frames are still captured, so scene frames are still received to eliminate the projection from them
+		std::atomic<bool> receiving_sceneframes;
+
+		// Resize camera frames and eliminate the projection from them, till the preprocess queue is closed
+		void preprocess();
+
+		// Detect people in camera frames, till the detect queue is closed
+		void detect();
+
+		// Identify detected people, send them to the scene and record them, till the identify queue is closed
+		void identify();
+
+		// Draw debug windows and shutdown on keypress at a low priority, till the debug queue is closed
+		void debug();
+
+		// thread functions of the stages
+		static void preprocessThread(ImovePeopleextractorManager* imove_peopleextractor_manager);
+		static void detectThread(ImovePeopleextractorManager* imove_peopleextractor_manager);
+		static void identifyThread(ImovePeopleextractorManager* imove_peopleextractor_manager);
+		static void debugThread(ImovePeopleextractorManager* imove_peopleextractor_manager);
+
+		/**
+		 * Print the timing of a stage and the camera frames dropped on the queue into it.
+		 *
+		 * @param timing The timing of the stage
+		 * @param queue  The queue into the stage, NULL when the stage has no queue
+		 **/
+		static void printStage(const StageTiming& timing, const StageQueue<PipelineFrame>* queue);
+
+		/**
+		 * Print the level the load controller changed to.
+		 *
+		 * @param sequence The camera frame whose processing time changed the level
+		 **/
+		void printLoadLevel(unsigned long long sequence) const;
 		
 		/**
-		 * Push extractedpeople on shared memory query for scene to pop.
+		 * Push extractedpeople on shared memory query for scene to pop or publish as latest snapshot.
 		 * 
-		 * @param people Extracted people for scene input
+		 * @param people            Extracted people for scene input
+		 * @param sequence          The increasing number of the camera frame the people are extracted from
+		 * @param timestamp_capture The steady clock time in nanoseconds on which the camera frame is captured
+		 **/
+		void sendExtractedpeople(scene_interface::People people, unsigned long long sequence, long long timestamp_capture);
+
+		/**
+		 * Create the source of camera frames based on the capture configuration.
+		 **/
+		FrameSource* createFrameSource() const;
+
+		/**
+		 * Send recorded extracted people to the scene without extracting people, till the recording ends and shuts down the application.
 		 **/
-		void sendExtractedpeople(scene_interface::People people);
+		void replayExtractedpeople();
+
+		/**
+		 * Copy extracted people in shared memory people frame, people which do not fit in the frame are left out.
+		 *
+		 * @param si_people      The output shared memory people frame
+		 * @param extractedpeople The extracted people
+		 * @return the amount of people left out
+		 **/
+		static unsigned int copyExtractedpeople(scene_interface_sma::People& si_people, const scene_interface::People& extractedpeople);
+
+		/**
+		 * Count the people left out of a full shared memory people frame, warning the first time.
+		 *
+		 * @param left_out The amount of people left out of the frame
+		 **/
+		void countPeopleLeftOut(unsigned int left_out);
+
+		// Print the people frames the scene did not keep up with and the people left out of full people frames
+		void printPeopleSent() const;
 
 		// Receive scene frame and feed projection for later projection subtraction
 		void receiveSceneFrameAndFeedProjection();
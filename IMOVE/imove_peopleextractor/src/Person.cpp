@@ -1,10 +1,7 @@
-#include <list>
-
 #include "Person.h"
 
 
-Person::Person(const Vector2& location, const PersonType person_type) : location(location), person_type(person_type) {
-    previousLocations = std::list<Vector2>();
+Person::Person(const KalmanTrack& track, const PersonType person_type) : track(track), person_type(person_type) {
     id = count;
     count++;
     movement_type = Person::MovementType::Moving;
@@ -13,16 +10,24 @@ Person::Person(const Vector2& location, const PersonType person_type) : location
 /*--------------------
  * Getters and setters
  * -----------------*/
-Vector2 Person::getLocation() {
-    return location;
+Vector2 Person::getLocation() const {
+    return track.getLocation();
 }
 
 void Person::setLocation(const Vector2& location) {
-    if(previousLocations.size() > 10){
-        previousLocations.pop_front();
-    }
-    previousLocations.push_back(this->location);
-    this->location = location;
+    track.setLocation(location);
+}
+
+Vector2 Person::getVelocity() const {
+    return track.getVelocity();
+}
+
+KalmanTrack& Person::getTrack() {
+    return track;
+}
+
+const KalmanTrack& Person::getTrack() const {
+    return track;
 }
 
 unsigned int Person::count = 0;
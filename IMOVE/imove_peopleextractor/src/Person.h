@@ -1,16 +1,13 @@
 #ifndef PERSON_H
 #define PERSON_H
 
-#include <list>
 #include "../../util/src/Vector2.h"
+#include "ImageProcessing/Identifier/KalmanTrack.h"
 
 class Person {
  private:
-    // List of previous locations
-    std::list<Vector2> previousLocations;
-
-    // Current location
-    Vector2 location;
+    // Filtered location and velocity
+    KalmanTrack track;
 
     // Id
     unsigned int id;
@@ -38,11 +35,15 @@ class Person {
     // Moving or standing still
 		MovementType movement_type;
 
-		Person(const Vector2& location, const PersonType type);
+		Person(const KalmanTrack& track, const PersonType type);
 
     //Getters and setters
-    Vector2 getLocation();
+    Vector2 getLocation() const;
 		void setLocation(const Vector2& location);
+    // Velocity in pixels per second
+    Vector2 getVelocity() const;
+    KalmanTrack& getTrack();
+    const KalmanTrack& getTrack() const;
     unsigned int getId();
 	  unsigned int getNotMovedCount();
 
@@ -0,0 +1,141 @@
+#include <stdlib.h>
+#include <new>
+
+#include "FramePool.hpp"
+
+FramePool::FramePool() :
+	acquisition_trim(FramePool::ACQUISITIONS_UNUSED),
+	allocations(0),
+	frees(0),
+	acquisitions(0),
+	bytes(0)
+{}
+
+FramePool::~FramePool() {
+	for (std::map<std::size_t, Released>::iterator size = this->released.begin(); size != this->released.end(); ++size) {
+		FramePool::freeBuffers(size->second.buffers);
+	}
+}
+
+void FramePool::freeBuffers(const std::vector<Buffer>& buffers) {
+	for (const Buffer& buffer : buffers) {
+		free(buffer.pixels);
+		delete buffer.data;
+	}
+}
+
+cv::UMatData* FramePool::allocate(int dims, const int* sizes, int type, void* data, size_t* step, int flags, cv::UMatUsageFlags usage_flags) const {
+	// continuous bytes of the frame, like the standard allocator lays them out
+	std::size_t size = CV_ELEM_SIZE(type);
+	for (int i = dims - 1; i >= 0; --i) {
+		size *= sizes[i];
+	}
+	// frames wrapping memory of someone else and small matrices are not pooled
+	if (data != NULL || size < FramePool::MINIMUM_BYTES_POOLED) {
+		return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usage_flags);
+	}
+	if (step != NULL) {
+		std::size_t step_dimension = CV_ELEM_SIZE(type);
+		for (int i = dims - 1; i >= 0; --i) {
+			step[i] = step_dimension;
+			step_dimension *= sizes[i];
+		}
+	}
+
+	Buffer buffer;
+	std::vector<Buffer> unused;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		++this->acquisitions;
+		Released& released_size = this->released[size];
+		released_size.acquisition_last = this->acquisitions;
+		if (released_size.buffers.empty()) {
+			buffer.data = NULL;
+		} else {
+			buffer = released_size.buffers.back();
+			released_size.buffers.pop_back();
+		}
+		// take the released buffers of sizes no longer acquired, every so many acquisitions
+		if (this->acquisitions >= this->acquisition_trim) {
+			this->acquisition_trim = this->acquisitions + FramePool::ACQUISITIONS_UNUSED;
+			for (std::map<std::size_t, Released>::iterator size_unused = this->released.begin(); size_unused != this->released.end();) {
+				if (this->acquisitions - size_unused->second.acquisition_last < FramePool::ACQUISITIONS_UNUSED) {
+					++size_unused;
+					continue;
+				}
+				unused.insert(unused.end(), size_unused->second.buffers.begin(), size_unused->second.buffers.end());
+				this->frees += size_unused->second.buffers.size();
+				this->bytes -= size_unused->second.buffers.size() * size_unused->first;
+				this->released.erase(size_unused++);
+			}
+		}
+	}
+	FramePool::freeBuffers(unused);
+	if (buffer.data == NULL) {
+		// new page aligned buffer, rounded up to whole pages
+		void* pixels;
+		if (posix_memalign(&pixels, FramePool::BYTES_PAGE, (size + FramePool::BYTES_PAGE - 1) / FramePool::BYTES_PAGE * FramePool::BYTES_PAGE) != 0) {
+			throw std::bad_alloc();
+		}
+		buffer.pixels = static_cast<unsigned char*>(pixels);
+		buffer.data = new cv::UMatData(this);
+		std::lock_guard<std::mutex> lock(this->mutex);
+		++this->allocations;
+		this->bytes += size;
+	} else {
+		// reset the bookkeeping of the released buffer in place
+		buffer.data->~UMatData();
+		new (buffer.data) cv::UMatData(this);
+	}
+	buffer.data->data = buffer.data->origdata = buffer.pixels;
+	buffer.data->size = size;
+	return buffer.data;
+}
+
+bool FramePool::allocate(cv::UMatData* data, int, cv::UMatUsageFlags) const {
+	return data != NULL;
+}
+
+void FramePool::deallocate(cv::UMatData* data) const {
+	if (data == NULL) {
+		return;
+	}
+	CV_Assert(data->refcount == 0 && data->urefcount == 0);
+	// keep the buffer for the next frame of the same size
+	Buffer buffer;
+	buffer.data = data;
+	buffer.pixels = data->origdata;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		// the size is kept until it has been unused for a while, so acquiring it again finds the entry
+		std::map<std::size_t, Released>::iterator released_size = this->released.find(data->size);
+		if (released_size != this->released.end() && released_size->second.buffers.size() < FramePool::MAXIMUM_RELEASED_PER_SIZE) {
+			released_size->second.buffers.push_back(buffer);
+			return;
+		}
+		++this->frees;
+		this->bytes -= data->size;
+	}
+	// more buffers of this size are released than ever in flight, or the size is trimmed while the buffer was in use
+	FramePool::freeBuffers(std::vector<Buffer>(1, buffer));
+}
+
+unsigned long long FramePool::getAllocations() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->allocations;
+}
+
+unsigned long long FramePool::getAcquisitions() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->acquisitions;
+}
+
+unsigned long long FramePool::getFrees() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->frees;
+}
+
+std::size_t FramePool::getBytes() const {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->bytes;
+}
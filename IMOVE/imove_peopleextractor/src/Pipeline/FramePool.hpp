@@ -0,0 +1,69 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_FRAMEPOOL_H
+#define IMOVE_PEOPLEEXTRACTOR_FRAMEPOOL_H
+
+#include <opencv2/opencv.hpp>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// Allocator of page aligned camera frame buffers which are kept by size when released and handed out again, so camera frames of the same size stop allocating once every buffer in flight exists
+class FramePool : public cv::MatAllocator {
+	public:
+		// Bytes of a page, to which buffers are aligned and rounded up
+		static const std::size_t BYTES_PAGE = 4096;
+		// Buffers smaller than a page are left to the standard allocator, they are no camera frames
+		static const std::size_t MINIMUM_BYTES_POOLED = BYTES_PAGE;
+		// Released buffers kept per size, more than every camera frame in flight; further released buffers are freed
+		static const std::size_t MAXIMUM_RELEASED_PER_SIZE = 16;
+		// Acquisitions after which the released buffers of a size not acquired in between are freed, such as sizes of an old detection scale
+		static const unsigned long long ACQUISITIONS_UNUSED = 1000;
+
+		FramePool();
+
+		// Frees the released buffers, buffers still in use must be released before
+		~FramePool();
+
+		cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step, int flags, cv::UMatUsageFlags usage_flags) const;
+		bool allocate(cv::UMatData* data, int access_flags, cv::UMatUsageFlags usage_flags) const;
+		void deallocate(cv::UMatData* data) const;
+
+		// Gets the amount of buffers allocated from the heap, which stops growing in the steady state; only counts the buffers of the pool, not other allocations of the pipeline
+		unsigned long long getAllocations() const;
+
+		// Gets the amount of buffers handed out, by reusing a released buffer or allocating a new one
+		unsigned long long getAcquisitions() const;
+
+		// Gets the amount of buffers freed again, as more than the maximum of their size are released or their size is unused
+		unsigned long long getFrees() const;
+
+		// Gets the amount of bytes of all allocated buffers not freed yet
+		std::size_t getBytes() const;
+
+	private:
+		// Buffer with the opencv bookkeeping of it, which is kept together with it
+		struct Buffer {
+			cv::UMatData* data;
+			unsigned char* pixels;
+		};
+
+		// Frees buffers, outside of the lock
+		static void freeBuffers(const std::vector<Buffer>& buffers);
+
+		// Released buffers of a size and the acquisition on which the size is last acquired
+		struct Released {
+			std::vector<Buffer> buffers;
+			unsigned long long acquisition_last;
+		};
+
+		mutable std::mutex mutex;
+		// released buffers by their size in bytes
+		mutable std::map<std::size_t, Released> released;
+		// acquisition on which sizes are next checked for being unused
+		mutable unsigned long long acquisition_trim;
+		mutable unsigned long long allocations;
+		mutable unsigned long long frees;
+		mutable unsigned long long acquisitions;
+		mutable std::size_t bytes;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_FRAMEPOOL_H
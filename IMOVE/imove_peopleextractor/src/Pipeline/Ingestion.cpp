@@ -0,0 +1,131 @@
+#include <algorithm>
+
+#include "Ingestion.hpp"
+
+// Fixed point bits of the luma weights, the same as cv::cvtColor uses
+const int BITS_LUMA = 14;
+// Luma weights of blue, green and red in fixed point, which add up to one
+const unsigned int WEIGHT_BLUE = 1868;
+const unsigned int WEIGHT_GREEN = 9617;
+const unsigned int WEIGHT_RED = 4899;
+// Largest factor camera frames shrink by in one pass, so the sum of the luma of a block fits in 32 bits
+const int FACTOR_SHRINK_MAXIMUM = 8;
+// Rows of the camera frame converted by one core, small enough to keep the captured rows in cache
+const int ROWS_STRIP = 16;
+// Widest camera row whose sums are kept on the stack, wider rows allocate them
+const std::size_t COLS_SUMS_STACK = 4096;
+
+/**
+ * Gets the integer factor by which a size shrinks to another in both directions, 0 when it does not.
+ *
+ * @param size_from The size which shrinks
+ * @param size_to   The size it shrinks to
+ **/
+static int getFactorShrink(const cv::Size& size_from, const cv::Size& size_to) {
+	if (size_to.width <= 0 || size_to.height <= 0 || size_from.width % size_to.width != 0) {
+		return 0;
+	}
+	const int factor = size_from.width / size_to.width;
+	return size_from.height == size_to.height * factor ? factor : 0;
+}
+
+// Averages blocks of captured pixels into grayscale camera pixels, strips of camera rows on every core
+class ShrinkToGray : public cv::ParallelLoopBody {
+	public:
+		ShrinkToGray(const cv::Mat& frame_captured, int factor, cv::Mat& frame_camera) :
+			frame_captured(frame_captured),
+			factor(factor),
+			frame_camera(frame_camera)
+		{}
+
+		void operator()(const cv::Range& strips) const {
+			const int channels = this->frame_captured.channels();
+			const int cols = this->frame_camera.cols;
+			const unsigned int divisor = (this->factor * this->factor) << BITS_LUMA;
+			// summed luma of every block in the camera row, in fixed point, on the stack so converting allocates nothing
+			cv::AutoBuffer<unsigned int, COLS_SUMS_STACK> buffer_sums(cols);
+			unsigned int* sums = buffer_sums;
+			for (int strip = strips.start; strip < strips.end; ++strip) {
+				const int row_end = std::min((strip + 1) * ROWS_STRIP, this->frame_camera.rows);
+				for (int y = strip * ROWS_STRIP; y < row_end; ++y) {
+					std::fill(sums, sums + cols, 0u);
+					for (int row_block = 0; row_block < this->factor; ++row_block) {
+						const unsigned char* row = this->frame_captured.ptr<unsigned char>(y * this->factor + row_block);
+						for (int x = 0; x < cols; ++x) {
+							const unsigned char* pixel = row + x * this->factor * channels;
+							unsigned int sum = 0;
+							for (int col_block = 0; col_block < this->factor; ++col_block, pixel += channels) {
+								if (channels == 3) {
+									sum += pixel[0] * WEIGHT_BLUE + pixel[1] * WEIGHT_GREEN + pixel[2] * WEIGHT_RED;
+								} else {
+									// luma is the first byte of every pixel of grayscale and of packed YUYV
+									sum += pixel[0] << BITS_LUMA;
+								}
+							}
+							sums[x] += sum;
+						}
+					}
+					unsigned char* row_camera = this->frame_camera.ptr<unsigned char>(y);
+					for (int x = 0; x < cols; ++x) {
+						row_camera[x] = static_cast<unsigned char>((sums[x] + divisor / 2) / divisor);
+					}
+				}
+			}
+		}
+
+	private:
+		const cv::Mat& frame_captured;
+		const int factor;
+		cv::Mat& frame_camera;
+};
+
+void Ingestion::ingest(const cv::Mat& frame_captured, cv::Mat& frame_camera, const cv::Size& resolution, bool grayscale) {
+	CV_Assert(frame_captured.depth() == CV_8U && frame_captured.channels() >= 1 && frame_captured.channels() <= 3);
+	const int channels = frame_captured.channels();
+	if (!grayscale) {
+		// color camera frames, resized like they always were
+		if (channels == 3) {
+			cv::resize(frame_captured, frame_camera, resolution);
+			return;
+		}
+		cv::Mat frame_bgr;
+		cv::cvtColor(frame_captured, frame_bgr, channels == 2 ? cv::COLOR_YUV2BGR_YUYV : cv::COLOR_GRAY2BGR);
+		cv::resize(frame_bgr, frame_camera, resolution);
+		return;
+	}
+
+	if (frame_captured.size() == resolution) {
+		if (channels == 1) {
+			// already what the pipeline works on, which only reads it
+			frame_camera = frame_captured;
+		} else if (channels == 2) {
+			cv::extractChannel(frame_captured, frame_camera, 0);
+		} else {
+			cv::cvtColor(frame_captured, frame_camera, cv::COLOR_BGR2GRAY);
+		}
+		return;
+	}
+
+	// shrinking by a whole factor, like from a camera capturing twice the camera resolution, converts and averages every block in one pass
+	const int factor = getFactorShrink(frame_captured.size(), resolution);
+	if (factor > 1 && factor <= FACTOR_SHRINK_MAXIMUM) {
+		if (frame_camera.data == frame_captured.data) {
+			frame_camera.release();
+		}
+		frame_camera.create(resolution, CV_8UC1);
+		const int strips = (resolution.height + ROWS_STRIP - 1) / ROWS_STRIP;
+		cv::parallel_for_(cv::Range(0, strips), ShrinkToGray(frame_captured, factor, frame_camera));
+		return;
+	}
+
+	// other sizes convert first, so only one channel is resized
+	cv::Mat frame_gray;
+	if (channels == 1) {
+		frame_gray = frame_captured;
+	} else if (channels == 2) {
+		cv::extractChannel(frame_captured, frame_gray, 0);
+	} else {
+		cv::cvtColor(frame_captured, frame_gray, cv::COLOR_BGR2GRAY);
+	}
+	cv::resize(frame_gray, frame_camera, resolution);
+}
@@ -0,0 +1,21 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_INGESTION_H
+#define IMOVE_PEOPLEEXTRACTOR_INGESTION_H
+
+#include <opencv2/opencv.hpp>
+
+// Converts captured camera frames to the camera frames of the camera resolution the rest of the pipeline works on
+class Ingestion {
+	public:
+		/**
+		 * Resize a captured camera frame to the camera resolution, converting it to grayscale in the same pass over the captured pixels if asked.
+		 * Grayscale is taken as is from the luma of packed YUYV camera frames, which are given as 2 channels of luma and alternating chroma.
+		 *
+		 * @param frame_captured The captured camera frame, grayscale, packed YUYV or BGR
+		 * @param frame_camera   The camera frame of the camera resolution, its buffer is reused when it has the right size and type
+		 * @param resolution     The camera resolution
+		 * @param grayscale      Whether to convert to grayscale instead of BGR
+		 **/
+		static void ingest(const cv::Mat& frame_captured, cv::Mat& frame_camera, const cv::Size& resolution, bool grayscale);
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_INGESTION_H
@@ -0,0 +1,91 @@
+#include "LoadController.hpp"
+
+namespace {
+
+// From full quality down: first the background model learns from every other camera frame, which is barely noticed, then people are detected in fewer pixels, and at last camera frames are dropped
+const LoadController::Level SETTINGS_LEVELS[LoadController::LEVELS] = {
+	{1.0f, 1, 1},
+	{1.0f, 2, 1},
+	{0.75f, 2, 1},
+	{0.5f, 2, 1},
+	{0.5f, 2, 2}
+};
+
+}
+
+LoadController::LoadController(long long nanoseconds_budget) :
+	nanoseconds_budget(nanoseconds_budget),
+	level(0),
+	nanoseconds_average(0),
+	frames_since_change(0),
+	frames_hold_restore(LoadController::FRAMES_HOLD_RESTORE),
+	restored(false),
+	changes(0),
+	level_maximum(0)
+{}
+
+bool LoadController::update(long long nanoseconds) {
+	// start the average at the first camera frame after a change, so it only measures the current level
+	if (this->frames_since_change == 0) {
+		this->nanoseconds_average = nanoseconds;
+	} else {
+		this->nanoseconds_average += LoadController::WEIGHT_AVERAGE * (nanoseconds - this->nanoseconds_average);
+	}
+	++this->frames_since_change;
+	if (this->nanoseconds_budget <= 0 || this->frames_since_change < LoadController::FRAMES_HOLD) {
+		return false;
+	}
+
+	// a restored level which holds long enough is settled, so the next restore waits the shortest hold again
+	if (this->restored && this->frames_since_change >= LoadController::FRAMES_HOLD_RESTORE_MAXIMUM) {
+		this->restored = false;
+		this->frames_hold_restore = LoadController::FRAMES_HOLD_RESTORE;
+	}
+
+	const unsigned int level_current = this->level;
+	unsigned int level_next = level_current;
+	if (this->nanoseconds_average > this->nanoseconds_budget && level_current + 1 < LoadController::LEVELS) {
+		level_next = level_current + 1;
+		// the load is right at a level boundary when a restored level is lowered again soon, so wait longer before the next restore
+		if (this->restored && this->frames_since_change < this->frames_hold_restore) {
+			this->frames_hold_restore *= 2;
+			if (this->frames_hold_restore > LoadController::FRAMES_HOLD_RESTORE_MAXIMUM) {
+				this->frames_hold_restore = LoadController::FRAMES_HOLD_RESTORE_MAXIMUM;
+			}
+		}
+		this->restored = false;
+	} else if (this->nanoseconds_average < LoadController::PART_BUDGET_RESTORE * this->nanoseconds_budget && level_current > 0 && this->frames_since_change >= this->frames_hold_restore) {
+		level_next = level_current - 1;
+		this->restored = true;
+	}
+	if (level_next == level_current) {
+		return false;
+	}
+	this->level = level_next;
+	this->frames_since_change = 0;
+	++this->changes;
+	if (level_next > this->level_maximum) {
+		this->level_maximum = level_next;
+	}
+	return true;
+}
+
+unsigned int LoadController::getLevel() const {
+	return this->level;
+}
+
+const LoadController::Level& LoadController::getSettings(unsigned int level) {
+	return SETTINGS_LEVELS[level < LoadController::LEVELS ? level : LoadController::LEVELS - 1];
+}
+
+double LoadController::getAverageMilliseconds() const {
+	return this->nanoseconds_average / 1e6;
+}
+
+unsigned long long LoadController::getChanges() const {
+	return this->changes;
+}
+
+unsigned int LoadController::getLevelMaximum() const {
+	return this->level_maximum;
+}
@@ -0,0 +1,74 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_LOADCONTROLLER_H
+#define IMOVE_PEOPLEEXTRACTOR_LOADCONTROLLER_H
+
+#include <atomic>
+
+// Lowers the quality of extracting people step by step while camera frames take longer than the budget to get through the pipeline, and restores it once they are well within
+class LoadController {
+	public:
+		// What is done with camera frames at a level, each level saves more time than the one before
+		struct Level {
+			// factor of the camera resolution people are detected in
+			float detection_scale;
+			// the background model learns from one in this many camera frames
+			unsigned int frames_learn;
+			// one in this many captured camera frames is processed, the others are dropped
+			unsigned int frames_keep;
+		};
+
+		// Amount of levels, level 0 is full quality
+		static const unsigned int LEVELS = 5;
+		// Camera frames measured after a change before the next change, so the pipeline settles first
+		static const unsigned int FRAMES_HOLD = 30;
+		// Weight of the newest processing time in the average
+		static constexpr double WEIGHT_AVERAGE = 0.125;
+		// Part of the budget the average must stay under to restore a level, so levels do not flip back and forth
+		static constexpr double PART_BUDGET_RESTORE = 0.6;
+		// Camera frames measured after a change before a level is restored, longer than before lowering as restoring costs time again
+		static const unsigned int FRAMES_HOLD_RESTORE = 90;
+		// Longest hold before restoring; the hold doubles up to it every time a restored level has to be lowered again within the hold
+		static const unsigned int FRAMES_HOLD_RESTORE_MAXIMUM = 16 * FRAMES_HOLD_RESTORE;
+
+		/**
+		 * Setup at full quality.
+		 *
+		 * @param nanoseconds_budget The steady clock nanoseconds a camera frame may take from capturing till its people are sent, 0 to never lower the quality
+		 **/
+		LoadController(long long nanoseconds_budget);
+
+		/**
+		 * Measure the processing time of a camera frame, which may change the level. Only called by one thread.
+		 *
+		 * @param nanoseconds The steady clock nanoseconds from capturing the camera frame till its people are sent
+		 * @return Whether the level changed
+		 **/
+		bool update(long long nanoseconds);
+
+		// Gets the current level, which may be asked from any thread
+		unsigned int getLevel() const;
+
+		// Gets what is done with camera frames at a level
+		static const Level& getSettings(unsigned int level);
+
+		// Gets the average processing time in milliseconds
+		double getAverageMilliseconds() const;
+
+		// Gets the amount of times the level changed
+		unsigned long long getChanges() const;
+
+		// Gets the highest level reached
+		unsigned int getLevelMaximum() const;
+
+	private:
+		const long long nanoseconds_budget;
+		std::atomic<unsigned int> level;
+		double nanoseconds_average;
+		unsigned int frames_since_change;
+		// camera frames measured before the next restore, and whether the last change restored a level
+		unsigned int frames_hold_restore;
+		bool restored;
+		unsigned long long changes;
+		unsigned int level_maximum;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_LOADCONTROLLER_H
@@ -0,0 +1,56 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_PIPELINEFRAME_H
+#define IMOVE_PEOPLEEXTRACTOR_PIPELINEFRAME_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "../../../scene_interface/src/People.h"
+#include "../../../util/src/Vector2.h"
+
+// Camera frame and everything derived from it, passed from stage to stage of the people extractor
+struct PipelineFrame {
+	// increasing number of the camera frame
+	unsigned long long sequence;
+	// steady clock time in nanoseconds on which the camera frame is captured
+	long long timestamp_capture;
+	// whether the camera frame is drawn in the debug windows, decided on capture to keep to the debug rate
+	bool debug;
+	// factor of the camera resolution people are detected in and whether the background model learns from the camera frame, decided on capture by the load
+	float detection_scale;
+	bool learn;
+
+	// camera frame as captured
+	cv::Mat frame_captured;
+	// camera frame resized to the camera resolution
+	cv::Mat frame_camera;
+	// camera frame with the projection eliminated
+	cv::Mat frame_eliminatedprojection;
+	// locations of detected people
+	std::vector<Vector2> locations;
+	// identified people in camera coordinates
+	scene_interface::People people_camera;
+	// identified people in projector coordinates
+	scene_interface::People people_projector;
+
+	// camera frame in projector coordinates, only for debug camera frames
+	cv::Mat frame_projection;
+	// detector result, only for debug camera frames
+	cv::Mat frame_detected;
+
+	PipelineFrame() : sequence(0), timestamp_capture(0), debug(false), detection_scale(1), learn(true) {}
+
+	/**
+	 * Camera frame whose frames are allocated from the given allocator, which is kept when stages create them in place.
+	 *
+	 * @param allocator The allocator of the frames
+	 **/
+	explicit PipelineFrame(cv::MatAllocator* allocator) : PipelineFrame() {
+		this->frame_captured.allocator = allocator;
+		this->frame_camera.allocator = allocator;
+		this->frame_eliminatedprojection.allocator = allocator;
+		this->frame_projection.allocator = allocator;
+		this->frame_detected.allocator = allocator;
+	}
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_PIPELINEFRAME_H
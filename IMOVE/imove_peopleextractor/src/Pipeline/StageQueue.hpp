@@ -0,0 +1,115 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_STAGEQUEUE_H
+#define IMOVE_PEOPLEEXTRACTOR_STAGEQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "../../../util/src/configuration/PipelineConfiguration.hpp"
+
+// Bounded queue of camera frames between two stages of the people extractor, on their own threads
+template <typename T>
+class StageQueue {
+	public:
+		/**
+		 * Setup an empty queue.
+		 *
+		 * @param capacity    The maximum amount of waiting items, at least 1
+		 * @param drop_policy What to do when pushing on a full queue
+		 **/
+		StageQueue(unsigned int capacity, PipelineConfiguration::DropPolicy drop_policy) :
+			capacity(capacity > 0 ? capacity : 1),
+			drop_policy(drop_policy),
+			closed(false),
+			pushed(0),
+			dropped(0)
+		{}
+
+		/**
+		 * Push an item, which is dropped or drops another one when full as the drop policy says, or waits till there is room.
+		 *
+		 * @param item The item to push
+		 * @return false when the item itself is dropped
+		 **/
+		bool push(const T& item) {
+			std::unique_lock<std::mutex> lock(this->mutex);
+			if (this->closed) {
+				return false;
+			}
+			++this->pushed;
+			if (this->items.size() >= this->capacity) {
+				if (this->drop_policy == PipelineConfiguration::DROP_POLICY_NEWEST) {
+					++this->dropped;
+					return false;
+				} else if (this->drop_policy == PipelineConfiguration::DROP_POLICY_BLOCK) {
+					this->condition_not_full.wait(lock, [this] { return this->items.size() < this->capacity || this->closed; });
+					if (this->closed) {
+						return false;
+					}
+				} else {
+					++this->dropped;
+					this->items.pop_front();
+				}
+			}
+			this->items.push_back(item);
+			lock.unlock();
+			this->condition_not_empty.notify_one();
+			return true;
+		}
+
+		/**
+		 * Pop the oldest item, waits till there is one.
+		 *
+		 * @param item The popped item
+		 * @return false when the queue is closed and no items are left
+		 **/
+		bool pop(T& item) {
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->condition_not_empty.wait(lock, [this] { return !this->items.empty() || this->closed; });
+			if (this->items.empty()) {
+				return false;
+			}
+			item = this->items.front();
+			this->items.pop_front();
+			lock.unlock();
+			this->condition_not_full.notify_one();
+			return true;
+		}
+
+		// Close the queue so no items are pushed anymore and pop returns false once the queue is empty
+		void close() {
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->closed = true;
+			}
+			this->condition_not_empty.notify_all();
+			this->condition_not_full.notify_all();
+		}
+
+		// Gets the amount of pushed items
+		unsigned long long getPushed() const {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			return this->pushed;
+		}
+
+		// Gets the amount of pushed items which are dropped
+		unsigned long long getDropped() const {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			return this->dropped;
+		}
+
+	private:
+		const unsigned int capacity;
+		const PipelineConfiguration::DropPolicy drop_policy;
+
+		mutable std::mutex mutex;
+		std::condition_variable condition_not_empty;
+		std::condition_variable condition_not_full;
+		std::deque<T> items;
+		bool closed;
+
+		unsigned long long pushed;
+		unsigned long long dropped;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_STAGEQUEUE_H
@@ -0,0 +1,40 @@
+#include "StageTiming.hpp"
+
+StageTiming::StageTiming(const std::string& name) :
+	name(name),
+	frames(0),
+	duration_total(std::chrono::steady_clock::duration::zero()),
+	duration_maximum(std::chrono::steady_clock::duration::zero())
+{}
+
+void StageTiming::begin() {
+	this->time_begin = std::chrono::steady_clock::now();
+}
+
+void StageTiming::end() {
+	const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - this->time_begin;
+	++this->frames;
+	this->duration_total += duration;
+	if (duration > this->duration_maximum) {
+		this->duration_maximum = duration;
+	}
+}
+
+const std::string& StageTiming::getName() const {
+	return this->name;
+}
+
+unsigned long long StageTiming::getFrames() const {
+	return this->frames;
+}
+
+double StageTiming::getAverageMilliseconds() const {
+	if (this->frames == 0) {
+		return 0;
+	}
+	return std::chrono::duration<double, std::milli>(this->duration_total).count() / this->frames;
+}
+
+double StageTiming::getMaximumMilliseconds() const {
+	return std::chrono::duration<double, std::milli>(this->duration_maximum).count();
+}
@@ -0,0 +1,42 @@
+#ifndef IMOVE_PEOPLEEXTRACTOR_STAGETIMING_H
+#define IMOVE_PEOPLEEXTRACTOR_STAGETIMING_H
+
+#include <chrono>
+#include <string>
+
+// Time a stage of the people extractor spends per camera frame, only used by the thread of the stage
+class StageTiming {
+	public:
+		/**
+		 * Setup timing without camera frames.
+		 *
+		 * @param name The name of the stage
+		 **/
+		StageTiming(const std::string& name);
+
+		// Start timing a camera frame
+		void begin();
+
+		// Stop timing the camera frame
+		void end();
+
+		const std::string& getName() const;
+
+		// Gets the amount of timed camera frames
+		unsigned long long getFrames() const;
+
+		// Gets the average milliseconds per camera frame
+		double getAverageMilliseconds() const;
+
+		// Gets the maximum milliseconds of a camera frame
+		double getMaximumMilliseconds() const;
+
+	private:
+		const std::string name;
+		std::chrono::steady_clock::time_point time_begin;
+		unsigned long long frames;
+		std::chrono::steady_clock::duration duration_total;
+		std::chrono::steady_clock::duration duration_maximum;
+};
+
+#endif //IMOVE_PEOPLEEXTRACTOR_STAGETIMING_H
@@ -17,7 +17,10 @@ int main(int argc, char* argv[]) {
 	ImoveConfiguration* calibration = ImoveConfiguration::readFile(argv[CONFIGURATION_CALIBRATION_ARGN]);
 
 	ImovePeopleextractorManager manager(calibration);
-	manager.run();
+	// a failing exit makes imove restart the people extractor, a successful one shuts down imove
+	if (!manager.run()) {
+		return EXIT_FAILURE;
+	}
 	
 	return EXIT_SUCCESS;
 }
@@ -1,5 +1,9 @@
 #include <boost/interprocess/managed_shared_memory.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <algorithm>
 #include <thread>
+#include <chrono>
+#include <iostream>
 
 #include "ImoveSceneManager.hpp"
 
@@ -16,7 +20,7 @@ void ImoveSceneManager::sendingSceneFrameThread(ImoveSceneManager *imove_scene_m
 
 ImoveSceneManager::ImoveSceneManager(ImoveConfiguration *calibration, const SceneConfiguration &sceneConfig) :
         calibration(calibration),
-        projection(Projection(calibration)) {
+        projection(calibration) {
     // setup scene
     this->scene = new GameScene(sceneConfig);
     // Shared memory segment
@@ -25,10 +29,27 @@ ImoveSceneManager::ImoveSceneManager(ImoveConfiguration *calibration, const Scen
     // Construct the people extracted queue in shared memory
     this->si_people_queue = this->segment->find<scene_interface_sma::PeopleQueue>(
             scene_interface_sma::NAME_PEOPLE_QUEUE).first;
-    this->pi_sceneframe_queue = this->segment->find<peopleextractor_interface_sma::SceneframeQueue>(
-            peopleextractor_interface_sma::NAME_SCENEFRAME_QUEUE).first;
+    this->si_people_snapshot = this->segment->find<scene_interface_sma::PeopleSnapshot>(
+            scene_interface_sma::NAME_PEOPLE_SNAPSHOT).first;
+    this->si_trace_ring = this->segment->find<scene_interface_sma::TraceRing>(
+            scene_interface_sma::NAME_TRACE_RING).first;
+    this->pi_sceneframe_buffer = this->segment->find<peopleextractor_interface_sma::SceneframeBuffer>(
+            peopleextractor_interface_sma::NAME_SCENEFRAME_BUFFER).first;
+    // Construct the arena for scene frames downscaled from the projector resolution, or reuse it when the scene is restarted
+    const cv::Size size_sceneframe_projector = this->computeSizeSceneframe(
+            calibration->getProjectorConfiguration()->getResolution());
+    const std::size_t size_sceneframe = peopleextractor_interface_sma::Image::computeSize(
+            size_sceneframe_projector.width, size_sceneframe_projector.height, CHANNELS_SCENEFRAME);
+    const unsigned int amount_slabs = SLABS_SCENEFRAME;
+    this->pi_arena = this->segment->find_or_construct<peopleextractor_interface_sma::SharedMemoryArena>(
+            peopleextractor_interface_sma::NAME_SHARED_MEMORY_ARENA)(size_sceneframe, amount_slabs, this->segment);
+    // Lock shared memory in memory of this process if configured
+    if (calibration->getLockSharedMemory()) {
+        peopleextractor_interface_sma::SharedMemoryArena::prefault(this->segment, true);
+    }
     // Get the whole running class
     this->running = this->segment->find<Running>(NAME_SHARED_MEMORY_RUNNING).first;
+    this->heartbeat = this->segment->find<Heartbeat>(NAME_SHARED_MEMORY_HEARTBEAT_SCENE).first;
 }
 
 void ImoveSceneManager::run() {
@@ -41,24 +62,46 @@ void ImoveSceneManager::run() {
     sf::Clock clock;
 
     float dt;
+    // seconds since the last captured scene frame, 0 fps captures none
     float capture_dt = 0;
-    float SPF_capture_scene =
-            1.f / (float) this->calibration->getProjectioneliminationConfiguration()->getFpsCaptureScene();
+    const unsigned int fps_capture_scene = this->calibration->getProjectioneliminationConfiguration()->getFpsCaptureScene();
+    const float SPF_capture_scene = fps_capture_scene == 0 ? 0 : 1.f / (float) fps_capture_scene;
+
+    // send captured scene frames to the people extractor to eliminate the projection from the camera frames
+    std::thread thread_sending(&ImoveSceneManager::sendingSceneFrameThread, this);
 
     // while allowed to run
     while (this->running->running) {
+        // signal imove that the scene makes progress
+        this->heartbeat->beat();
+        const unsigned long long sequence_people_previous = this->sequence_people_received;
         this->receiveExtractedpeopleAndUpdateScene();
 
         // draw next Scene frame based on clock difference
         dt = clock.restart().asSeconds();
         this->scene->update(dt);
 
+        // capture the scene frame at the configured rate, when too far behind skip the captures missed
+        capture_dt += dt;
+        const bool capture = fps_capture_scene != 0 && capture_dt >= SPF_capture_scene;
+        if (capture) {
+            capture_dt = capture_dt - SPF_capture_scene < SPF_capture_scene ? capture_dt - SPF_capture_scene : 0;
+        }
+
         // draw the actual Scene on window
-        window_scene.drawScene(this->scene);
+        window_scene.drawScene(this->scene, capture ? this->sceneframe_capturing : NULL);
+        if (capture) {
+            this->publishSceneFrame(window_scene.getTimestampDisplay());
+        }
 
-        capture_dt += dt;
-        if (capture_dt > SPF_capture_scene) {
-            capture_dt -= SPF_capture_scene;
+        // trace the first projector frame showing newly received extracted people
+        if (this->sequence_people_received != sequence_people_previous) {
+            this->si_trace_ring->record(this->sequence_people_received, scene_interface_sma::TRACE_STAGE_UPDATE,
+                                        this->scene->getTimestampUpdated());
+            this->si_trace_ring->record(this->sequence_people_received, scene_interface_sma::TRACE_STAGE_RENDER,
+                                        this->scene->getTimestampRendered());
+            this->si_trace_ring->record(this->sequence_people_received, scene_interface_sma::TRACE_STAGE_DISPLAY,
+                                        window_scene.getTimestampDisplay());
         }
 
         // if window should be closed, shutdown application
@@ -67,103 +110,163 @@ void ImoveSceneManager::run() {
             this->running->reboot_on_shutdown = false;
         }
     }
+    thread_sending.join();
+
+    std::cout << "Scene people frames dropped: " << this->people_frames_dropped
+              << " duplicated: " << this->people_frames_duplicated << std::endl;
+    std::cout << "Scene shared memory free: " << this->segment->get_free_memory() << " bytes"
+              << " arena slabs used: " << this->pi_arena->getUsed()
+              << " free: " << this->pi_arena->getFree()
+              << " high water: " << this->pi_arena->getHighWater() << std::endl;
 }
 
 void ImoveSceneManager::receiveExtractedpeopleAndUpdateScene() {
-    if (!this->si_people_queue->empty()) {
-        //create vector of extracted people for input of scene
-        scene_interface::People extractedpeople;
-
-        // receive extracted people from shared memory from peopleextractor
-        boost::interprocess::offset_ptr<scene_interface_sma::People> si_people = this->si_people_queue->front();
-
-        extractedpeople = scene_interface::People();
-        for (unsigned int i = 0; i < si_people->size(); ++i) {
-            // receive extracted person from shared memory
-            boost::interprocess::offset_ptr<scene_interface_sma::Person> si_person = si_people->at(i);
-
-            // create person type from shared memory person type
-            scene_interface::Person::PersonType person_type;
-            switch (si_person->getPersonType()) {
-                case scene_interface_sma::Person::PersonType::Bystander:
-                    person_type = scene_interface::Person::PersonType::Bystander;
-                    break;
-                case scene_interface_sma::Person::PersonType::Participant:
-                    person_type = scene_interface::Person::PersonType::Participant;
-                    break;
-                case scene_interface_sma::Person::PersonType::None:
-                    person_type = scene_interface::Person::PersonType::None;
-                    break;
-            }
-            // create person type from shared memory person type
-            scene_interface::Person::MovementType movement_type;
-            switch (si_person->getMovementType()) {
-                case scene_interface_sma::Person::MovementType::StandingStill:
-                    movement_type = scene_interface::Person::MovementType::StandingStill;
-                    break;
-                case scene_interface_sma::Person::MovementType::Moving:
-                    movement_type = scene_interface::Person::MovementType::Moving;
-                    break;
+    if (this->calibration->getPeopleSnapshotMode()) {
+        // copy newest extracted people, older ones are never queued up
+        if (this->si_people_snapshot->read(this->si_people_latest)) {
+            if (this->si_people_latest.getSequence() == this->sequence_people_received) {
+                // extractor did not publish since last render frame
+                ++this->people_frames_duplicated;
+            } else {
+                this->updateSceneFromPeople(this->si_people_latest);
             }
-            // receive locations from shared memory
-            boost::interprocess::offset_ptr<scene_interface_sma::Locations> locations = si_person->getLocations();
-            // receive location from shared memory
-            boost::interprocess::offset_ptr<scene_interface_sma::Location> location = locations->front();
-
-            // create extracted person for input of scene from received extracted person from shared memory and add extracted person to vector of extracted people
-            extractedpeople.push_back(
-                    scene_interface::Person(
-                            si_person->getId(),
-                            scene_interface::Location(
-                                    location->getX(),
-                                    location->getY()
-                            ),
-                            person_type,
-                            movement_type
-                    )
-            );
         }
+    } else if (!this->si_people_queue->empty()) {
+        // receive extracted people from shared memory from peopleextractor
+        this->updateSceneFromPeople(this->si_people_queue->front());
+        // Release the shared memory frame back to the peopleextractor
+        this->si_people_queue->pop();
+    }
+}
 
-        // update scene with extracted people from peopleextractor
-        this->scene->updatePeople(extractedpeople);
+void ImoveSceneManager::updateSceneFromPeople(const scene_interface_sma::People &si_people) {
+    // count frames dropped by the extractor or overwritten in the snapshot
+    if (this->sequence_people_received != 0 && si_people.getSequence() > this->sequence_people_received + 1) {
+        this->people_frames_dropped += si_people.getSequence() - this->sequence_people_received - 1;
+    }
+    this->sequence_people_received = si_people.getSequence();
+    this->si_trace_ring->record(this->sequence_people_received, scene_interface_sma::TRACE_STAGE_CONSUME);
+
+    //create vector of extracted people for input of scene
+    scene_interface::People extractedpeople;
+    extractedpeople.reserve(si_people.size());
+    for (unsigned int i = 0; i < si_people.size(); ++i) {
+        // receive extracted person from shared memory
+        const scene_interface_sma::Person &si_person = si_people.at(i);
 
-        // Remove last extracted people from queue
-        this->si_people_queue->pop_front();
+        // create person type from shared memory person type
+        scene_interface::Person::PersonType person_type;
+        switch (si_person.getPersonType()) {
+            case scene_interface_sma::Person::PersonType::Bystander:
+                person_type = scene_interface::Person::PersonType::Bystander;
+                break;
+            case scene_interface_sma::Person::PersonType::Participant:
+                person_type = scene_interface::Person::PersonType::Participant;
+                break;
+            case scene_interface_sma::Person::PersonType::None:
+                person_type = scene_interface::Person::PersonType::None;
+                break;
+        }
+        // create person type from shared memory person type
+        scene_interface::Person::MovementType movement_type;
+        switch (si_person.getMovementType()) {
+            case scene_interface_sma::Person::MovementType::StandingStill:
+                movement_type = scene_interface::Person::MovementType::StandingStill;
+                break;
+            case scene_interface_sma::Person::MovementType::Moving:
+                movement_type = scene_interface::Person::MovementType::Moving;
+                break;
+        }
+        // receive location from shared memory
+        const scene_interface_sma::Location location = si_person.getLocation();
+        const scene_interface_sma::Location velocity = si_person.getVelocity();
+
+        // create extracted person for input of scene from received extracted person from shared memory and add extracted person to vector of extracted people
+        extractedpeople.push_back(
+                scene_interface::Person(
+                        si_person.getId(),
+                        scene_interface::Location(
+                                location.getX(),
+                                location.getY()
+                        ),
+                        person_type,
+                        movement_type,
+                        scene_interface::Location(
+                                velocity.getX(),
+                                velocity.getY()
+                        ),
+                        si_people.getTimestampCapture()
+                )
+        );
     }
+
+    // update scene with extracted people from peopleextractor
+    this->scene->updatePeople(extractedpeople);
+}
+
+void ImoveSceneManager::publishSceneFrame(long long timestamp_display) {
+    {
+        std::lock_guard<std::mutex> lock(this->sceneframe_mutex);
+        std::swap(this->sceneframe_capturing, this->sceneframe_latest);
+        this->sceneframe_latest_timestamp_display = timestamp_display;
+        this->sceneframe_latest_fresh = true;
+    }
+    this->sceneframe_condition.notify_one();
 }
 
 void ImoveSceneManager::sendingSceneFrame() {
-    boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeQueue> &pi_sceneframe_queue = this->pi_sceneframe_queue;
+    boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeBuffer> &pi_sceneframe_buffer = this->pi_sceneframe_buffer;
     boost::interprocess::offset_ptr<Running> &running = this->running;
-    const float &factor_resize_capture_scene = this->calibration->getProjectioneliminationConfiguration()->getFactorResizeCaptureScene();
-    std::queue<sf::Image> &sceneframe_queue = this->sceneframe_queue;
-    boost::interprocess::managed_shared_memory *segment = this->segment;
+    boost::interprocess::offset_ptr<peopleextractor_interface_sma::SharedMemoryArena> &pi_arena = this->pi_arena;
+    const bool &sceneframe_latest_fresh = this->sceneframe_latest_fresh;
+    const std::chrono::milliseconds timeout_wait(static_cast<unsigned int>(ImoveSceneManager::TIMEOUT_WAIT_SCENEFRAME_MS));
 
+    long long timestamp_display = 0;
     while (running->running) {
-        if (!sceneframe_queue.empty()) {
-            const sf::Image frame_scene = sceneframe_queue.front();
-            // create shared memory scene frame from sfml image
-            sf::Vector2u size_image = frame_scene.getSize();
-            boost::interprocess::offset_ptr<peopleextractor_interface_sma::Image> pi_sceneframe = segment->construct<peopleextractor_interface_sma::Image>(
-                    boost::interprocess::anonymous_instance)(
-                    ((unsigned int) size_image.x) / factor_resize_capture_scene,
-                    ((unsigned int) size_image.y) / factor_resize_capture_scene,
-                    segment
-            );
-            for (unsigned int x = 0; x < ((unsigned int) size_image.x) / factor_resize_capture_scene; ++x) {
-                for (unsigned int y = 0; y < ((unsigned int) size_image.y) / factor_resize_capture_scene; ++y) {
-                    sf::Color sf_pixel = frame_scene.getPixel(
-                            x * (signed int) factor_resize_capture_scene,
-                            y * (signed int) factor_resize_capture_scene
-                    );
-                    pi_sceneframe->setRGB(x, y, (unsigned char) sf_pixel.r, (unsigned char) sf_pixel.g,
-                                          (unsigned char) sf_pixel.b);
-                }
+        {
+            // sleep until a scene frame is captured; wake up regularly to check for shutdown
+            std::unique_lock<std::mutex> lock(this->sceneframe_mutex);
+            if (!this->sceneframe_condition.wait_for(
+                    lock,
+                    timeout_wait,
+                    [&sceneframe_latest_fresh] { return sceneframe_latest_fresh; })) {
+                continue;
             }
+            // take the latest captured scene frame, older ones are already overwritten as the people extractor only uses the latest
+            std::swap(this->sceneframe_sending, this->sceneframe_latest);
+            timestamp_display = this->sceneframe_latest_timestamp_display;
+            this->sceneframe_latest_fresh = false;
+        }
 
-            // push on shared memory queue for people extractor to pop
-            pi_sceneframe_queue->push_back(pi_sceneframe);
-            sceneframe_queue.pop();
+        // read the scene frame back from the GPU on this thread, so the render thread never waits on it
+        const sf::Image frame_scene = this->sceneframe_sending->copyToImage();
+        const sf::Vector2u size_image = frame_scene.getSize();
+        const cv::Size size_sceneframe = this->computeSizeSceneframe(cv::Size(size_image.x, size_image.y));
+        // allocate shared memory scene frames from the arena once the size of the scene frame is known or changed,
+        // skip scene frames until the people extractor released the previous generation
+        if (pi_sceneframe_buffer->allocate(size_sceneframe.width, size_sceneframe.height, CHANNELS_SCENEFRAME, pi_arena)) {
+            peopleextractor_interface_sma::Image &pi_sceneframe = pi_sceneframe_buffer->back();
+            if (size_sceneframe.width == (int) size_image.x && size_sceneframe.height == (int) size_image.y) {
+                // bulk copy sfml RGBA pixels in shared memory scene frame
+                pi_sceneframe.copyFrom(frame_scene.getPixelsPtr(), size_image.x * CHANNELS_SCENEFRAME);
+            } else {
+                // downscale sfml RGBA pixels straight into the shared memory scene frame, averaging the pixels each one covers
+                const cv::Mat cv_frame_scene(size_image.y, size_image.x, CV_8UC4,
+                                             const_cast<sf::Uint8 *>(frame_scene.getPixelsPtr()));
+                cv::Mat cv_sceneframe(size_sceneframe, CV_8UC4, pi_sceneframe.getData(), pi_sceneframe.getStride());
+                cv::resize(cv_frame_scene, cv_sceneframe, size_sceneframe, 0, 0, cv::INTER_AREA);
+            }
+            // the people extractor eliminates it from the camera frames captured while it is displayed
+            pi_sceneframe.setTimestampDisplay(timestamp_display);
+            // publish as latest for people extractor and wake it up
+            pi_sceneframe_buffer->publish();
         }
     }
 }
+
+cv::Size ImoveSceneManager::computeSizeSceneframe(const cv::Size &size_rendered) const {
+    // a factor of 0 or 1 sends scene frames as rendered
+    const int factor = std::max(
+            (int) this->calibration->getProjectioneliminationConfiguration()->getFactorResizeCaptureScene(), 1);
+    return cv::Size(std::max(size_rendered.width / factor, 1), std::max(size_rendered.height / factor, 1));
+}
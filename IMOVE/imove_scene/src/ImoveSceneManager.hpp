@@ -1,4 +1,7 @@
 #include <boost/interprocess/offset_ptr.hpp>
+#include <mutex>
+#include <condition_variable>
+#include <SFML/Graphics.hpp>
 
 
 #include "../../util/src/configuration/ImoveConfiguration.hpp"
@@ -6,12 +9,22 @@
 #include "Scene/Scene.h"
 #include "Scene/SceneConfiguration.h"
 #include "../../scene_interface_sma/src/PeopleQueue.hpp"
-#include "../../peopleextractor_interface_sma/src/SceneframeQueue.hpp"
+#include "../../scene_interface_sma/src/PeopleSnapshot.hpp"
+#include "../../scene_interface_sma/src/TraceRing.hpp"
+#include "../../peopleextractor_interface_sma/src/SceneframeBuffer.hpp"
 #include "../../imove/src/Running.hpp"
+#include "../../imove/src/Heartbeat.hpp"
 
 // Setups people extractor and Scene, can let the Scene run using constant input of people extractor
 class ImoveSceneManager {
 public:
+    // Amount of bytes per pixel of a SFML scene frame (RGBA)
+    static const unsigned int CHANNELS_SCENEFRAME = 4;
+    // Maximum milliseconds to sleep waiting on a captured scene frame before checking whether still running
+    static const unsigned int TIMEOUT_WAIT_SCENEFRAME_MS = 100;
+    // Amount of arena slabs for scene frames, room for the images of two generations
+    static const unsigned int SLABS_SCENEFRAME = 2 * peopleextractor_interface_sma::IMAGES_SCENEFRAME_BUFFER;
+
     /**
      * Setup people extractor and Scene.
      *
@@ -28,26 +41,78 @@ protected:
     Projection projection;
     Scene *scene = NULL;
 
-    std::queue<sf::Image> sceneframe_queue;
+    // Textures scene frames are captured in on the GPU, handed between the render and the sending thread by swapping pointers
+    sf::Texture sceneframe_textures[3];
+    // Texture the render thread captures the next scene frame in
+    sf::Texture *sceneframe_capturing = &sceneframe_textures[0];
+    // Latest captured scene frame and the steady clock nanoseconds it is displayed on, guarded by the mutex
+    sf::Texture *sceneframe_latest = &sceneframe_textures[1];
+    long long sceneframe_latest_timestamp_display = 0;
+    // Whether the latest captured scene frame is not taken by the sending thread yet, guarded by the mutex
+    bool sceneframe_latest_fresh = false;
+    // Texture the sending thread reads the scene frame it sends back from
+    sf::Texture *sceneframe_sending = &sceneframe_textures[2];
+    std::mutex sceneframe_mutex;
+    // Notifies the sending thread on a captured scene frame
+    std::condition_variable sceneframe_condition;
 
     // shared memory segment
     boost::interprocess::managed_shared_memory *segment;
     // People extractor queue
     boost::interprocess::offset_ptr<scene_interface_sma::PeopleQueue> si_people_queue;
-    // Scene frames queue
-    boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeQueue> pi_sceneframe_queue;
+    // People extractor latest snapshot
+    boost::interprocess::offset_ptr<scene_interface_sma::PeopleSnapshot> si_people_snapshot;
+    // Trace of camera frames through the pipeline
+    boost::interprocess::offset_ptr<scene_interface_sma::TraceRing> si_trace_ring;
+    // Local copy of the latest snapshot
+    scene_interface_sma::People si_people_latest;
+
+    // Sequence of the last received extracted people frame, 0 when none received
+    unsigned long long sequence_people_received = 0;
+    // Amount of extracted people frames never received by the scene
+    unsigned long long people_frames_dropped = 0;
+    // Amount of times the latest snapshot did not change since the last render frame
+    unsigned long long people_frames_duplicated = 0;
+    // Scene frames buffer
+    boost::interprocess::offset_ptr<peopleextractor_interface_sma::SceneframeBuffer> pi_sceneframe_buffer;
+    // Arena the scene frames are allocated from
+    boost::interprocess::offset_ptr<peopleextractor_interface_sma::SharedMemoryArena> pi_arena;
     // whole application running
     boost::interprocess::offset_ptr<Running> running;
+    // shared memory heartbeat watched by imove
+    boost::interprocess::offset_ptr<Heartbeat> heartbeat;
 
     /**
      * Receive extracted people from people extractor in shared memory queue and update scene
      **/
     void receiveExtractedpeopleAndUpdateScene();
 
+    /**
+     * Update scene with extracted people frame from shared memory and count the frames skipped since the last one
+     *
+     * @param si_people The shared memory extracted people frame
+     **/
+    void updateSceneFromPeople(const scene_interface_sma::People &si_people);
+
     static void sendingSceneFrameThread(ImoveSceneManager *imove_scene_manager);
 
     /**
-     * Send scene frame to people extractor via shared memory queue
+     * Hand the scene frame captured in the capturing texture over as latest and wake up the sending thread,
+     * a latest scene frame the sending thread did not take yet is overwritten
+     *
+     * @param timestamp_display The steady clock nanoseconds on which the scene frame is displayed
+     **/
+    void publishSceneFrame(long long timestamp_display);
+
+    /**
+     * Send scene frame to people extractor via shared memory buffer
      **/
     void sendingSceneFrame();
+
+    /**
+     * Size of a scene frame sent to the people extractor, downscaled by the configured factor
+     *
+     * @param size_rendered The size of the scene frame as rendered
+     **/
+    cv::Size computeSizeSceneframe(const cv::Size &size_rendered) const;
 };
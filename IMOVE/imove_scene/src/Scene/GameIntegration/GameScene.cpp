@@ -5,6 +5,13 @@
 #include "../../../../../game/src/storage/Variables.h"
 #include "../../../../../game/src/control/gameStates/GameRunningState.h"
 #include <list>
+#include <chrono>
+
+// Steady clock time in nanoseconds, which is the same clock in every process
+static long long nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 /**
  * Constructor for the GameScene, this is called in SceneWindow.cpp.
@@ -31,12 +38,16 @@ GameScene::GameScene(SceneConfiguration config) {
 void GameScene::draw(sf::RenderWindow &target) {
 
     Time frameTime = clock.restart();
+    const long long timestampDraw = nowNanoseconds();
 
     // Create a RenderWrapper if is has not been initialized.
     if (this->renderWrapper == nullptr) {
         this->renderWrapper = new RenderWrapper(&target);
     }
 
+    // Move users to where they are when this frame is displayed, minus the delay to interpolate.
+    users->resample(timestampDraw + latencyDisplay - sceneConfig.resampleDelay, sceneConfig.maximumExtrapolation);
+
     // Generate input based on current players in the screen and send generated InputData to the GameManager.
     std::list<InputData *> inputDataList = users->generateInput(frameTime.asSeconds());
 
@@ -72,6 +83,7 @@ void GameScene::draw(sf::RenderWindow &target) {
 
     //Propagate the movement data to the GameManager.
     gameManager->update(inputDataList);
+    timestamp_updated = nowNanoseconds();
 
     // Calls to generate / update the final scene.
     renderWrapper->renderBackground();
@@ -89,6 +101,8 @@ void GameScene::draw(sf::RenderWindow &target) {
 
     // Display the frame and push all rendered data to the SFML window at once.
     renderWrapper->displayFrame();
+    timestamp_rendered = nowNanoseconds();
+    latencyDisplay += (timestamp_rendered - timestampDraw - latencyDisplay) / 8;
 
     // Clear user data to prevent previous user data from IMOVE from influencing the next frame.
     users->clearData();
@@ -114,6 +128,8 @@ void GameScene::processPeople() {
             scene_interface::Person person = newPeople[i];
             unsigned int id = person.getId();
             scene_interface::Location newLocation = person.getLocation();
+            scene_interface::Location velocity = person.getVelocity();
+            long long timestamp = person.getTimestampCapture();
 
             // Only if the person is a participant (and is therefore located within the scene will there be a corresponding user updated or created.
             if (person.getPersonType() == scene_interface::Person::PersonType::Participant) {
@@ -123,10 +139,12 @@ void GameScene::processPeople() {
                     if(playerManager != nullptr) {
                         playerManager->createPlayer(id);
                     }
-                    users->add(new User(id, newLocation.getX(), newLocation.getY()));
+                    users->add(new User(id, newLocation.getX(), newLocation.getY(), timestamp, velocity.getX(),
+                                        velocity.getY()));
                 } else {
                     // Or update location otherwise.
-                    users->get(id)->setLocation(newLocation.getX(), newLocation.getY());
+                    users->get(id)->setLocation(newLocation.getX(), newLocation.getY(), timestamp, velocity.getX(),
+                                                velocity.getY());
                 }
             } else {
                 // If the person left the scene, delete their circle.
@@ -24,6 +24,9 @@ private:
 
     sf::Clock clock;
 
+    // Nanoseconds from the start of a draw till the frame is displayed, averaged over the last frames
+    long long latencyDisplay = 0;
+
     // Processing of detected people
     void processPeople() override;
 
@@ -10,6 +10,7 @@
 #define IMOVE_USER_CPP
 
 
+#include <algorithm>
 #include <iostream>
 #include "User.h"
 #include "../../../../util/src/Vector2.h"
@@ -20,13 +21,15 @@
  * @param id - ID of the user.
  * @param x - Current x coordinate of the user.
  * @param y - Current y coordinate of the user.
+ * @param timestamp - Steady clock nanoseconds on which the location was captured, 0 when unknown.
+ * @param velocityX - Velocity in pixels per second along x.
+ * @param velocityY - Velocity in pixels per second along y.
  */
-User::User(int id, float x, float y) {
+User::User(int id, float x, float y, long long timestamp, float velocityX, float velocityY) {
     this->id = id;
-    avgX.push_back(x);
-    avgY.push_back(y);
     this->x = x;
     this->y = y;
+    samples.push_back(Sample{timestamp, x, y, velocityX, velocityY});
 }
 
 // Getters
@@ -42,51 +45,91 @@ int User::getId() const {
 
 /**
  * Getter for x coordinate.
- * @return x - the current x coordinate of the user.
+ * @return x - the x coordinate of the user at the last resampled time.
  */
 float User::getX() {
-    std::list<float>::iterator it;
-    float count = 0;
-    for (it = avgX.begin(); it != avgX.end(); ++it) {
-        count += (*it);
-    }
-    return count / (float) avgX.size();
+    return x;
 }
 
 /**
  * Getter for the y coordinate.
- * @return y - the current y coordinate of the user.
+ * @return y - the y coordinate of the user at the last resampled time.
  */
 float User::getY() {
-    std::list<float>::iterator it;
-    float count = 0;
-    for (it = avgY.begin(); it != avgY.end(); ++it) {
-        count += (*it);
-    }
-
-    return count / (float) avgY.size();
+    return y;
 }
 
 // Setters
 
 /**
- * The setter for location.
+ * The setter for location, which adds a sample to resample from.
+ * Without a timestamp the location is taken as is.
  * @param x - The new x coordinate of the user.
  * @param y - The new y coordinate of the user.
+ * @param timestamp - Steady clock nanoseconds on which the location was captured, 0 when unknown.
+ * @param velocityX - Velocity in pixels per second along x.
+ * @param velocityY - Velocity in pixels per second along y.
  */
-void User::setLocation(float x, float y) {
-    if ((int) avgX.size() > bufferSize) {
-        avgX.pop_front();
+void User::setLocation(float x, float y, long long timestamp, float velocityX, float velocityY) {
+    // A sample which is not newer replaces the last one, so samples stay ordered in time.
+    if (samples.back().timestamp >= timestamp) {
+        samples.pop_back();
     }
-    if ((int) avgY.size() > bufferSize) {
-        avgY.pop_front();
+    if (samples.size() >= BUFFER_SAMPLES) {
+        samples.pop_front();
     }
-    avgX.push_back(x);
-    avgY.push_back(y);
+    samples.push_back(Sample{timestamp, x, y, velocityX, velocityY});
     this->x = x;
     this->y = y;
 }
 
+/**
+ * Moves the location to where the user is at the given time.
+ * Between two samples the location is interpolated, after the last sample it is extrapolated with the velocity.
+ * @param timestamp - Steady clock nanoseconds to resample the location at.
+ * @param maximumExtrapolation - Maximum nanoseconds to extrapolate after the last sample.
+ */
+void User::resample(long long timestamp, long long maximumExtrapolation) {
+    const Sample &last = samples.back();
+    if (last.timestamp <= 0) {
+        x = last.x;
+        y = last.y;
+        return;
+    }
+
+    // Interpolate between the two samples around the time.
+    if (timestamp < last.timestamp) {
+        if (timestamp <= samples.front().timestamp) {
+            x = samples.front().x;
+            y = samples.front().y;
+            return;
+        }
+        unsigned int i = 1;
+        while (samples[i].timestamp <= timestamp) {
+            ++i;
+        }
+        const Sample &before = samples[i - 1];
+        const Sample &after = samples[i];
+        const float t = (float) (timestamp - before.timestamp) / (float) (after.timestamp - before.timestamp);
+        x = before.x + (after.x - before.x) * t;
+        y = before.y + (after.y - before.y) * t;
+        return;
+    }
+
+    // Extrapolate after the last sample, with the difference to the previous sample if no velocity is given.
+    float velocityX = last.velocityX;
+    float velocityY = last.velocityY;
+    if (velocityX == 0 && velocityY == 0 && samples.size() > 1) {
+        const Sample &previous = samples[samples.size() - 2];
+        const float seconds = (float) (last.timestamp - previous.timestamp) / 1e9f;
+        velocityX = (last.x - previous.x) / seconds;
+        velocityY = (last.y - previous.y) / seconds;
+    }
+    const float seconds = (float) std::min(timestamp - last.timestamp, maximumExtrapolation) / 1e9f;
+    x = last.x + velocityX * seconds;
+    y = last.y + velocityY * seconds;
+}
+
 /**
  *
  * @param user1 - User instance that is compared.
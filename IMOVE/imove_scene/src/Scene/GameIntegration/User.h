@@ -5,23 +5,34 @@
 #ifndef IMOVE_USER_H
 #define IMOVE_USER_H
 
-#include <list>
+#include <deque>
 #include "../../../../util/src/Vector2.h"
 
 /**
  * Every User in the scene has a location and an ID. These IDs match the IDs of User in InputData / PlayerManager.
+ * The location is resampled from the timestamped locations received from IMOVE to the time a frame is displayed.
  */
 class User {
 private:
+    // Location of the user at the time the camera frame was captured
+    struct Sample {
+        long long timestamp;
+        float x;
+        float y;
+        float velocityX;
+        float velocityY;
+    };
+
+    // Amount of samples kept to interpolate between
+    static const unsigned int BUFFER_SAMPLES = 4;
+
     int id;
     float x;
     float y;
-    std::list<float> avgX;
-    std::list<float> avgY;
-    int bufferSize = 5;
+    std::deque<Sample> samples;
 
 public:
-    User(int id, float x, float y);
+    User(int id, float x, float y, long long timestamp = 0, float velocityX = 0, float velocityY = 0);
 
     // Getters
     int getId() const;
@@ -31,7 +42,10 @@ public:
     float getY();
 
     // Setters
-    void setLocation(float x, float y);
+    void setLocation(float x, float y, long long timestamp = 0, float velocityX = 0, float velocityY = 0);
+
+    // Moves the location to where the user is at the given time
+    void resample(long long timestamp, long long maximumExtrapolation);
 };
 
 #endif //IMOVE_USER_H
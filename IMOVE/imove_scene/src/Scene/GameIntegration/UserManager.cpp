@@ -154,6 +154,17 @@ void UserManager::clearUsers() {
     active.clear();
 }
 
+/**
+ * Moves all active users to where they are at the given time.
+ * @param timestamp - Steady clock nanoseconds to resample the locations at.
+ * @param maximumExtrapolation - Maximum nanoseconds to extrapolate after the last received location.
+ */
+void UserManager::resample(long long timestamp, long long maximumExtrapolation) {
+    for (User *user : active) {
+        user->resample(timestamp, maximumExtrapolation);
+    }
+}
+
 /**
  * Generates InputData based on the current active users.
  * @return data - A list with all InputData of all users, which is propagated to the GameManager.
@@ -50,6 +50,8 @@ public:
 
     bool isRemoved();
 
+    void resample(long long timestamp, long long maximumExtrapolation);
+
     std::list<InputData *> generateInput(float frameTime);
 
 };
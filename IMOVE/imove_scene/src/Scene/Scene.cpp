@@ -53,3 +53,11 @@ void Scene::update(float dt) {
 void Scene::updatePeople(const scene_interface::People &newPeople) {
     peopleQueue.push(newPeople);
 }
+
+long long Scene::getTimestampUpdated() const {
+    return timestamp_updated;
+}
+
+long long Scene::getTimestampRendered() const {
+    return timestamp_rendered;
+}
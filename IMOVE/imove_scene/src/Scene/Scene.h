@@ -16,6 +16,10 @@ protected:
     std::vector<std::unique_ptr<Condition>> conditions; //Idem
     virtual void processPeople() = 0;
 
+    // Steady clock nanoseconds on which the last draw finished updating and rendering, set by the subclass
+    long long timestamp_updated = 0;
+    long long timestamp_rendered = 0;
+
 public:
     Scene();
 
@@ -24,6 +28,12 @@ public:
     void update(float dt);
 
     virtual void draw(sf::RenderWindow &target) = 0;
+
+    // Steady clock nanoseconds on which the last draw finished updating the game
+    long long getTimestampUpdated() const;
+
+    // Steady clock nanoseconds on which the last draw finished rendering the game
+    long long getTimestampRendered() const;
 };
 
 
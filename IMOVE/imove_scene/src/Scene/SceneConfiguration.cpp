@@ -13,6 +13,10 @@ SceneConfiguration SceneConfiguration::readFromFile(char *fileName, ImoveConfigu
     config.screenWidth = static_cast<unsigned int>(resolution.width);
     config.screenHeight = static_cast<unsigned int>(resolution.height);
 
+    // Store the resampling of people to the displayed frame
+    config.resampleDelay = static_cast<long long>(calibration->getProjectorConfiguration()->getResampleDelay() * 1e9);
+    config.maximumExtrapolation = static_cast<long long>(calibration->getProjectorConfiguration()->getMaximumExtrapolation() * 1e9);
+
     // Read and store circle radius
     fs["Radius"] >> config.radius;
 
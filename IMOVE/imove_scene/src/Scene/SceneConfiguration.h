@@ -10,6 +10,9 @@ struct SceneConfiguration {
     unsigned int screenWidth, screenHeight;
     // Radius of the circles
     int radius;
+    // Nanoseconds people are shown behind the displayed frame, and at most ahead of their last received location
+    long long resampleDelay;
+    long long maximumExtrapolation;
 
     // Function to read values from a yml file
     static SceneConfiguration readFromFile(char *fileName, ImoveConfiguration *calibration);
@@ -1,4 +1,5 @@
 #include <SFML/Graphics.hpp>
+#include <chrono>
 
 #include "SceneWindow.hpp"
 #include "../../../../game/src/storage/Variables.h"
@@ -19,13 +20,29 @@ SceneWindow::SceneWindow(cv::Size resolution_projector, const bool &fullscreen_p
     this->window_scene->setFramerateLimit(Variables::FRAMERATE_LIMIT);
 }
 
-void SceneWindow::drawScene(Scene *scene) {
+void SceneWindow::drawScene(Scene *scene, sf::Texture *texture_capture) {
     this->window_scene->clear(sf::Color::White);
     scene->draw(*this->window_scene);
 
+    // copy the back buffer before it is swapped, this is the frame that is displayed next; the copy stays on the GPU,
+    // it is only read back by the thread sending it, which sees it as the update flushes it to all contexts
+    if (texture_capture != NULL) {
+        const sf::Vector2u size_window = this->window_scene->getSize();
+        if (texture_capture->getSize() != size_window) {
+            texture_capture->create(size_window.x, size_window.y);
+        }
+        texture_capture->update(*this->window_scene);
+    }
+    // without vertical sync display swaps the buffers right away and only then sleeps out the frame rate limit, so stamp before it
+    this->timestamp_display = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
     this->window_scene->display();
 }
 
+long long SceneWindow::getTimestampDisplay() const {
+    return this->timestamp_display;
+}
+
 bool SceneWindow::shouldKeepOpen() {
     bool open = true;
     sf::Event event;
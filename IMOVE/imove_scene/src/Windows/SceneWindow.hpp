@@ -13,12 +13,21 @@ public:
      **/
     SceneWindow(cv::Size resolution_projector, const bool &fullscreen_projector);
 
-    // draw the Scene on the render window
-    void drawScene(Scene *scene);
+    /**
+     * Draw the Scene on the render window and stamp the time it is displayed
+     *
+     * @param scene           The Scene to draw
+     * @param texture_capture The texture to capture the rendered frame in on the GPU before it is displayed, NULL to not capture
+     **/
+    void drawScene(Scene *scene, sf::Texture *texture_capture = NULL);
+
+    // the steady clock nanoseconds on which the last drawn frame is displayed
+    long long getTimestampDisplay() const;
 
     // checks wether to close window or not and closes if needed
     bool shouldKeepOpen();
 
 protected:
     sf::RenderWindow *window_scene;
+    long long timestamp_display = 0;
 };
@@ -0,0 +1,214 @@
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../scene_interface_sma/src/SharedMemory.hpp"
+#include "../../scene_interface_sma/src/TraceRing.hpp"
+
+const unsigned int CHROMETRACE_ARGN = 1;
+
+// Milliseconds per bucket of the motion-to-photon histogram
+const double WIDTH_BUCKET_MS = 5.0;
+// Amount of buckets of the motion-to-photon histogram, the last one also counts all slower frames
+const unsigned int AMOUNT_BUCKETS = 20;
+// Maximum width in characters of a histogram bar
+const unsigned int WIDTH_BAR = 50;
+
+// Chrome trace process ids of the processes the stages are passed in
+const unsigned int PID_PEOPLEEXTRACTOR = 1;
+const unsigned int PID_SCENE = 2;
+
+// Timestamps of all traced stages of a camera frame, 0 when not traced
+struct FrameTrace {
+	long long timestamps[scene_interface_sma::AMOUNT_TRACE_STAGES];
+
+	FrameTrace() {
+		std::fill(this->timestamps, this->timestamps + scene_interface_sma::AMOUNT_TRACE_STAGES, 0);
+	}
+};
+
+/**
+ * Gets the percentile of sorted values.
+ *
+ * @param values     The sorted values, not empty
+ * @param percentile The percentile between 0 and 100
+ **/
+double percentile(const std::vector<double>& values, double percentile) {
+	const std::size_t index = static_cast<std::size_t>(percentile / 100.0 * (values.size() - 1) + 0.5);
+	return values[index];
+}
+
+/**
+ * Print count and percentiles of milliseconds per stage.
+ *
+ * @param title      The title of the table
+ * @param milliseconds_stages The milliseconds of all frames per stage
+ **/
+void printPercentiles(const std::string& title, std::vector<std::vector<double> >& milliseconds_stages) {
+	std::cout << title << std::endl;
+	std::cout << std::setw(22) << std::left << "stage" << std::right
+		<< std::setw(8) << "frames"
+		<< std::setw(10) << "p50 ms"
+		<< std::setw(10) << "p90 ms"
+		<< std::setw(10) << "p99 ms"
+		<< std::setw(10) << "max ms" << std::endl;
+	for (unsigned int stage = 0; stage < scene_interface_sma::AMOUNT_TRACE_STAGES; ++stage) {
+		std::vector<double>& milliseconds = milliseconds_stages[stage];
+		if (milliseconds.empty()) {
+			continue;
+		}
+		std::sort(milliseconds.begin(), milliseconds.end());
+		std::cout << std::setw(22) << std::left << scene_interface_sma::NAMES_TRACE_STAGES[stage] << std::right
+			<< std::setw(8) << milliseconds.size() << std::fixed << std::setprecision(2)
+			<< std::setw(10) << percentile(milliseconds, 50)
+			<< std::setw(10) << percentile(milliseconds, 90)
+			<< std::setw(10) << percentile(milliseconds, 99)
+			<< std::setw(10) << milliseconds.back() << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+/**
+ * Print histogram of the milliseconds from capture till display.
+ *
+ * @param milliseconds The milliseconds of all displayed frames
+ **/
+void printHistogram(const std::vector<double>& milliseconds) {
+	std::cout << "Motion-to-photon latency (capture till display)" << std::endl;
+	if (milliseconds.empty()) {
+		std::cout << "no displayed frames" << std::endl << std::endl;
+		return;
+	}
+	std::vector<unsigned int> buckets(AMOUNT_BUCKETS, 0);
+	for (std::vector<double>::const_iterator it = milliseconds.begin(); it != milliseconds.end(); ++it) {
+		buckets[std::min(static_cast<unsigned int>(*it / WIDTH_BUCKET_MS), AMOUNT_BUCKETS - 1)]++;
+	}
+	const unsigned int maximum = *std::max_element(buckets.begin(), buckets.end());
+	for (unsigned int i = 0; i < AMOUNT_BUCKETS; ++i) {
+		std::ostringstream label;
+		label << i * WIDTH_BUCKET_MS;
+		if (i == AMOUNT_BUCKETS - 1) {
+			label << "+";
+		} else {
+			label << "-" << (i + 1) * WIDTH_BUCKET_MS;
+		}
+		label << " ms";
+		std::cout << std::setw(12) << label.str() << std::setw(8) << buckets[i] << " " << std::string(buckets[i] * WIDTH_BAR / maximum, '#') << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+/**
+ * Write the stages of all frames as Chrome trace events, viewable in chrome://tracing.
+ *
+ * @param filepath The path of the JSON file
+ * @param frames   The traced frames by sequence
+ **/
+void writeChromeTrace(const std::string& filepath, const std::map<unsigned long long, FrameTrace>& frames) {
+	std::ofstream file(filepath.c_str());
+	if (!file) {
+		std::cerr << "Failing to write " << filepath << std::endl;
+		return;
+	}
+	// timestamps relative to first capture in microseconds
+	long long timestamp_origin = 0;
+	if (!frames.empty()) {
+		timestamp_origin = frames.begin()->second.timestamps[scene_interface_sma::TRACE_STAGE_CAPTURE];
+	}
+	file << "{\"traceEvents\":[" << std::endl;
+	file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << PID_PEOPLEEXTRACTOR << ",\"args\":{\"name\":\"peopleextractor\"}}," << std::endl;
+	file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << PID_SCENE << ",\"args\":{\"name\":\"scene\"}}";
+	for (std::map<unsigned long long, FrameTrace>::const_iterator frame = frames.begin(); frame != frames.end(); ++frame) {
+		// every stage lasts from the previous traced stage till passing it
+		unsigned int stage_previous = scene_interface_sma::TRACE_STAGE_CAPTURE;
+		for (unsigned int stage = scene_interface_sma::TRACE_STAGE_CAPTURE + 1; stage < scene_interface_sma::AMOUNT_TRACE_STAGES; ++stage) {
+			const long long timestamp = frame->second.timestamps[stage];
+			if (timestamp == 0) {
+				continue;
+			}
+			const long long timestamp_previous = frame->second.timestamps[stage_previous];
+			file << "," << std::endl << "{\"name\":\"" << scene_interface_sma::NAMES_TRACE_STAGES[stage] << "\""
+				<< ",\"cat\":\"frame\",\"ph\":\"X\""
+				<< ",\"ts\":" << (timestamp_previous - timestamp_origin) / 1000.0
+				<< ",\"dur\":" << (timestamp - timestamp_previous) / 1000.0
+				<< ",\"pid\":" << (stage <= scene_interface_sma::TRACE_STAGE_PUBLISH ? PID_PEOPLEEXTRACTOR : PID_SCENE)
+				<< ",\"tid\":1"
+				<< ",\"args\":{\"sequence\":" << frame->first << "}}";
+			stage_previous = stage;
+		}
+	}
+	file << std::endl << "]}" << std::endl;
+	std::cout << "Written Chrome trace of " << frames.size() << " frames to " << filepath << std::endl;
+}
+
+// dump latency statistics of the camera frames traced by a running imove, optionally as Chrome trace
+int main(int argc, char* argv[]) {
+	if (argc > 2) {
+		std::cerr << "Usage: [<path to Chrome trace JSON file to write>]" << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	boost::interprocess::managed_shared_memory* segment;
+	try {
+		segment = new boost::interprocess::managed_shared_memory(boost::interprocess::open_only, scene_interface_sma::NAME_SHARED_MEMORY);
+	} catch (const boost::interprocess::interprocess_exception& exception) {
+		std::cerr << "Failing to open shared memory, imove is not running: " << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	boost::interprocess::offset_ptr<scene_interface_sma::TraceRing> si_trace_ring = segment->find<scene_interface_sma::TraceRing>(scene_interface_sma::NAME_TRACE_RING).first;
+	if (si_trace_ring == NULL) {
+		std::cerr << "Failing to find trace in shared memory" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// group records by camera frame, keeping the first time a frame passes a stage
+	std::vector<scene_interface_sma::TraceRecord> records;
+	si_trace_ring->snapshot(records);
+	std::map<unsigned long long, FrameTrace> frames;
+	for (std::vector<scene_interface_sma::TraceRecord>::const_iterator record = records.begin(); record != records.end(); ++record) {
+		long long& timestamp = frames[record->sequence].timestamps[record->stage];
+		if (timestamp == 0) {
+			timestamp = record->timestamp;
+		}
+	}
+	// only frames of which the capture is still in the trace can be measured
+	for (std::map<unsigned long long, FrameTrace>::iterator frame = frames.begin(); frame != frames.end();) {
+		if (frame->second.timestamps[scene_interface_sma::TRACE_STAGE_CAPTURE] == 0) {
+			frames.erase(frame++);
+		} else {
+			++frame;
+		}
+	}
+	std::cout << "Traced " << records.size() << " records of " << frames.size() << " camera frames" << std::endl << std::endl;
+
+	// milliseconds since capture and since previous traced stage
+	std::vector<std::vector<double> > milliseconds_since_capture(scene_interface_sma::AMOUNT_TRACE_STAGES);
+	std::vector<std::vector<double> > milliseconds_since_previous(scene_interface_sma::AMOUNT_TRACE_STAGES);
+	for (std::map<unsigned long long, FrameTrace>::const_iterator frame = frames.begin(); frame != frames.end(); ++frame) {
+		const long long* timestamps = frame->second.timestamps;
+		unsigned int stage_previous = scene_interface_sma::TRACE_STAGE_CAPTURE;
+		for (unsigned int stage = scene_interface_sma::TRACE_STAGE_CAPTURE + 1; stage < scene_interface_sma::AMOUNT_TRACE_STAGES; ++stage) {
+			if (timestamps[stage] == 0) {
+				continue;
+			}
+			milliseconds_since_capture[stage].push_back((timestamps[stage] - timestamps[scene_interface_sma::TRACE_STAGE_CAPTURE]) / 1e6);
+			milliseconds_since_previous[stage].push_back((timestamps[stage] - timestamps[stage_previous]) / 1e6);
+			stage_previous = stage;
+		}
+	}
+	printHistogram(milliseconds_since_capture[scene_interface_sma::TRACE_STAGE_DISPLAY]);
+	printPercentiles("Latency since capture", milliseconds_since_capture);
+	printPercentiles("Latency since previous stage", milliseconds_since_previous);
+
+	if (argc == 2) {
+		writeChromeTrace(argv[CHROMETRACE_ARGN], frames);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -1,16 +1,46 @@
+#include <cstring>
+
 #include "Image.hpp"
 
 using namespace peopleextractor_interface_sma;
 
-Image::Image(unsigned int width, unsigned int height, boost::interprocess::managed_shared_memory* segment) : width(width), height(height) {
-	const RowColumnGreySMA row_column_grey_sma(segment->get_segment_manager());
-	this->row_column_rgb = segment->construct<RowColumnGrey>(boost::interprocess::anonymous_instance)(row_column_grey_sma);
-	for (unsigned int x = 0; x < this->width; ++x) {
+// Amount of bytes of a row rounded up to the row alignment
+static unsigned int computeStride(unsigned int width, unsigned int channels) {
+	return ((width * channels + ALIGNMENT_IMAGE_ROW - 1) / ALIGNMENT_IMAGE_ROW) * ALIGNMENT_IMAGE_ROW;
+}
+
+Image::Image() :
+	pixels(NULL),
+	width(0),
+	height(0),
+	channels(0),
+	stride(0),
+	timestamp_display(0)
+{}
+
+Image::Image(unsigned int width, unsigned int height, unsigned int channels, unsigned char* pixels) :
+	pixels(pixels),
+	width(width),
+	height(height),
+	channels(channels),
+	stride(computeStride(width, channels)),
+	timestamp_display(0)
+{
+	std::memset(this->pixels.get(), 0, this->stride * this->height);
+}
+
+std::size_t Image::computeSize(unsigned int width, unsigned int height, unsigned int channels) {
+	return (std::size_t) computeStride(width, channels) * height;
+}
+
+void Image::copyFrom(const unsigned char* source, unsigned int source_stride) {
+	const unsigned int size_row = this->width * this->channels;
+	if (source_stride == this->stride) {
+		// one bulk copy when the rows are laid out the same
+		std::memcpy(this->pixels.get(), source, this->stride * this->height);
+	} else {
 		for (unsigned int y = 0; y < this->height; ++y) {
-			this->row_column_rgb->push_back(0);
-			this->row_column_rgb->push_back(0);
-			this->row_column_rgb->push_back(0);
+			std::memcpy(this->pixels.get() + y * this->stride, source + y * source_stride, size_row);
 		}
 	}
 }
-
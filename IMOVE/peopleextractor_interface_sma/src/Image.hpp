@@ -2,55 +2,89 @@
 #define PEOPLEEXTRACTORINTERFACESMA_IMAGE_H
 
 #include <boost/interprocess/offset_ptr.hpp>
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/containers/vector.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
-
-#include "RGB.hpp"
+#include <cstddef>
 
 namespace peopleextractor_interface_sma {
-	//Define an STL compatible allocator of ints that allocates from the managed_shared_memory.
-	//This allocator will allow placing containers in the segment
-	typedef boost::interprocess::allocator<unsigned char, boost::interprocess::managed_shared_memory::segment_manager> RowColumnGreySMA;
-	
-	//Alias a vector that uses the previous STL-like allocator so that allocates its values from the segment
-	typedef boost::interprocess::vector<unsigned char, RowColumnGreySMA> RowColumnGrey;
-	
+	// Alignment of the start of every row of pixels, so rows can be copied and read with aligned vector loads
+	const unsigned int ALIGNMENT_IMAGE_ROW = 64;
+
+	/**
+	 * Row-major interleaved image in shared memory. Rows are stride bytes apart so the pixels can be wrapped
+	 * directly by an OpenCV matrix header without copying.
+	 **/
 	class Image {
 	 public:
-	    Image(unsigned int width, unsigned int height, boost::interprocess::managed_shared_memory* segment);
-	
+	    // Empty image without pixels
+	    Image();
+
+	    /**
+	     * Image on pixel memory in shared memory of at least computeSize bytes, aligned on ALIGNMENT_IMAGE_ROW.
+	     *
+	     * @param width    The width in pixels
+	     * @param height   The height in pixels
+	     * @param channels The amount of bytes per pixel
+	     * @param pixels   The pixel memory in shared memory
+	     **/
+	    Image(unsigned int width, unsigned int height, unsigned int channels, unsigned char* pixels);
+
+			/**
+			 * Amount of bytes of pixel memory needed for an image.
+			 *
+			 * @param width    The width in pixels
+			 * @param height   The height in pixels
+			 * @param channels The amount of bytes per pixel
+			 * @return the stride times the height
+			 **/
+			static std::size_t computeSize(unsigned int width, unsigned int height, unsigned int channels);
+
 			inline const unsigned int getWidth() const {
 				return this->width;
 			}
 			inline const unsigned int getHeight() const {
 				return this->height;
 			}
-			
-			inline const unsigned char getRed(unsigned int x, unsigned int y) const {
-				return this->row_column_rgb->at((x * this->height + y) * 3);
+			inline const unsigned int getChannels() const {
+				return this->channels;
+			}
+			// Amount of bytes between the start of two rows
+			inline const unsigned int getStride() const {
+				return this->stride;
+			}
+
+			inline unsigned char* getData() {
+				return this->pixels.get();
 			}
-			inline const unsigned char getGreen(unsigned int x, unsigned int y) const {
-				return this->row_column_rgb->at((x * this->height + y) * 3 + 1);
+			inline const unsigned char* getData() const {
+				return this->pixels.get();
 			}
-			inline const unsigned char getBlue(unsigned int x, unsigned int y) const {
-				return this->row_column_rgb->at((x * this->height + y) * 3 + 2);
+
+			// Steady clock nanoseconds on which the scene displayed the image
+			inline long long getTimestampDisplay() const {
+				return this->timestamp_display;
 			}
-			
-			inline void setRGB(unsigned int x, unsigned int y, unsigned char red, unsigned char green, unsigned char blue) {
-				unsigned int offset = (x * this->height + y) * 3;
-				this->row_column_rgb->at(offset) = red;
-				this->row_column_rgb->at(offset + 1) = green;
-				this->row_column_rgb->at(offset + 2) = blue;
+			inline void setTimestampDisplay(long long timestamp_display) {
+				this->timestamp_display = timestamp_display;
 			}
+
+			/**
+			 * Copy all pixels from a row-major interleaved image with the same dimensions and channels.
+			 *
+			 * @param source        The first pixel of the source image
+			 * @param source_stride The amount of bytes between the start of two rows of the source image
+			 **/
+			void copyFrom(const unsigned char* source, unsigned int source_stride);
 	 
 	 private:
-			// all pixels
-	    boost::interprocess::offset_ptr<RowColumnGrey> row_column_rgb;
+			// all pixels, row after row
+	    boost::interprocess::offset_ptr<unsigned char> pixels;
 	
 	    // dimensions
-	    const unsigned int width;
-	    const unsigned int height;
+	    unsigned int width;
+	    unsigned int height;
+	    unsigned int channels;
+	    unsigned int stride;
+	    // steady clock nanoseconds on which the image is displayed
+	    long long timestamp_display;
 	};
 }
 
@@ -1,4 +1,4 @@
-#include "Image.hpp"
+#include "RGB.hpp"
 
 using namespace peopleextractor_interface_sma;
 
@@ -0,0 +1,163 @@
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <ctime>
+
+#include "SceneframeBuffer.hpp"
+
+using namespace peopleextractor_interface_sma;
+
+// Steady clock time in nanoseconds, which is the same clock in every process
+static long long nowNanoseconds() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Sleep while a futex word in shared memory still has a value, or till woken up or the timeout passed.
+ *
+ * @param word        The futex word
+ * @param value       The value to sleep on
+ * @param nanoseconds The maximum amount of nanoseconds to sleep
+ **/
+static void waitWord(std::atomic<unsigned int>& word, unsigned int value, long long nanoseconds) {
+	struct timespec timeout;
+	timeout.tv_sec = nanoseconds / 1000000000LL;
+	timeout.tv_nsec = nanoseconds % 1000000000LL;
+	// not private, the word is shared between processes; returns right away when the word already changed
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT, value, &timeout, NULL, 0);
+}
+
+/**
+ * Wake up a process sleeping on a futex word in shared memory.
+ *
+ * @param word The futex word
+ **/
+static void wakeWord(std::atomic<unsigned int>& word) {
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+SceneframeBuffer::SceneframeBuffer() :
+	generation(0),
+	latest(1),
+	index_back(0),
+	index_front(2),
+	set_front(0),
+	timestamp_published(0),
+	wakeups(0),
+	latency_wakeup_total(0),
+	latency_wakeup_maximum(0)
+{}
+
+bool SceneframeBuffer::allocate(unsigned int width, unsigned int height, unsigned int channels, boost::interprocess::offset_ptr<SharedMemoryArena> arena) {
+	const unsigned long long generation = this->generation.load(std::memory_order_relaxed);
+	if (generation != 0) {
+		const Image& image = this->images[generation % 2][0];
+		if (image.getWidth() == width && image.getHeight() == height && image.getChannels() == channels) {
+			return true;
+		}
+		// set of the next generation is still read by the consumer until it acknowledged the current one
+		if (this->arena->getAcknowledged() < generation) {
+			return false;
+		}
+	}
+	// take back the slabs of generations the consumer is done with
+	arena->reclaim();
+	if (arena->getFree() < IMAGES_SCENEFRAME_BUFFER) {
+		return false;
+	}
+	const unsigned long long generation_next = generation + 1;
+	const std::size_t size = Image::computeSize(width, height, channels);
+	for (unsigned int i = 0; i < IMAGES_SCENEFRAME_BUFFER; ++i) {
+		unsigned char* pixels = static_cast<unsigned char*>(arena->allocate(size, generation_next));
+		// all images have the same size, so only the first one can fail to fit while enough slabs are free
+		if (pixels == NULL) {
+			return false;
+		}
+		this->images[generation_next % 2][i] = Image(width, height, channels, pixels);
+	}
+	this->arena = arena;
+	// release so the consumer sees the new images
+	this->generation.store(generation_next, std::memory_order_release);
+	return true;
+}
+
+bool SceneframeBuffer::isAllocated() const {
+	return this->generation.load(std::memory_order_acquire) != 0;
+}
+
+Image& SceneframeBuffer::back() {
+	return this->images[this->generation.load(std::memory_order_relaxed) % 2][this->index_back];
+}
+
+void SceneframeBuffer::publish() {
+	// hand written image over as latest and take the previous latest to write the next one in
+	this->timestamp_published.store(nowNanoseconds(), std::memory_order_relaxed);
+	const unsigned int set_back = this->generation.load(std::memory_order_relaxed) % 2 == 1 ? FLAG_SET_ODD : 0;
+	const unsigned int previous = this->latest.exchange(this->index_back | set_back | FLAG_NEW, std::memory_order_acq_rel);
+	this->index_back = previous & MASK_INDEX;
+	// take back the slabs of generations the consumer acknowledged it is done with since the last publish
+	this->arena->reclaim();
+	// wake up consumer, which does not fall asleep anymore when it did not yet as the latest index changed
+	wakeWord(this->latest);
+}
+
+bool SceneframeBuffer::acquire() {
+	if ((this->latest.load(std::memory_order_relaxed) & FLAG_NEW) == 0) {
+		return false;
+	}
+	// hand read image back and take the latest
+	const unsigned int previous = this->latest.exchange(this->index_front, std::memory_order_acq_rel);
+	this->index_front = previous & MASK_INDEX;
+	this->set_front = (previous & FLAG_SET_ODD) != 0 ? 1 : 0;
+	// acknowledge the generation once its images are read, so the slabs of older generations can be reclaimed
+	const unsigned long long generation = this->generation.load(std::memory_order_acquire);
+	if (generation % 2 == this->set_front) {
+		this->arena->acknowledge(generation);
+	}
+	return true;
+}
+
+bool SceneframeBuffer::waitAndAcquire(unsigned int timeout_ms) {
+	unsigned int latest = this->latest.load(std::memory_order_relaxed);
+	if ((latest & FLAG_NEW) == 0) {
+		// steady clock deadline, so changing the wall clock does not change the timeout
+		const long long timeout = nowNanoseconds() + timeout_ms * 1000000LL;
+		while ((latest & FLAG_NEW) == 0) {
+			const long long nanoseconds_left = timeout - nowNanoseconds();
+			if (nanoseconds_left <= 0) {
+				return false;
+			}
+			waitWord(this->latest, latest, nanoseconds_left);
+			latest = this->latest.load(std::memory_order_relaxed);
+		}
+		// measure time between publishing and waking up
+		const long long latency_wakeup = nowNanoseconds() - this->timestamp_published.load(std::memory_order_relaxed);
+		++this->wakeups;
+		this->latency_wakeup_total += latency_wakeup;
+		if (latency_wakeup > this->latency_wakeup_maximum) {
+			this->latency_wakeup_maximum = latency_wakeup;
+		}
+	}
+	return this->acquire();
+}
+
+const Image& SceneframeBuffer::front() const {
+	return this->images[this->set_front][this->index_front];
+}
+
+unsigned long long SceneframeBuffer::getGeneration() const {
+	return this->generation.load(std::memory_order_relaxed);
+}
+
+unsigned long long SceneframeBuffer::getWakeups() const {
+	return this->wakeups;
+}
+
+long long SceneframeBuffer::getWakeupLatencyAverage() const {
+	return this->wakeups == 0 ? 0 : this->latency_wakeup_total / (long long) this->wakeups;
+}
+
+long long SceneframeBuffer::getWakeupLatencyMaximum() const {
+	return this->latency_wakeup_maximum;
+}
@@ -0,0 +1,114 @@
+#ifndef PEOPLEEXTRACTORINTERFACESMA_SCENEFRAMEBUFFER_H
+#define PEOPLEEXTRACTORINTERFACESMA_SCENEFRAMEBUFFER_H
+
+#include <boost/interprocess/offset_ptr.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <atomic>
+
+#include "Image.hpp"
+#include "SharedMemoryArena.hpp"
+
+namespace peopleextractor_interface_sma {
+	const char* const NAME_SCENEFRAME_BUFFER = "SceneframeBuffer";
+
+	// Amount of images in the buffer: one written by the scene, one read by the people extractor and one latest in between
+	const unsigned int IMAGES_SCENEFRAME_BUFFER = 3;
+
+	/**
+	 * Lock-free triple buffer of scene frames from the scene (producer) to the people extractor (consumer).
+	 * The producer never waits for the consumer and the consumer always gets the latest published frame.
+	 * The images are allocated by the producer from the arena when the frame size is known. When the frame size changes,
+	 * a new generation of images is allocated and the slabs of the old generation go back to the arena on the first publish
+	 * after the consumer acknowledged the new generation.
+	 * The consumer can sleep until a frame is published instead of polling. It sleeps on the latest index itself with a futex,
+	 * so no lock is shared between the processes: a process killed by the supervisor can not leave the buffer locked, and
+	 * a consumer killed while sleeping does not block later notifications like it would with a process shared condition.
+	 **/
+	class SceneframeBuffer {
+	 public:
+			SceneframeBuffer();
+
+			/**
+			 * Allocate a generation of images from the arena, does nothing when already allocated with the same size.
+			 *
+			 * @param width    The width in pixels of the scene frames
+			 * @param height   The height in pixels of the scene frames
+			 * @param channels The amount of bytes per pixel of the scene frames
+			 * @param arena    The arena to allocate the pixels of the images from
+			 * @return false when the images can not be allocated, because the arena has no free slabs, the images do not fit
+			 *         in its slabs, which the arena reports, or the consumer did not acknowledge the current generation yet
+			 **/
+			bool allocate(unsigned int width, unsigned int height, unsigned int channels, boost::interprocess::offset_ptr<SharedMemoryArena> arena);
+
+			// Whether the images are allocated and can be used
+			bool isAllocated() const;
+
+			// Gets the image for the producer to write the next scene frame in
+			Image& back();
+
+			// Publish the image given by back as latest scene frame, and take back the slabs the consumer is done with
+			void publish();
+
+			/**
+			 * Take the latest published scene frame for the consumer, which stays valid until the next successful acquire.
+			 *
+			 * @return false when no new scene frame is published since the last acquire
+			 **/
+			bool acquire();
+
+			/**
+			 * Sleep until a new scene frame is published and take it like acquire.
+			 *
+			 * @param timeout_ms The maximum amount of milliseconds to sleep
+			 * @return false when no new scene frame is published within the timeout
+			 **/
+			bool waitAndAcquire(unsigned int timeout_ms);
+
+			// Gets the image taken by the consumer by acquire
+			const Image& front() const;
+
+			// Gets the generation of the allocated images, 0 when not allocated
+			unsigned long long getGeneration() const;
+
+			// Amount of times the consumer woke up for a published scene frame
+			unsigned long long getWakeups() const;
+			// Average nanoseconds between publishing and the consumer waking up
+			long long getWakeupLatencyAverage() const;
+			// Maximum nanoseconds between publishing and the consumer waking up
+			long long getWakeupLatencyMaximum() const;
+
+	 private:
+			static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory buffer requires lock-free atomics");
+			static_assert(sizeof(std::atomic<unsigned int>) == sizeof(int), "Latest index is slept on as a futex word");
+
+			// index of the latest image in the lower bits, whether it is new since the last acquire
+			// and of which of both sets of images, the set of even or odd generations
+			static const unsigned int FLAG_NEW = 1 << 2;
+			static const unsigned int FLAG_SET_ODD = 1 << 3;
+			static const unsigned int MASK_INDEX = FLAG_NEW - 1;
+
+			// generation of the images the producer writes in, 0 when not allocated
+			std::atomic<unsigned long long> generation;
+			// index of latest image, new flag and set flag, exchanged between producer and consumer; the consumer sleeps on its change
+			std::atomic<unsigned int> latest;
+			// index of image owned by producer
+			unsigned int index_back;
+			// index and set of image owned by consumer
+			unsigned int index_front;
+			unsigned int set_front;
+
+			// images of the current and previous generation, so the consumer can finish reading an old one
+			Image images[2][IMAGES_SCENEFRAME_BUFFER];
+			// arena the pixels of the images are allocated from
+			boost::interprocess::offset_ptr<SharedMemoryArena> arena;
+
+			// steady clock nanoseconds on which the latest scene frame is published
+			std::atomic<long long> timestamp_published;
+			// wakeup latency statistics, only written by consumer
+			unsigned long long wakeups;
+			long long latency_wakeup_total;
+			long long latency_wakeup_maximum;
+	};
+}
+
+#endif //PEOPLEEXTRACTORINTERFACESMA_SCENEFRAMEBUFFER_H
@@ -1 +0,0 @@
-#include "SceneframeQueue.hpp"
@@ -0,0 +1,107 @@
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "SharedMemoryArena.hpp"
+
+using namespace peopleextractor_interface_sma;
+
+SharedMemoryArena::SharedMemoryArena(std::size_t size_slab, unsigned int amount_slabs, boost::interprocess::managed_shared_memory* segment) :
+	// round slab size up to the slab alignment
+	size_slab(((size_slab + ALIGNMENT_SLAB - 1) / ALIGNMENT_SLAB) * ALIGNMENT_SLAB),
+	amount_slabs(amount_slabs < MAXIMUM_SLABS ? amount_slabs : MAXIMUM_SLABS),
+	size_rejected(0),
+	acknowledged(0),
+	amount_used(0),
+	high_water(0)
+{
+	this->memory = static_cast<unsigned char*>(segment->allocate_aligned(this->size_slab * this->amount_slabs, ALIGNMENT_SLAB));
+	// prefault by writing all slabs once
+	std::memset(this->memory.get(), 0, this->size_slab * this->amount_slabs);
+	for (unsigned int i = 0; i < MAXIMUM_SLABS; ++i) {
+		this->used[i] = false;
+		this->generations[i] = 0;
+	}
+}
+
+void* SharedMemoryArena::allocate(std::size_t size, unsigned long long generation) {
+	if (size > this->size_slab) {
+		if (size != this->size_rejected) {
+			std::cerr << "Shared memory arena can not allocate " << size << " bytes in slabs of " << this->size_slab << " bytes" << std::endl;
+			this->size_rejected = size;
+		}
+		return NULL;
+	}
+	for (unsigned int i = 0; i < this->amount_slabs; ++i) {
+		if (!this->used[i]) {
+			this->used[i] = true;
+			this->generations[i] = generation;
+			const unsigned int amount_used = this->amount_used.fetch_add(1, std::memory_order_relaxed) + 1;
+			if (amount_used > this->high_water.load(std::memory_order_relaxed)) {
+				this->high_water.store(amount_used, std::memory_order_relaxed);
+			}
+			return this->memory.get() + i * this->size_slab;
+		}
+	}
+	return NULL;
+}
+
+void SharedMemoryArena::acknowledge(unsigned long long generation) {
+	this->acknowledged.store(generation, std::memory_order_release);
+}
+
+unsigned int SharedMemoryArena::reclaim() {
+	// acquire so the consumer is done with the slabs before they are handed out again
+	const unsigned long long acknowledged = this->acknowledged.load(std::memory_order_acquire);
+	unsigned int amount_reclaimed = 0;
+	for (unsigned int i = 0; i < this->amount_slabs; ++i) {
+		if (this->used[i] && this->generations[i] < acknowledged) {
+			this->used[i] = false;
+			++amount_reclaimed;
+		}
+	}
+	this->amount_used.fetch_sub(amount_reclaimed, std::memory_order_relaxed);
+	return amount_reclaimed;
+}
+
+std::size_t SharedMemoryArena::getSizeSlab() const {
+	return this->size_slab;
+}
+unsigned int SharedMemoryArena::getAmountSlabs() const {
+	return this->amount_slabs;
+}
+unsigned int SharedMemoryArena::getUsed() const {
+	return this->amount_used.load(std::memory_order_relaxed);
+}
+unsigned int SharedMemoryArena::getFree() const {
+	return this->amount_slabs - this->getUsed();
+}
+unsigned int SharedMemoryArena::getHighWater() const {
+	return this->high_water.load(std::memory_order_relaxed);
+}
+unsigned long long SharedMemoryArena::getAcknowledged() const {
+	return this->acknowledged.load(std::memory_order_relaxed);
+}
+
+bool SharedMemoryArena::prefault(boost::interprocess::managed_shared_memory* segment, bool lock) {
+	volatile unsigned char* address = static_cast<volatile unsigned char*>(segment->get_address());
+	const std::size_t size = segment->get_size();
+	if (lock) {
+		// locking faults in all pages as well
+		if (mlock(const_cast<unsigned char*>(address), size) != 0) {
+			std::cerr << "Failed locking shared memory in memory: " << std::strerror(errno) << std::endl;
+			return false;
+		}
+		return true;
+	}
+	// read one byte of every page to fault it in without changing the segment
+	const std::size_t size_page = sysconf(_SC_PAGESIZE);
+	unsigned char touched = 0;
+	for (std::size_t offset = 0; offset < size; offset += size_page) {
+		touched ^= address[offset];
+	}
+	(void) touched;
+	return true;
+}
@@ -0,0 +1,100 @@
+#ifndef PEOPLEEXTRACTORINTERFACESMA_SHAREDMEMORYARENA_H
+#define PEOPLEEXTRACTORINTERFACESMA_SHAREDMEMORYARENA_H
+
+#include <boost/interprocess/offset_ptr.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <atomic>
+#include <cstddef>
+
+namespace peopleextractor_interface_sma {
+	const char* const NAME_SHARED_MEMORY_ARENA = "ImoveArena";
+
+	/**
+	 * Fixed-size slab allocator inside the shared memory segment for per-frame IPC payloads.
+	 * All slabs are allocated and prefaulted once, the producer tags each slab it takes with the generation of the frame it
+	 * belongs to and gets the slab back once the consumer acknowledged a newer generation. Usage statistics live in the
+	 * segment so every process can read them.
+	 **/
+	class SharedMemoryArena {
+		public:
+			// Maximum amount of slabs in one arena
+			static const unsigned int MAXIMUM_SLABS = 16;
+			// Alignment of every slab
+			static const unsigned int ALIGNMENT_SLAB = 64;
+
+			/**
+			 * Allocate and prefault all slabs in the segment.
+			 *
+			 * @param size_slab    The amount of bytes of one slab
+			 * @param amount_slabs The amount of slabs, at most MAXIMUM_SLABS
+			 * @param segment      The shared memory segment to allocate the slabs in
+			 **/
+			SharedMemoryArena(std::size_t size_slab, unsigned int amount_slabs, boost::interprocess::managed_shared_memory* segment);
+
+			/**
+			 * Take a free slab for the producer. A size larger than the slabs is reported once per size.
+			 *
+			 * @param size       The amount of bytes needed, at most the size of a slab
+			 * @param generation The generation of the frame the slab is used for
+			 * @return the slab or NULL when all slabs are in use or the size does not fit in a slab
+			 **/
+			void* allocate(std::size_t size, unsigned long long generation);
+
+			/**
+			 * Acknowledge by the consumer that it does not use slabs of older generations anymore.
+			 *
+			 * @param generation The oldest generation still in use by the consumer
+			 **/
+			void acknowledge(unsigned long long generation);
+
+			/**
+			 * Free all slabs of generations older than the acknowledged generation, only called by the producer.
+			 *
+			 * @return the amount of freed slabs
+			 **/
+			unsigned int reclaim();
+
+			std::size_t getSizeSlab() const;
+			unsigned int getAmountSlabs() const;
+			// Amount of slabs in use
+			unsigned int getUsed() const;
+			// Amount of slabs free
+			unsigned int getFree() const;
+			// Maximum amount of slabs in use at the same time
+			unsigned int getHighWater() const;
+			// Oldest generation still in use by the consumer
+			unsigned long long getAcknowledged() const;
+
+			/**
+			 * Fault in all pages of the segment in this process so the first frames do not pay for page faults.
+			 *
+			 * @param segment The shared memory segment
+			 * @param lock    Whether to also lock the pages in memory so they are never swapped out
+			 * @return false when locking is requested but failed, for example because of RLIMIT_MEMLOCK
+			 **/
+			static bool prefault(boost::interprocess::managed_shared_memory* segment, bool lock);
+
+		private:
+			static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory arena requires lock-free atomics");
+
+			const std::size_t size_slab;
+			const unsigned int amount_slabs;
+			// start of all slabs, slab after slab
+			boost::interprocess::offset_ptr<unsigned char> memory;
+
+			// per slab whether in use and for which generation, only accessed by producer
+			bool used[MAXIMUM_SLABS];
+			unsigned long long generations[MAXIMUM_SLABS];
+
+			// last size which did not fit in a slab, so it is only reported once, only accessed by producer
+			std::size_t size_rejected;
+
+			// oldest generation still in use by the consumer
+			std::atomic<unsigned long long> acknowledged;
+			// statistics
+			std::atomic<unsigned int> amount_used;
+			std::atomic<unsigned int> high_water;
+	};
+}
+
+#endif //PEOPLEEXTRACTORINTERFACESMA_SHAREDMEMORYARENA_H
@@ -6,12 +6,16 @@ Person::Person(
 	unsigned int id,
 	Location location,
 	Person::PersonType person_type,
-	Person::MovementType movement_type
+	Person::MovementType movement_type,
+	Location velocity,
+	long long timestamp_capture
 ) :
 	id(id),
 	location(location),
 	person_type(person_type),
-	movement_type(movement_type)
+	movement_type(movement_type),
+	velocity(velocity),
+	timestamp_capture(timestamp_capture)
 { }
 
 const unsigned int Person::getId() const {
@@ -29,3 +33,11 @@ const Person::PersonType Person::getPersonType() const {
 const Person::MovementType Person::getMovementType() const {
 	return this->movement_type;
 }
+
+const Location Person::getVelocity() const {
+	return this->velocity;
+}
+
+const long long Person::getTimestampCapture() const {
+	return this->timestamp_capture;
+}
@@ -18,13 +18,17 @@ namespace scene_interface {
 			Moving
 		};
 
-		Person(unsigned int id, Location location, Person::PersonType person_type, Person::MovementType movement_type);
+		Person(unsigned int id, Location location, Person::PersonType person_type, Person::MovementType movement_type, Location velocity = Location(0, 0), long long timestamp_capture = 0);
 
 	    //Getters
 	    const unsigned int getId() const;
 	    const Location getLocation() const;
 			const Person::PersonType getPersonType() const;
 			const Person::MovementType getMovementType() const;
+			// Velocity in pixels per second, so the scene can compensate for the time it takes to extract people
+			const Location getVelocity() const;
+			// Steady clock time in nanoseconds on which the camera frame the person is extracted from is captured, 0 when unknown
+			const long long getTimestampCapture() const;
 	 private:
 	    // Id
 	    unsigned int id;
@@ -38,6 +42,12 @@ namespace scene_interface {
 
 		// Movement type
 		MovementType movement_type;
+
+		// Velocity in pixels per second
+		Location velocity;
+
+		// Steady clock nanoseconds of the capture of the camera frame
+		long long timestamp_capture;
 	};
 }
 
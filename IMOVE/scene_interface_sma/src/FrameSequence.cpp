@@ -0,0 +1,11 @@
+#include "FrameSequence.hpp"
+
+using namespace scene_interface_sma;
+
+FrameSequence::FrameSequence() :
+	last(0)
+{}
+
+unsigned long long FrameSequence::next() {
+	return this->last.fetch_add(1, std::memory_order_relaxed) + 1;
+}
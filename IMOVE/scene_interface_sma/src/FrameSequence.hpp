@@ -0,0 +1,28 @@
+#ifndef SCENEINTERFACESMA_FRAMESEQUENCE_H
+#define SCENEINTERFACESMA_FRAMESEQUENCE_H
+
+#include <atomic>
+
+namespace scene_interface_sma {
+	const char* const NAME_FRAME_SEQUENCE = "FrameSequence";
+
+	/**
+	 * Sequence of camera frames in shared memory, kept by the imove process for the lifetime of the segment.
+	 * A restarted people extractor continues numbering where the previous one stopped, so the scene and the trace never
+	 * see the sequence go back.
+	 **/
+	class FrameSequence {
+	 public:
+			FrameSequence();
+
+			// Gets the sequence of the next camera frame, the first one is 1
+			unsigned long long next();
+
+	 private:
+			static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory frame sequence requires lock-free atomics");
+
+			std::atomic<unsigned long long> last;
+	};
+}
+
+#endif //SCENEINTERFACESMA_FRAMESEQUENCE_H
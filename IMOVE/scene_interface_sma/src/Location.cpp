@@ -2,6 +2,8 @@
 
 using namespace scene_interface_sma;
 
+Location::Location() : x(0), y(0) {}
+
 Location::Location(float x, float y) : x(x), y(y) {}
 
 float Location::getX() const {
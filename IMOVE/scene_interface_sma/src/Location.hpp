@@ -1,8 +1,10 @@
-#include <boost/interprocess/offset_ptr.hpp>
+#ifndef SCENEINTERFACESMA_LOCATION_H
+#define SCENEINTERFACESMA_LOCATION_H
 
 namespace scene_interface_sma {
 	class Location {
 		public:
+			Location();
 			Location(float x, float y);
 		
 			float getX() const;
@@ -12,3 +14,5 @@ namespace scene_interface_sma {
 			float x,y;
 	};
 }
+
+#endif //SCENEINTERFACESMA_LOCATION_H
@@ -1 +0,0 @@
-#include "Locations.hpp"
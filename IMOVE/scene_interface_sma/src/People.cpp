@@ -1 +1,46 @@
+#include <assert.h>
+
 #include "People.hpp"
+
+using namespace scene_interface_sma;
+
+People::People() : sequence(0), timestamp_capture(0), amount(0) {}
+
+void People::clear() {
+	this->amount = 0;
+}
+
+bool People::push_back(const Person& person) {
+	if (this->amount >= MAXIMUM_PEOPLE) {
+		return false;
+	}
+	this->people[this->amount] = person;
+	++this->amount;
+	return true;
+}
+
+unsigned int People::size() const {
+	return this->amount;
+}
+
+bool People::empty() const {
+	return this->amount == 0;
+}
+
+const Person& People::at(unsigned int index) const {
+	assert(index < this->amount);
+	return this->people[index];
+}
+
+void People::setFrame(unsigned long long sequence, long long timestamp_capture) {
+	this->sequence = sequence;
+	this->timestamp_capture = timestamp_capture;
+}
+
+unsigned long long People::getSequence() const {
+	return this->sequence;
+}
+
+long long People::getTimestampCapture() const {
+	return this->timestamp_capture;
+}
@@ -1,16 +1,52 @@
-#include <boost/interprocess/offset_ptr.hpp>
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/containers/vector.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
+#ifndef SCENEINTERFACESMA_PEOPLE_H
+#define SCENEINTERFACESMA_PEOPLE_H
 
 #include "Person.hpp"
 
 namespace scene_interface_sma {
-	//Define an STL compatible allocator of ints that allocates from the managed_shared_memory.
-	//This allocator will allow placing containers in the segment
-	typedef boost::interprocess::allocator<boost::interprocess::offset_ptr<scene_interface_sma::Person>, boost::interprocess::managed_shared_memory::segment_manager> PeopleSMA;
-	
-	//Alias a vector that uses the previous STL-like allocator so that allocates
-	//its values from the segment
-	typedef boost::interprocess::vector<boost::interprocess::offset_ptr<scene_interface_sma::Person>, PeopleSMA> People;
+	// Maximum amount of people which fit in one extracted people frame
+	const unsigned int MAXIMUM_PEOPLE = 256;
+
+	// Fixed capacity frame of extracted people, never allocates so it can live in a preallocated shared memory slot
+	class People {
+	 public:
+			People();
+
+			// Remove all people from the frame
+			void clear();
+
+			/**
+			 * Add person to the frame.
+			 *
+			 * @param person The person to add
+			 * @return false when the frame is full and the person is not added
+			 **/
+			bool push_back(const Person& person);
+
+			unsigned int size() const;
+			bool empty() const;
+			const Person& at(unsigned int index) const;
+
+			/**
+			 * Sets the number of the camera frame and the time the camera frame is captured from which the people are extracted.
+			 *
+			 * @param sequence          The increasing number of the camera frame
+			 * @param timestamp_capture The steady clock time in nanoseconds on which the camera frame is captured
+			 **/
+			void setFrame(unsigned long long sequence, long long timestamp_capture);
+			unsigned long long getSequence() const;
+			long long getTimestampCapture() const;
+
+	 private:
+			// increasing number of the camera frame the people are extracted from
+			unsigned long long sequence;
+			// steady clock time in nanoseconds on which the camera frame is captured, comparable between processes
+			long long timestamp_capture;
+			// amount of people in the frame
+			unsigned int amount;
+			// all people, only the first amount are valid
+			Person people[MAXIMUM_PEOPLE];
+	};
 }
+
+#endif //SCENEINTERFACESMA_PEOPLE_H
@@ -1 +1,46 @@
+#include <cstddef>
+
 #include "PeopleQueue.hpp"
+
+using namespace scene_interface_sma;
+
+PeopleQueue::PeopleQueue() : head(0), tail(0), dropped(0) {}
+
+People* PeopleQueue::back() {
+	const unsigned int tail = this->tail.load(std::memory_order_relaxed);
+	// acquire so the consumer finished reading the slot before it is overwritten
+	const unsigned int head = this->head.load(std::memory_order_acquire);
+	if (tail - head >= CAPACITY_PEOPLE_QUEUE) {
+		return NULL;
+	}
+	return &this->slots[tail % CAPACITY_PEOPLE_QUEUE];
+}
+
+void PeopleQueue::push() {
+	// release so the filled slot is visible before the consumer sees the new tail
+	this->tail.store(this->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void PeopleQueue::drop() {
+	this->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool PeopleQueue::empty() const {
+	return this->head.load(std::memory_order_relaxed) == this->tail.load(std::memory_order_acquire);
+}
+
+const People& PeopleQueue::front() const {
+	return this->slots[this->head.load(std::memory_order_relaxed) % CAPACITY_PEOPLE_QUEUE];
+}
+
+void PeopleQueue::pop() {
+	this->head.store(this->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+unsigned int PeopleQueue::size() const {
+	return this->tail.load(std::memory_order_acquire) - this->head.load(std::memory_order_relaxed);
+}
+
+unsigned long long PeopleQueue::getDropped() const {
+	return this->dropped.load(std::memory_order_relaxed);
+}
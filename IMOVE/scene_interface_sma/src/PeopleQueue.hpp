@@ -1,19 +1,71 @@
-#include <boost/interprocess/offset_ptr.hpp>
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/containers/vector.hpp>
-#include <boost/interprocess/containers/deque.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
+#ifndef SCENEINTERFACESMA_PEOPLEQUEUE_H
+#define SCENEINTERFACESMA_PEOPLEQUEUE_H
+
+#include <atomic>
 
 #include "People.hpp"
 
 namespace scene_interface_sma {
 	const char* const NAME_PEOPLE_QUEUE = "PeopleQueue";
-	
-	//Define an STL compatible allocator of ints that allocates from the managed_shared_memory.
-	//This allocator will allow placing containers in the segment
-	typedef boost::interprocess::allocator<boost::interprocess::offset_ptr<People>, boost::interprocess::managed_shared_memory::segment_manager> PeopleQueueSMA;
-	
-	//Alias a vector that uses the previous STL-like allocator so that allocates
-	//its values from the segment
-	typedef boost::interprocess::deque<boost::interprocess::offset_ptr<People>, PeopleQueueSMA> PeopleQueue;
+
+	// Amount of preallocated people frames in the queue, power of two so the free running indices wrap correctly
+	const unsigned int CAPACITY_PEOPLE_QUEUE = 16;
+	// Size of a cache line, head and tail are kept on separate lines so producer and consumer do not invalidate each other
+	const unsigned int SIZE_CACHE_LINE = 64;
+
+	/**
+	 * Lock-free single producer (people extractor) single consumer (scene) ring of people frames.
+	 * All slots are constructed together with the queue in shared memory, pushing and popping never allocates from the segment.
+	 * The indices are lock-free atomics which are address free and therefore valid between processes.
+	 **/
+	class PeopleQueue {
+	 public:
+			PeopleQueue();
+
+			/**
+			 * Gets the slot to fill by the producer, which is published by push.
+			 *
+			 * @return the free slot or NULL when the queue is full
+			 **/
+			People* back();
+
+			// Publish the slot given by back to the consumer
+			void push();
+
+			// Count a frame which the producer could not push because the queue is full
+			void drop();
+
+			// Whether there is no frame to pop for the consumer
+			bool empty() const;
+
+			// Gets the oldest published frame, only valid when not empty
+			const People& front() const;
+
+			// Release the oldest published frame back to the producer
+			void pop();
+
+			// Amount of published frames not yet popped
+			unsigned int size() const;
+
+			// Amount of frames dropped since construction
+			unsigned long long getDropped() const;
+
+	 private:
+			static_assert((CAPACITY_PEOPLE_QUEUE & (CAPACITY_PEOPLE_QUEUE - 1)) == 0, "Capacity people queue should be a power of two");
+			static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory queue requires lock-free atomics");
+
+			// index of next frame to pop, only written by consumer
+			std::atomic<unsigned int> head;
+			char padding_head[SIZE_CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+			// index of next frame to push, only written by producer
+			std::atomic<unsigned int> tail;
+			char padding_tail[SIZE_CACHE_LINE - sizeof(std::atomic<unsigned int>)];
+			// amount of dropped frames, only written by producer
+			std::atomic<unsigned long long> dropped;
+
+			// preallocated frames
+			People slots[CAPACITY_PEOPLE_QUEUE];
+	};
 }
+
+#endif //SCENEINTERFACESMA_PEOPLEQUEUE_H
@@ -0,0 +1,43 @@
+#include "PeopleSnapshot.hpp"
+
+using namespace scene_interface_sma;
+
+PeopleSnapshot::PeopleSnapshot() : latest(BUFFERS_PEOPLE_SNAPSHOT) {
+	this->locks[0].store(0);
+	this->locks[1].store(0);
+}
+
+People& PeopleSnapshot::beginWrite() {
+	const unsigned int latest = this->latest.load(std::memory_order_relaxed);
+	const unsigned int writing = latest == 0 ? 1 : 0;
+	// mark buffer as being written before touching it, already marked when a restarted writer was killed while writing
+	this->locks[writing].fetch_or(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	return this->buffers[writing];
+}
+
+void PeopleSnapshot::endWrite() {
+	const unsigned int latest = this->latest.load(std::memory_order_relaxed);
+	const unsigned int writing = latest == 0 ? 1 : 0;
+	// release written buffer and make it the latest
+	this->locks[writing].fetch_add(1, std::memory_order_release);
+	this->latest.store(writing, std::memory_order_release);
+}
+
+bool PeopleSnapshot::read(People& people) const {
+	while (true) {
+		const unsigned int latest = this->latest.load(std::memory_order_acquire);
+		if (latest >= BUFFERS_PEOPLE_SNAPSHOT) {
+			return false;
+		}
+		const unsigned int lock_before = this->locks[latest].load(std::memory_order_acquire);
+		if (lock_before % 2 == 0) {
+			people = this->buffers[latest];
+			std::atomic_thread_fence(std::memory_order_acquire);
+			// valid copy when producer did not start writing this buffer in the meantime
+			if (this->locks[latest].load(std::memory_order_relaxed) == lock_before) {
+				return true;
+			}
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#ifndef SCENEINTERFACESMA_PEOPLESNAPSHOT_H
+#define SCENEINTERFACESMA_PEOPLESNAPSHOT_H
+
+#include <atomic>
+
+#include "People.hpp"
+
+namespace scene_interface_sma {
+	const char* const NAME_PEOPLE_SNAPSHOT = "PeopleSnapshot";
+
+	// Amount of people buffers in the snapshot
+	const unsigned int BUFFERS_PEOPLE_SNAPSHOT = 2;
+
+	/**
+	 * Latest value of extracted people, the alternative to PeopleQueue when only the newest frame matters.
+	 * The producer (people extractor) writes the buffer which is not the latest, the consumer (scene) copies the latest.
+	 * Each buffer is protected by a sequence lock; the consumer retries only when the producer wrote two frames during its copy.
+	 **/
+	class PeopleSnapshot {
+	 public:
+			PeopleSnapshot();
+
+			// Gets the buffer to fill by the producer, which is published by endWrite
+			People& beginWrite();
+
+			// Publish the buffer given by beginWrite as latest
+			void endWrite();
+
+			/**
+			 * Copy the latest published people.
+			 *
+			 * @param people The output copy of the latest people
+			 * @return false when nothing is published yet
+			 **/
+			bool read(People& people) const;
+
+	 private:
+			static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory snapshot requires lock-free atomics");
+
+			// index of the latest published buffer or BUFFERS_PEOPLE_SNAPSHOT when nothing is published yet
+			std::atomic<unsigned int> latest;
+			// per buffer sequence lock, odd while being written
+			std::atomic<unsigned int> locks[BUFFERS_PEOPLE_SNAPSHOT];
+			// double buffered people
+			People buffers[BUFFERS_PEOPLE_SNAPSHOT];
+	};
+}
+
+#endif //SCENEINTERFACESMA_PEOPLESNAPSHOT_H
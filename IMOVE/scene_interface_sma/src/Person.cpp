@@ -2,18 +2,27 @@
 
 using namespace scene_interface_sma;
 
-Person::Person(boost::interprocess::offset_ptr<Locations> locations, Person::PersonType person_type, Person::MovementType movement_type, unsigned int id) :
-	locations(locations),
+Person::Person() :
+	location(Location()),
+	person_type(Person::PersonType::None),
+	movement_type(Person::MovementType::StandingStill),
+	id(0),
+	velocity(Location())
+{ }
+
+Person::Person(const Location& location, Person::PersonType person_type, Person::MovementType movement_type, unsigned int id, const Location& velocity) :
+	location(location),
 	person_type(person_type),
 	movement_type(movement_type),
-	id(id)
+	id(id),
+	velocity(velocity)
 { }
 
 /*--------------------
  * Getters
  * -----------------*/
-const boost::interprocess::offset_ptr<Locations> Person::getLocations() const {
-  return this->locations;
+const Location Person::getLocation() const {
+  return this->location;
 }
 
 const unsigned int Person::getId() const {
@@ -27,3 +36,7 @@ const Person::PersonType Person::getPersonType() const {
 const Person::MovementType Person::getMovementType() const {
   return this->movement_type;
 }
+
+const Location Person::getVelocity() const {
+  return this->velocity;
+}
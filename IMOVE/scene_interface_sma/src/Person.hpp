@@ -1,11 +1,10 @@
-#include <boost/interprocess/offset_ptr.hpp>
-#include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/containers/vector.hpp>
-#include <boost/interprocess/allocators/allocator.hpp>
+#ifndef SCENEINTERFACESMA_PERSON_H
+#define SCENEINTERFACESMA_PERSON_H
 
-#include "Locations.hpp"
+#include "Location.hpp"
 
 namespace scene_interface_sma {
+	// Extracted person stored by value so it can be copied into preallocated shared memory slots
 	class Person {
 	 public:
 			enum PersonType{
@@ -19,25 +18,33 @@ namespace scene_interface_sma {
 				Moving
 			};
 
-	    Person(boost::interprocess::offset_ptr<Locations> locations, PersonType person_type, MovementType movement_type, unsigned int id);
+	    Person();
+	    Person(const Location& location, PersonType person_type, MovementType movement_type, unsigned int id, const Location& velocity = Location());
 
 	    //Getters
-	    const boost::interprocess::offset_ptr<Locations> getLocations() const;
+	    const Location getLocation() const;
 	    const unsigned int getId() const;
 	    const PersonType getPersonType() const;
 	    const MovementType getMovementType() const;
+	    // Velocity in pixels per second
+	    const Location getVelocity() const;
 
 	 private:
-	    // List of previous locations
-	    const boost::interprocess::offset_ptr<Locations> locations;
+	    // Current location
+	    Location location;
 
 			// Person Type
-			const PersonType person_type;
+			PersonType person_type;
 
 			// Movement Type
-			const MovementType movement_type;
+			MovementType movement_type;
 
 	    // Id
-	    const unsigned int id;
+	    unsigned int id;
+
+	    // Velocity in pixels per second
+	    Location velocity;
 	};
 }
+
+#endif //SCENEINTERFACESMA_PERSON_H
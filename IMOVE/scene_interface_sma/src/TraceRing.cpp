@@ -0,0 +1,69 @@
+#include <chrono>
+
+#include "TraceRing.hpp"
+
+using namespace scene_interface_sma;
+
+const char* const scene_interface_sma::NAMES_TRACE_STAGES[AMOUNT_TRACE_STAGES] = {
+	"capture",
+	"resize",
+	"eliminate projection",
+	"detect",
+	"match",
+	"project people",
+	"publish",
+	"consume",
+	"update",
+	"render",
+	"display"
+};
+
+TraceRing::TraceRing() : recorded(0) {
+	for (unsigned int i = 0; i < CAPACITY_TRACE_RING; ++i) {
+		this->slots[i].stamp.store(0, std::memory_order_relaxed);
+	}
+}
+
+void TraceRing::record(unsigned long long sequence, TraceStage stage, long long timestamp) {
+	// claim slot, overwriting the oldest record
+	const unsigned long long index = this->recorded.fetch_add(1, std::memory_order_relaxed);
+	Slot& slot = this->slots[index & (CAPACITY_TRACE_RING - 1)];
+	// mark slot as being recorded before touching it
+	slot.stamp.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.sequence.store(sequence, std::memory_order_relaxed);
+	slot.stage.store(stage, std::memory_order_relaxed);
+	slot.timestamp.store(timestamp, std::memory_order_relaxed);
+	// release complete record
+	slot.stamp.store(index + 1, std::memory_order_release);
+}
+
+void TraceRing::record(unsigned long long sequence, TraceStage stage) {
+	this->record(sequence, stage, TraceRing::now());
+}
+
+void TraceRing::snapshot(std::vector<TraceRecord>& records) const {
+	const unsigned long long recorded = this->recorded.load(std::memory_order_acquire);
+	const unsigned long long oldest = recorded > CAPACITY_TRACE_RING ? recorded - CAPACITY_TRACE_RING : 0;
+	for (unsigned long long index = oldest; index < recorded; ++index) {
+		const Slot& slot = this->slots[index & (CAPACITY_TRACE_RING - 1)];
+		const unsigned long long stamp = slot.stamp.load(std::memory_order_acquire);
+		TraceRecord record;
+		record.sequence = slot.sequence.load(std::memory_order_relaxed);
+		record.stage = static_cast<TraceStage>(slot.stage.load(std::memory_order_relaxed));
+		record.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		// skip records being recorded or overwritten in the meantime
+		if (stamp == index + 1 && slot.stamp.load(std::memory_order_relaxed) == stamp) {
+			records.push_back(record);
+		}
+	}
+}
+
+unsigned long long TraceRing::getRecorded() const {
+	return this->recorded.load(std::memory_order_relaxed);
+}
+
+long long TraceRing::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,99 @@
+#ifndef SCENEINTERFACESMA_TRACERING_H
+#define SCENEINTERFACESMA_TRACERING_H
+
+#include <atomic>
+#include <vector>
+
+namespace scene_interface_sma {
+	const char* const NAME_TRACE_RING = "TraceRing";
+
+	// Amount of trace records kept, power of two so the free running index wraps correctly
+	const unsigned int CAPACITY_TRACE_RING = 1 << 16;
+
+	// Stages of a camera frame from capture till displayed by the projector, in order of the pipeline
+	enum TraceStage {
+		TRACE_STAGE_CAPTURE,
+		TRACE_STAGE_RESIZE,
+		TRACE_STAGE_ELIMINATE_PROJECTION,
+		TRACE_STAGE_DETECT,
+		TRACE_STAGE_MATCH,
+		TRACE_STAGE_PROJECT_PEOPLE,
+		TRACE_STAGE_PUBLISH,
+		TRACE_STAGE_CONSUME,
+		TRACE_STAGE_UPDATE,
+		TRACE_STAGE_RENDER,
+		TRACE_STAGE_DISPLAY,
+		AMOUNT_TRACE_STAGES
+	};
+
+	// Names of the trace stages
+	extern const char* const NAMES_TRACE_STAGES[AMOUNT_TRACE_STAGES];
+
+	// Record of a camera frame passing a stage
+	struct TraceRecord {
+		// sequence of the camera frame
+		unsigned long long sequence;
+		TraceStage stage;
+		// steady clock nanoseconds on which the stage is passed
+		long long timestamp;
+	};
+
+	/**
+	 * Lock-free ring of trace records in shared memory which any thread of any process can record in.
+	 * Recording never blocks, old records are overwritten when the ring is full. A reader takes a snapshot
+	 * of all complete records without disturbing the recorders.
+	 **/
+	class TraceRing {
+	 public:
+			TraceRing();
+
+			/**
+			 * Record that a camera frame passed a stage.
+			 *
+			 * @param sequence  The sequence of the camera frame
+			 * @param stage     The passed stage
+			 * @param timestamp The steady clock nanoseconds on which the stage is passed
+			 **/
+			void record(unsigned long long sequence, TraceStage stage, long long timestamp);
+
+			/**
+			 * Record that a camera frame passed a stage just now.
+			 *
+			 * @param sequence The sequence of the camera frame
+			 * @param stage    The passed stage
+			 **/
+			void record(unsigned long long sequence, TraceStage stage);
+
+			/**
+			 * Copy all complete records currently in the ring, oldest first.
+			 *
+			 * @param records The vector to append the records to
+			 **/
+			void snapshot(std::vector<TraceRecord>& records) const;
+
+			// Amount of records recorded since construction
+			unsigned long long getRecorded() const;
+
+			// Steady clock time in nanoseconds, which is the same clock in every process
+			static long long now();
+
+	 private:
+			static_assert((CAPACITY_TRACE_RING & (CAPACITY_TRACE_RING - 1)) == 0, "Capacity trace ring should be a power of two");
+			static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory trace ring requires lock-free atomics");
+
+			// record with the index it is recorded as plus one, 0 while being recorded
+			struct Slot {
+				std::atomic<unsigned long long> stamp;
+				std::atomic<unsigned long long> sequence;
+				std::atomic<unsigned int> stage;
+				std::atomic<long long> timestamp;
+			};
+
+			// index of next record, claimed by recorders
+			std::atomic<unsigned long long> recorded;
+
+			Slot slots[CAPACITY_TRACE_RING];
+	};
+}
+
+#endif //SCENEINTERFACESMA_TRACERING_H
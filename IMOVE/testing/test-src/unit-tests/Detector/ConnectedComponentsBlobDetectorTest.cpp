@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+#include "../../../../imove_peopleextractor/src/ImageProcessing/Detector/ConnectedComponentsBlobDetector.h"
+
+namespace {
+
+// Foreground of 8 tiles of 60 rows, the most tiles the detector splits it in for every cleanup size tested
+const cv::Size SIZE_FOREGROUND(320, 480);
+const int ROWS_TILE = 60;
+
+/**
+ * Draw a crowd of people, some with holes, and specks, spread over the whole foreground so many of them cross a seam between tiles.
+ *
+ * @param seed The seed of the crowd
+ * @return the foreground, 255 where people are
+ */
+cv::Mat drawCrowd(unsigned int seed) {
+  cv::RNG rng(seed);
+  cv::Mat foreground(SIZE_FOREGROUND, CV_8UC1, cv::Scalar(0));
+  for (int person = 0; person < 16; ++person) {
+    const cv::Point center(rng.uniform(0, SIZE_FOREGROUND.width), rng.uniform(0, SIZE_FOREGROUND.height));
+    if (person % 4 == 0) {
+      cv::circle(foreground, center, rng.uniform(10, 40), cv::Scalar(255), rng.uniform(2, 6));
+    } else {
+      cv::ellipse(foreground, center, cv::Size(rng.uniform(3, 30), rng.uniform(3, 50)), rng.uniform(0, 180), 0, 360, cv::Scalar(255), cv::FILLED);
+    }
+  }
+  for (int speck = 0; speck < 300; ++speck) {
+    foreground.at<unsigned char>(rng.uniform(0, SIZE_FOREGROUND.height), rng.uniform(0, SIZE_FOREGROUND.width)) = 255;
+  }
+  return foreground;
+}
+
+/**
+ * Expect blobs labelled in tiles to be the blobs labelled as a whole, in the same order.
+ *
+ * @param blobs_whole The blobs labelled as a whole
+ * @param blobs_tiles The blobs labelled in tiles
+ */
+void expectSameBlobs(const std::vector<Blob>& blobs_whole, const std::vector<Blob>& blobs_tiles) {
+  ASSERT_EQ(blobs_whole.size(), blobs_tiles.size());
+  for (unsigned int i = 0; i < blobs_whole.size(); ++i) {
+    EXPECT_EQ(blobs_whole[i].area, blobs_tiles[i].area) << "blob " << i;
+    EXPECT_EQ(blobs_whole[i].bounding_box, blobs_tiles[i].bounding_box) << "blob " << i;
+    EXPECT_NEAR(blobs_whole[i].location.x, blobs_tiles[i].location.x, 1e-4) << "blob " << i;
+    EXPECT_NEAR(blobs_whole[i].location.y, blobs_tiles[i].location.y, 1e-4) << "blob " << i;
+  }
+}
+
+}  // namespace
+
+/**
+ * Test class for labelling a foreground in tiles, which passes the amount of tiles instead of taking it from the threads of opencv.
+ */
+class ConnectedComponentsBlobDetectorTest : public ::testing::Test {
+ protected:
+  /**
+   * Expect crowds labelled in an amount of tiles to give the same blobs as labelled as a whole.
+   *
+   * @param size_morphology The size of the morphological cleanup, 0 for none
+   * @param minBlobDist     The distance below which blobs are one
+   * @param amount_tiles    The amount of tiles to label in
+   */
+  static void expectTilesLikeWhole(unsigned int size_morphology, float minBlobDist, int amount_tiles) {
+    ConnectedComponentsBlobDetector detector_whole(1, minBlobDist, size_morphology);
+    ConnectedComponentsBlobDetector detector_tiles(1, minBlobDist, size_morphology);
+    // the detector splits in the tiles asked for, so the tiles are compared with the whole and not the whole with itself
+    ASSERT_EQ(amount_tiles, detector_tiles.getAmountTiles(SIZE_FOREGROUND.height, amount_tiles));
+    std::vector<Blob> blobs_whole;
+    std::vector<Blob> blobs_tiles;
+    for (unsigned int seed = 1; seed <= 10; ++seed) {
+      SCOPED_TRACE(seed);
+      const cv::Mat foreground = drawCrowd(seed);
+      detector_whole.detect(foreground, blobs_whole, 1);
+      detector_tiles.detect(foreground, blobs_tiles, amount_tiles);
+      ASSERT_FALSE(blobs_whole.empty());
+      expectSameBlobs(blobs_whole, blobs_tiles);
+    }
+  }
+};
+
+/**
+ * Verify that crowds labelled in 2, 3 and 8 tiles without cleanup give the blobs labelled as a whole.
+ */
+TEST_F(ConnectedComponentsBlobDetectorTest, tilesWithoutCleanup) {
+  expectTilesLikeWhole(0, 0, 2);
+  expectTilesLikeWhole(0, 0, 3);
+  expectTilesLikeWhole(0, 0, 8);
+}
+
+/**
+ * Verify that crowds cleaned up and labelled in tiles give the blobs of the whole, as cleaning up a tile also reads the rows around it.
+ */
+TEST_F(ConnectedComponentsBlobDetectorTest, tilesWithCleanup) {
+  expectTilesLikeWhole(5, 0, 8);
+  expectTilesLikeWhole(9, 0, 3);
+  expectTilesLikeWhole(9, 0, 8);
+}
+
+/**
+ * Verify that labelling in tiles keeps the same blobs of the whole when blobs closer than the minimum distance are one.
+ */
+TEST_F(ConnectedComponentsBlobDetectorTest, tilesMinimumDistance) {
+  expectTilesLikeWhole(5, 20, 8);
+}
+
+/**
+ * Verify that pixels which only touch diagonally across a seam are one blob.
+ */
+TEST_F(ConnectedComponentsBlobDetectorTest, diagonalAcrossSeam) {
+  cv::Mat foreground(SIZE_FOREGROUND, CV_8UC1, cv::Scalar(0));
+  foreground.at<unsigned char>(ROWS_TILE - 1, 10) = 255;
+  foreground.at<unsigned char>(ROWS_TILE, 11) = 255;
+  ConnectedComponentsBlobDetector detector(1, 0, 0);
+  std::vector<Blob> blobs;
+  detector.detect(foreground, blobs, 8);
+  ASSERT_EQ(1u, blobs.size());
+  EXPECT_EQ(2, blobs[0].area);
+  EXPECT_EQ(cv::Rect(10, ROWS_TILE - 1, 2, 2), blobs[0].bounding_box);
+}
+
+/**
+ * Verify that a U whose arms only join two tiles further down is one blob with the centroid of all its pixels.
+ */
+TEST_F(ConnectedComponentsBlobDetectorTest, joinedTwoTilesFurther) {
+  cv::Mat foreground(SIZE_FOREGROUND, CV_8UC1, cv::Scalar(0));
+  // arms of 5 by 150 pixels from the first into the third tile, joined by a bar of 25 by 5 pixels in the third tile
+  foreground(cv::Rect(100, 10, 5, 150)).setTo(cv::Scalar(255));
+  foreground(cv::Rect(120, 10, 5, 150)).setTo(cv::Scalar(255));
+  foreground(cv::Rect(100, 155, 25, 5)).setTo(cv::Scalar(255));
+  ConnectedComponentsBlobDetector detector(1, 0, 0);
+  std::vector<Blob> blobs;
+  detector.detect(foreground, blobs, 8);
+  ASSERT_EQ(1u, blobs.size());
+  EXPECT_EQ(cv::countNonZero(foreground), blobs[0].area);
+  EXPECT_EQ(cv::Rect(100, 10, 25, 150), blobs[0].bounding_box);
+  const cv::Moments moments = cv::moments(foreground, true);
+  EXPECT_NEAR(moments.m10 / moments.m00, blobs[0].location.x, 1e-4);
+  EXPECT_NEAR(moments.m01 / moments.m00, blobs[0].location.y, 1e-4);
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <vector>
+
+#include "../../../../imove_peopleextractor/src/ImageProcessing/Detector/GaussianBackgroundModel.h"
+
+namespace {
+
+// Seed of the camera frames, fixed so every instruction set gets the same frames
+const unsigned long long SEED = 1;
+// Amount of camera frames the models learn from
+const int FRAMES = 40;
+// Odd width, so the vector instructions also leave pixels over at the end of every row
+const cv::Size SIZE_FRAME(203, 101);
+
+/**
+ * Apply seeded camera frames of a person walking over a noisy floor with a shadow next to them.
+ *
+ * @param instruction_set The instruction set to update the model with
+ * @param type            The type of the camera frames
+ * @param shadows         Whether the model recognizes shadows
+ * @return the foreground of every camera frame
+ */
+std::vector<cv::Mat> applyFrames(GaussianBackgroundModel::InstructionSet instruction_set, int type, bool shadows) {
+  GaussianBackgroundModel model(0.05f, shadows);
+  model.setInstructionSet(instruction_set);
+  cv::RNG rng(SEED);
+  cv::Mat floor(SIZE_FRAME, type);
+  rng.fill(floor, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+
+  std::vector<cv::Mat> foregrounds;
+  for (int i = 0; i < FRAMES; ++i) {
+    cv::Mat noise(SIZE_FRAME, CV_MAKETYPE(CV_16S, CV_MAT_CN(type)));
+    rng.fill(noise, cv::RNG::NORMAL, cv::Scalar::all(0), cv::Scalar::all(4));
+    cv::Mat frame;
+    cv::add(floor, noise, frame, cv::noArray(), type);
+    cv::rectangle(frame, cv::Rect(5 + 4 * i, 30, 20, 40), cv::Scalar::all(255), cv::FILLED);
+    cv::Mat shadow = frame(cv::Rect(25 + 4 * i, 30, 10, 40));
+    shadow *= 0.6;
+
+    cv::Mat foreground;
+    model.apply(frame, foreground, true);
+    foregrounds.push_back(foreground.clone());
+  }
+  return foregrounds;
+}
+
+/**
+ * Expect an instruction set to find the same foreground in every camera frame as the scalar reference.
+ *
+ * @param instruction_set The instruction set to compare with the scalar reference
+ * @param type            The type of the camera frames
+ * @param shadows         Whether the model recognizes shadows
+ */
+void expectSameAsScalar(GaussianBackgroundModel::InstructionSet instruction_set, int type, bool shadows) {
+  if (GaussianBackgroundModel::getSupportedInstructionSet() < instruction_set) {
+    std::cout << "Skipping " << GaussianBackgroundModel::getName(instruction_set) << ", not supported by this processor" << std::endl;
+    return;
+  }
+  const std::vector<cv::Mat> foregrounds_scalar = applyFrames(GaussianBackgroundModel::INSTRUCTION_SET_SCALAR, type, shadows);
+  const std::vector<cv::Mat> foregrounds = applyFrames(instruction_set, type, shadows);
+  ASSERT_EQ(foregrounds_scalar.size(), foregrounds.size());
+  // the person is found at all, so equal foregrounds are not equally empty
+  EXPECT_GT(cv::countNonZero(foregrounds_scalar.back()), 0);
+  for (unsigned int i = 0; i < foregrounds.size(); ++i) {
+    cv::Mat different;
+    cv::compare(foregrounds_scalar[i], foregrounds[i], different, cv::CMP_NE);
+    EXPECT_EQ(0, cv::countNonZero(different)) << "camera frame " << i;
+  }
+}
+
+}  // namespace
+
+/**
+ * Verify that SSE2 finds the same foreground as the scalar reference in grayscale camera frames.
+ */
+TEST(GaussianBackgroundModelTest, sse2Gray) {
+  expectSameAsScalar(GaussianBackgroundModel::INSTRUCTION_SET_SSE2, CV_8UC1, false);
+}
+
+/**
+ * Verify that SSE2 finds the same foreground and shadows as the scalar reference in color camera frames.
+ */
+TEST(GaussianBackgroundModelTest, sse2ColorShadows) {
+  expectSameAsScalar(GaussianBackgroundModel::INSTRUCTION_SET_SSE2, CV_8UC3, true);
+}
+
+/**
+ * Verify that AVX2 finds the same foreground as the scalar reference in grayscale camera frames.
+ */
+TEST(GaussianBackgroundModelTest, avx2Gray) {
+  expectSameAsScalar(GaussianBackgroundModel::INSTRUCTION_SET_AVX2, CV_8UC1, false);
+}
+
+/**
+ * Verify that AVX2 finds the same foreground and shadows as the scalar reference in color camera frames.
+ */
+TEST(GaussianBackgroundModelTest, avx2ColorShadows) {
+  expectSameAsScalar(GaussianBackgroundModel::INSTRUCTION_SET_AVX2, CV_8UC3, true);
+}
@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+#include "../../../../imove_peopleextractor/src/ImageProcessing/Identifier/HungarianSolver.h"
+
+/**
+ * Test class for the HungarianSolver class, on small problems solved by hand.
+ */
+class HungarianSolverTest : public ::testing::Test {
+ protected:
+  HungarianSolver solver;
+  std::vector<unsigned int> edge_starts;
+  std::vector<HungarianSolver::Edge> edges;
+  std::vector<int> assignments;
+
+  // Start the edges of the next row
+  void addRow() {
+    edge_starts.push_back(edges.size());
+  }
+
+  // Add an edge to a column to the last row
+  void addEdge(unsigned int column, double cost) {
+    HungarianSolver::Edge edge;
+    edge.column = column;
+    edge.cost = cost;
+    edges.push_back(edge);
+  }
+
+  // Solve the rows added so far
+  void solve(unsigned int columns, double cost_unassigned) {
+    const unsigned int rows = edge_starts.size();
+    edge_starts.push_back(edges.size());
+    solver.solve(rows, columns, edge_starts, edges, cost_unassigned, assignments);
+  }
+};
+
+/**
+ * Verify that every row of a full problem gets the column of the least total cost, 1 + 2 + 2.
+ */
+TEST_F(HungarianSolverTest, full) {
+  const double costs[3][3] = {
+    { 4, 1, 3 },
+    { 2, 0, 5 },
+    { 3, 2, 2 }
+  };
+  for (unsigned int row = 0; row < 3; ++row) {
+    addRow();
+    for (unsigned int column = 0; column < 3; ++column) {
+      addEdge(column, costs[row][column]);
+    }
+  }
+  solve(3, 100);
+  ASSERT_EQ(3u, assignments.size());
+  EXPECT_EQ(1, assignments[0]);
+  EXPECT_EQ(0, assignments[1]);
+  EXPECT_EQ(2, assignments[2]);
+}
+
+/**
+ * Verify that the first row gives up the column it prefers, when the second row can only go there: 2 + 2 instead of 1 + 10.
+ */
+TEST_F(HungarianSolverTest, notGreedy) {
+  addRow();
+  addEdge(0, 1);
+  addEdge(1, 2);
+  addRow();
+  addEdge(0, 2);
+  solve(2, 10);
+  ASSERT_EQ(2u, assignments.size());
+  EXPECT_EQ(1, assignments[0]);
+  EXPECT_EQ(0, assignments[1]);
+}
+
+/**
+ * Verify that a row is left unassigned when that is cheaper than its only column.
+ */
+TEST_F(HungarianSolverTest, unassignedCheaper) {
+  addRow();
+  addEdge(0, 10);
+  solve(1, 3);
+  ASSERT_EQ(1u, assignments.size());
+  EXPECT_EQ(-1, assignments[0]);
+}
+
+/**
+ * Verify that of two rows competing for one column the cheaper one gets it: 1 + 5 instead of 2 + 5.
+ */
+TEST_F(HungarianSolverTest, competing) {
+  addRow();
+  addEdge(0, 1);
+  addRow();
+  addEdge(0, 2);
+  solve(1, 5);
+  ASSERT_EQ(2u, assignments.size());
+  EXPECT_EQ(0, assignments[0]);
+  EXPECT_EQ(-1, assignments[1]);
+}
+
+/**
+ * Verify that a row without edges is unassigned, and the others are still assigned.
+ */
+TEST_F(HungarianSolverTest, rowWithoutEdges) {
+  addRow();
+  addRow();
+  addEdge(0, 0.5);
+  solve(1, 5);
+  ASSERT_EQ(2u, assignments.size());
+  EXPECT_EQ(-1, assignments[0]);
+  EXPECT_EQ(0, assignments[1]);
+}
+
+/**
+ * Verify that no rows give no assignments.
+ */
+TEST_F(HungarianSolverTest, empty) {
+  solve(3, 5);
+  EXPECT_TRUE(assignments.empty());
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include "../../../../imove_peopleextractor/src/ImageProcessing/Identifier/KalmanTrack.h"
+
+// Tolerance of the filtered values, which are computed in floats
+const float TOLERANCE = 1e-4f;
+
+/**
+ * Verify that a new track stands still at its location with the given uncertainty.
+ */
+TEST(KalmanTrackTest, start) {
+  const KalmanTrack track(Vector2(1, 2), 4, 9);
+  EXPECT_FLOAT_EQ(1, track.getLocation().x);
+  EXPECT_FLOAT_EQ(2, track.getLocation().y);
+  EXPECT_FLOAT_EQ(0, track.getVelocity().x);
+  EXPECT_FLOAT_EQ(0, track.getVelocity().y);
+  float covariance[16];
+  track.getCovariance(covariance);
+  EXPECT_FLOAT_EQ(4, covariance[0 * 4 + 0]);
+  EXPECT_FLOAT_EQ(4, covariance[1 * 4 + 1]);
+  EXPECT_FLOAT_EQ(9, covariance[2 * 4 + 2]);
+  EXPECT_FLOAT_EQ(9, covariance[3 * 4 + 3]);
+  EXPECT_FLOAT_EQ(0, covariance[0 * 4 + 2]);
+}
+
+/**
+ * Verify the uncertainty after half a second with acceleration noise 2:
+ * 4 + 0.25 * 9 + 2 * 0.125 / 3 for the location, 0.5 * 9 + 2 * 0.25 / 2 between location and velocity, 9 + 2 * 0.5 for the velocity.
+ */
+TEST(KalmanTrackTest, predictCovariance) {
+  KalmanTrack track(Vector2(1, 2), 4, 9);
+  track.predict(0.5f, 2);
+  EXPECT_FLOAT_EQ(1, track.getLocation().x);
+  EXPECT_FLOAT_EQ(2, track.getLocation().y);
+  float covariance[16];
+  track.getCovariance(covariance);
+  EXPECT_NEAR(4 + 2.25f + 0.25f / 3, covariance[0 * 4 + 0], TOLERANCE);
+  EXPECT_NEAR(4.75f, covariance[0 * 4 + 2], TOLERANCE);
+  EXPECT_NEAR(4.75f, covariance[2 * 4 + 0], TOLERANCE);
+  EXPECT_NEAR(10, covariance[2 * 4 + 2], TOLERANCE);
+  // the axes do not covary
+  EXPECT_FLOAT_EQ(0, covariance[0 * 4 + 1]);
+  EXPECT_FLOAT_EQ(0, covariance[0 * 4 + 3]);
+}
+
+/**
+ * Verify that a measurement as uncertain as the track moves it halfway, and halves its uncertainty.
+ */
+TEST(KalmanTrackTest, updateHalfway) {
+  KalmanTrack track(Vector2(1, 2), 4, 9);
+  track.update(Vector2(5, 2), 4);
+  EXPECT_NEAR(3, track.getLocation().x, TOLERANCE);
+  EXPECT_NEAR(2, track.getLocation().y, TOLERANCE);
+  // without covariance between location and velocity the velocity is not corrected
+  EXPECT_NEAR(0, track.getVelocity().x, TOLERANCE);
+  float covariance[16];
+  track.getCovariance(covariance);
+  EXPECT_NEAR(2, covariance[0 * 4 + 0], TOLERANCE);
+  EXPECT_NEAR(9, covariance[2 * 4 + 2], TOLERANCE);
+}
+
+/**
+ * Verify predicting one second, measuring 2 with variance 2 and predicting two more seconds:
+ * gains 2 / 4 for the location and 1 / 4 for the velocity give location 1 and velocity 0.5, which moves to 2.
+ */
+TEST(KalmanTrackTest, learnVelocity) {
+  KalmanTrack track(Vector2(0, 0), 1, 1);
+  track.predict(1, 0);
+  track.update(Vector2(2, 0), 2);
+  EXPECT_NEAR(1, track.getLocation().x, TOLERANCE);
+  EXPECT_NEAR(0.5f, track.getVelocity().x, TOLERANCE);
+  EXPECT_NEAR(0, track.getLocation().y, TOLERANCE);
+  EXPECT_NEAR(0, track.getVelocity().y, TOLERANCE);
+  float covariance[16];
+  track.getCovariance(covariance);
+  EXPECT_NEAR(1, covariance[0 * 4 + 0], TOLERANCE);
+  EXPECT_NEAR(0.5f, covariance[0 * 4 + 2], TOLERANCE);
+  EXPECT_NEAR(0.75f, covariance[2 * 4 + 2], TOLERANCE);
+
+  track.predict(2, 0);
+  EXPECT_NEAR(2, track.getLocation().x, TOLERANCE);
+  EXPECT_NEAR(0.5f, track.getVelocity().x, TOLERANCE);
+}
+
+/**
+ * Verify that damping slows the track down without moving it.
+ */
+TEST(KalmanTrackTest, damp) {
+  KalmanTrack track(Vector2(0, 0), 1, 1);
+  track.predict(1, 0);
+  track.update(Vector2(2, 0), 2);
+  track.damp(0.5f);
+  EXPECT_NEAR(1, track.getLocation().x, TOLERANCE);
+  EXPECT_NEAR(0.25f, track.getVelocity().x, TOLERANCE);
+}
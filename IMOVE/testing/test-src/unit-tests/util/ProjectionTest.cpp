@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include <opencv2/opencv.hpp>
+
+#include "../../../../util/src/Projection.hpp"
+
+namespace {
+
+// Camera and projector of the same resolution, with the projection covering the whole camera frame
+const cv::Size RESOLUTION(160, 120);
+// Milliseconds from the projector displaying a frame till the camera captures it
+const unsigned int LATENCY_MS = 50;
+// Steady clock nanoseconds of a millisecond
+const long long NANOSECONDS_MS = 1000000;
+
+}  // namespace
+
+/**
+ * Test class for eliminating the projection with the Projection class, with a camera which sees the projector frames one to one.
+ */
+class ProjectionTest : public ::testing::Test {
+ protected:
+  CameraConfiguration camera_configuration;
+  ProjectorConfiguration projector_configuration;
+  ProjectioneliminationConfiguration projectionelimination_configuration;
+  CaptureConfiguration capture_configuration;
+  PipelineConfiguration pipeline_configuration;
+  ImoveConfiguration calibration;
+  Projection projection;
+  // floor the camera sees without projection
+  cv::Mat floor;
+
+  ProjectionTest() :
+      camera_configuration(RESOLUTION, 0, Boundary(Vector2(0, 0), Vector2(RESOLUTION.width - 1, 0), Vector2(0, RESOLUTION.height - 1), Vector2(RESOLUTION.width - 1, RESOLUTION.height - 1)), 40, 100, 20, CameraConfiguration::BLOB_DETECTOR_CONNECTED_COMPONENTS, 0, false, 0, CameraConfiguration::BACKGROUND_MODEL_GAUSSIAN, 0.002f, false, 1, 1, 1),
+      projector_configuration(RESOLUTION, false, 40, 60, 0, 0),
+      // the projector lights the floor fully, without exposure blending the frames
+      projectionelimination_configuration(LATENCY_MS, 0, 1, 30, 1),
+      capture_configuration(CaptureConfiguration::SOURCE_CAMERA, "", "", false, 0, 0, 0, false, false),
+      pipeline_configuration(1, PipelineConfiguration::DROP_POLICY_OLDEST, 0, 0, PipelineConfiguration::INGESTION_GRAY),
+      calibration(false, false, false, &camera_configuration, &projector_configuration, &projectionelimination_configuration, &capture_configuration, &pipeline_configuration),
+      projection(&calibration),
+      floor(RESOLUTION, CV_8UC1) {
+    cv::RNG rng(1);
+    rng.fill(floor, cv::RNG::UNIFORM, cv::Scalar(20), cv::Scalar(60));
+  }
+
+  // Projector frame of a rectangle lit with a level, on black
+  static cv::Mat createFrameProjector(const cv::Rect& rect, unsigned char level) {
+    cv::Mat frame_projector(RESOLUTION, CV_8UC1, cv::Scalar(0));
+    frame_projector(rect).setTo(cv::Scalar(level));
+    return frame_projector;
+  }
+
+  // Camera frame of the floor lit by a projector frame
+  cv::Mat createFrameCamera(const cv::Mat& frame_projector) const {
+    cv::Mat frame_camera;
+    cv::add(floor, frame_projector, frame_camera);
+    return frame_camera;
+  }
+
+  // Largest difference between the camera frame with the projection eliminated and the floor
+  double eliminate(const cv::Mat& frame_camera, long long timestamp_capture) {
+    cv::Mat frame_eliminated;
+    projection.eliminateProjectionFeedbackFromFrameCamera(frame_eliminated, frame_camera, timestamp_capture);
+    return cv::norm(frame_eliminated, floor, cv::NORM_INF);
+  }
+};
+
+/**
+ * Verify that a camera frame is passed on as is while no projector frame is displayed yet.
+ */
+TEST_F(ProjectionTest, withoutFrameProjector) {
+  const cv::Mat frame_camera = createFrameCamera(createFrameProjector(cv::Rect(40, 30, 60, 40), 150));
+  cv::Mat frame_eliminated;
+  projection.eliminateProjectionFeedbackFromFrameCamera(frame_eliminated, frame_camera, 1000 * NANOSECONDS_MS);
+  EXPECT_EQ(frame_camera.data, frame_eliminated.data);
+}
+
+/**
+ * Verify that the displayed projector frame is removed from the camera frame, leaving the floor.
+ */
+TEST_F(ProjectionTest, eliminateFrameProjector) {
+  const cv::Mat frame_projector = createFrameProjector(cv::Rect(40, 30, 60, 40), 150);
+  const cv::Mat frame_camera = createFrameCamera(frame_projector);
+  projection.feedFrameProjector(frame_projector, 1000 * NANOSECONDS_MS);
+  // the projection is seen at all, so the floor is not left by passing the camera frame on
+  EXPECT_GT(cv::norm(frame_camera, floor, cv::NORM_INF), 100);
+  EXPECT_LE(eliminate(frame_camera, (1000 + LATENCY_MS + 10) * NANOSECONDS_MS), 1);
+}
+
+/**
+ * Verify that the projector frame displayed the latency before capturing is removed, not the one displayed before or after it.
+ */
+TEST_F(ProjectionTest, eliminateFrameProjectorDisplayedAtCapture) {
+  const cv::Mat frame_projector_first = createFrameProjector(cv::Rect(10, 10, 50, 40), 150);
+  const cv::Mat frame_projector_second = createFrameProjector(cv::Rect(90, 60, 50, 40), 150);
+  projection.feedFrameProjector(frame_projector_first, 1000 * NANOSECONDS_MS);
+  projection.feedFrameProjector(frame_projector_second, 1100 * NANOSECONDS_MS);
+
+  // captured while the first projector frame is still seen by the camera, and while the second one is
+  EXPECT_LE(eliminate(createFrameCamera(frame_projector_first), (1100 + LATENCY_MS - 10) * NANOSECONDS_MS), 1);
+  EXPECT_LE(eliminate(createFrameCamera(frame_projector_second), (1100 + LATENCY_MS + 10) * NANOSECONDS_MS), 1);
+  // eliminating the other projector frame leaves the projection in the camera frame
+  EXPECT_GT(eliminate(createFrameCamera(frame_projector_second), (1100 + LATENCY_MS - 10) * NANOSECONDS_MS), 100);
+}
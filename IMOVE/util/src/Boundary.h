@@ -1,6 +1,7 @@
 #ifndef SCENEINTERFACE_BOUNDARY_H
 #define SCENEINTERFACE_BOUNDARY_H
 
+#include "Geometry.h"
 #include "Vector2.h"
 #include <iostream>
 
@@ -13,15 +14,18 @@ private:
   Vector2 lower_left;
   Vector2 lower_right;
 
-  // Parameters for equations
-  float a1, a2, a3, a4;
-  float b1, b2, b3, b4;
+  // Inner sides of the edges, to classify locations with
+  HalfPlanes half_planes;
 
 public:
   Boundary();
   Boundary(const Vector2& upleft, const Vector2& upright, const Vector2& lowleft, const Vector2& lowright);
   ~Boundary();
-  bool inBounds(const Vector2& location);
+  // Whether a location is strictly inside the boundary
+  bool inBounds(const Vector2& location) const;
+
+  // Gets the inner sides of the edges, to classify many locations at once
+  const HalfPlanes& getHalfPlanes() const;
 
   // Getters
 	const Vector2 getUpperLeft() const;
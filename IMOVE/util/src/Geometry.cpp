@@ -0,0 +1,111 @@
+#include "Geometry.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+HalfPlanes::HalfPlanes() {
+  for (unsigned int i = 0; i < 4; ++i) {
+    a[i] = 0;
+    b[i] = 0;
+    c[i] = 0;
+  }
+}
+
+HalfPlanes::HalfPlanes(const Vector2& corner1, const Vector2& corner2, const Vector2& corner3, const Vector2& corner4) {
+  const Vector2 corners[4] = {corner1, corner2, corner3, corner4};
+  // Twice the signed area, which is positive when the corners go around such that the inner side is on the left
+  float area = 0;
+  for (unsigned int i = 0; i < 4; ++i) {
+    const Vector2& from = corners[i];
+    const Vector2& to = corners[(i + 1) % 4];
+    area += from.x * to.y - to.x * from.y;
+  }
+  const float orientation = area < 0 ? -1 : 1;
+
+  // Cross product of every edge with the point relative to the start of the edge
+  for (unsigned int i = 0; i < 4; ++i) {
+    const Vector2& from = corners[i];
+    const Vector2& to = corners[(i + 1) % 4];
+    a[i] = -(to.y - from.y) * orientation;
+    b[i] = (to.x - from.x) * orientation;
+    c[i] = -(a[i] * from.x + b[i] * from.y);
+  }
+}
+
+bool HalfPlanes::contains(const Vector2& point) const {
+  unsigned char inside;
+  contains(&point.x, &point.y, 1, &inside);
+  return inside != 0;
+}
+
+void HalfPlanes::contains(const float* x, const float* y, unsigned int amount, unsigned char* inside) const {
+  unsigned int i = 0;
+#ifdef __SSE2__
+  const __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= amount; i += 4) {
+    const __m128 xs = _mm_loadu_ps(x + i);
+    const __m128 ys = _mm_loadu_ps(y + i);
+    __m128 all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (unsigned int edge = 0; edge < 4; ++edge) {
+      const __m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[edge]), xs), _mm_mul_ps(_mm_set1_ps(b[edge]), ys)), _mm_set1_ps(c[edge]));
+      all = _mm_and_ps(all, _mm_cmpgt_ps(value, zero));
+    }
+    const int mask = _mm_movemask_ps(all);
+    inside[i] = mask & 1;
+    inside[i + 1] = (mask >> 1) & 1;
+    inside[i + 2] = (mask >> 2) & 1;
+    inside[i + 3] = (mask >> 3) & 1;
+  }
+#endif
+  // Points left over at the end
+  for (; i < amount; ++i) {
+    bool all = true;
+    for (unsigned int edge = 0; edge < 4; ++edge) {
+      all &= a[edge] * x[i] + b[edge] * y[i] + c[edge] > 0;
+    }
+    inside[i] = all;
+  }
+}
+
+Homography::Homography() {
+  for (unsigned int i = 0; i < 9; ++i) {
+    matrix[i] = i % 4 == 0 ? 1 : 0;
+  }
+}
+
+Homography::Homography(const double* matrix) {
+  for (unsigned int i = 0; i < 9; ++i) {
+    this->matrix[i] = static_cast<float>(matrix[i]);
+  }
+}
+
+Vector2 Homography::apply(const Vector2& point) const {
+  Vector2 mapped;
+  apply(&point.x, &point.y, 1, &mapped.x, &mapped.y);
+  return mapped;
+}
+
+void Homography::apply(const float* x, const float* y, unsigned int amount, float* x_mapped, float* y_mapped) const {
+  const float* m = matrix;
+  unsigned int i = 0;
+#ifdef __SSE2__
+  for (; i + 4 <= amount; i += 4) {
+    const __m128 xs = _mm_loadu_ps(x + i);
+    const __m128 ys = _mm_loadu_ps(y + i);
+    const __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[6]), xs), _mm_mul_ps(_mm_set1_ps(m[7]), ys)), _mm_set1_ps(m[8]));
+    const __m128 xw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[0]), xs), _mm_mul_ps(_mm_set1_ps(m[1]), ys)), _mm_set1_ps(m[2]));
+    const __m128 yw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[3]), xs), _mm_mul_ps(_mm_set1_ps(m[4]), ys)), _mm_set1_ps(m[5]));
+    _mm_storeu_ps(x_mapped + i, _mm_div_ps(xw, w));
+    _mm_storeu_ps(y_mapped + i, _mm_div_ps(yw, w));
+  }
+#endif
+  // Points left over at the end
+  for (; i < amount; ++i) {
+    const float w = m[6] * x[i] + m[7] * y[i] + m[8];
+    const float xw = m[0] * x[i] + m[1] * y[i] + m[2];
+    const float yw = m[3] * x[i] + m[4] * y[i] + m[5];
+    x_mapped[i] = xw / w;
+    y_mapped[i] = yw / w;
+  }
+}
@@ -0,0 +1,64 @@
+#ifndef UTIL_GEOMETRY_H
+#define UTIL_GEOMETRY_H
+
+#include "Vector2.h"
+
+// Geometry on batches of points, given as separate arrays of x and y coordinates so four points are processed per vector instruction
+
+// Convex quadrilateral as the four half planes on the inner side of its edges, to classify points without branches or divisions
+class HalfPlanes {
+public:
+  // Nothing is inside
+  HalfPlanes();
+
+  // Quadrilateral of corners in order around it, either clockwise or counterclockwise
+  HalfPlanes(const Vector2& corner1, const Vector2& corner2, const Vector2& corner3, const Vector2& corner4);
+
+  // Whether a point is strictly inside
+  bool contains(const Vector2& point) const;
+
+  /**
+   * Classify points as strictly inside or not.
+   *
+   * @param x      The x coordinates of the points
+   * @param y      The y coordinates of the points
+   * @param amount The amount of points
+   * @param inside The output of 1 for every point inside and 0 for every point outside
+   **/
+  void contains(const float* x, const float* y, unsigned int amount, unsigned char* inside) const;
+
+private:
+  // Every edge as a x + b y + c, which is positive on the inner side
+  float a[4];
+  float b[4];
+  float c[4];
+};
+
+// Perspective transformation of points
+class Homography {
+public:
+  // Identity
+  Homography();
+
+  // Transformation of the 3x3 matrix in row major order
+  Homography(const double* matrix);
+
+  // Transform a point
+  Vector2 apply(const Vector2& point) const;
+
+  /**
+   * Transform points, which may be done in place.
+   *
+   * @param x          The x coordinates of the points
+   * @param y          The y coordinates of the points
+   * @param amount     The amount of points
+   * @param x_mapped   The output x coordinates of the transformed points
+   * @param y_mapped   The output y coordinates of the transformed points
+   **/
+  void apply(const float* x, const float* y, unsigned int amount, float* x_mapped, float* y_mapped) const;
+
+private:
+  float matrix[9];
+};
+
+#endif // UTIL_GEOMETRY_H
@@ -1,45 +1,233 @@
 #include <opencv2/opencv.hpp>
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "Geometry.h"
 #include "OpenCVUtil.hpp"
 #include "Projection.hpp"
 #include "../../scene_interface/src/People.h"
 
+// Seconds a person walks along their velocity to map the velocity to the projector, short so the perspective is nearly linear over it
+const float SECONDS_VELOCITY = 0.1;
+
+// Fraction bits of the projector background light when subtracting the warped projector frame
+const int BITS_LIGHT = 8;
+
+/**
+ * Subtracts the warped projector pixels scaled by the light from the camera pixels, saturated at black.
+ *
+ * @param row_camera The camera pixels
+ * @param row_warped The warped projector pixels, replaced by the result
+ * @param length     The amount of bytes in the row
+ * @param light      The projector background light in fixed point with BITS_LIGHT fraction bits
+ **/
+static void subtractScaled(const unsigned char* row_camera, unsigned char* row_warped, int length, unsigned short light) {
+	int i = 0;
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i factor = _mm_set1_epi16(light);
+	const __m128i half = _mm_set1_epi16(1 << (BITS_LIGHT - 1));
+	for (; i + 16 <= length; i += 16) {
+		const __m128i warped = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_warped + i));
+		// scale both halves in 16 bits, round and pack back to bytes
+		const __m128i low = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(warped, zero), factor), half), BITS_LIGHT);
+		const __m128i high = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(warped, zero), factor), half), BITS_LIGHT);
+		const __m128i camera = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_camera + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(row_warped + i), _mm_subs_epu8(camera, _mm_packus_epi16(low, high)));
+	}
+#endif
+	// bytes left over at the end of the row
+	for (; i < length; ++i) {
+		const int scaled = (row_warped[i] * light + (1 << (BITS_LIGHT - 1))) >> BITS_LIGHT;
+		row_warped[i] = static_cast<unsigned char>(std::max(0, row_camera[i] - scaled));
+	}
+}
+
+// Warps strips of the projector frame onto the camera frame and subtracts them while they are still in cache
+class EliminateStrips : public cv::ParallelLoopBody {
+	public:
+		EliminateStrips(const cv::Mat& frame_projector, const cv::Mat& frame_camera, const cv::Mat& map_coordinates, const cv::Mat& map_weights, unsigned short light, int rows_strip, cv::Mat& frame_projectioneliminated) :
+			frame_projector(frame_projector),
+			frame_camera(frame_camera),
+			map_coordinates(map_coordinates),
+			map_weights(map_weights),
+			light(light),
+			rows_strip(rows_strip),
+			frame_projectioneliminated(frame_projectioneliminated)
+		{}
+
+		void operator()(const cv::Range& strips) const {
+			const int length = this->frame_camera.cols * this->frame_camera.channels();
+			for (int strip = strips.start; strip < strips.end; ++strip) {
+				const cv::Range rows(strip * this->rows_strip, std::min((strip + 1) * this->rows_strip, this->frame_camera.rows));
+				// warp the projector frame into the output rows, which are then subtracted in place
+				cv::Mat rows_eliminated = this->frame_projectioneliminated.rowRange(rows);
+				cv::remap(
+					this->frame_projector,
+					rows_eliminated,
+					this->map_coordinates.rowRange(rows),
+					this->map_weights.rowRange(rows),
+					cv::INTER_LINEAR,
+					cv::BORDER_CONSTANT,
+					OpenCVUtil::Color::BLACK
+				);
+				for (int y = rows.start; y < rows.end; ++y) {
+					subtractScaled(this->frame_camera.ptr<unsigned char>(y), this->frame_projectioneliminated.ptr<unsigned char>(y), length, this->light);
+				}
+			}
+		}
+
+	private:
+		const cv::Mat& frame_projector;
+		const cv::Mat& frame_camera;
+		const cv::Mat& map_coordinates;
+		const cv::Mat& map_weights;
+		const unsigned short light;
+		const int rows_strip;
+		cv::Mat& frame_projectioneliminated;
+};
+
 Projection::Projection(ImoveConfiguration* calibration)
 : calibration(calibration)
-{}
+{
+	for (FrameProjector& frame_projector : this->frames_projector) {
+		frame_projector.timestamp_display = -1;
+		frame_projector.readers = 0;
+	}
+}
 
-void Projection::feedFrameProjector(const cv::Mat& frame_projector) {
-	// add a cloned frame to the queue
-	this->frames_delay_projector.push(frame_projector.clone());
+void Projection::feedFrameProjector(const cv::Mat& frame_projector, long long timestamp_display) {
+	// take the oldest projector frame no elimination is reading, and hide it from eliminations while writing
+	FrameProjector* frame_oldest = NULL;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex_frames_projector);
+		for (FrameProjector& frame_candidate : this->frames_projector) {
+			if (frame_candidate.readers == 0 && (frame_oldest == NULL || frame_candidate.timestamp_display < frame_oldest->timestamp_display)) {
+				frame_oldest = &frame_candidate;
+			}
+		}
+		if (frame_oldest == NULL) {
+			return;
+		}
+		frame_oldest->timestamp_display = -1;
+	}
+	// the buffer is only allocated for the first projector frames or when the size changes
+	frame_projector.copyTo(frame_oldest->frame);
+	std::lock_guard<std::mutex> lock(this->mutex_frames_projector);
+	frame_oldest->timestamp_display = timestamp_display;
 }
 
-void Projection::eliminateProjectionFeedbackFromFrameCamera(cv::Mat& frame_projectioneliminated, const cv::Mat& frame_camera) {
-	// Skip frames which are older than delay
+void Projection::eliminateProjectionFeedbackFromFrameCamera(cv::Mat& frame_projectioneliminated, const cv::Mat& frame_camera, long long timestamp_capture) {
+	CV_Assert(frame_camera.depth() == CV_8U);
 	ProjectioneliminationConfiguration* projectionelimination_configuration = this->calibration->getProjectioneliminationConfiguration();
-	while ((((signed int) frames_delay_projector.size()) - 1) > (signed int) projectionelimination_configuration->getFramesProjectorCameraDelay()) {
-	  this->frames_delay_projector.pop();
+	// the projector shows what it displayed the latency ago when the camera frame is captured, at the middle of the exposure
+	const long long timestamp_shown = timestamp_capture - projectionelimination_configuration->getLatencyProjectorCameraMs() * 1000000LL;
+	const long long nanoseconds_exposure = projectionelimination_configuration->getExposureCameraMs() * 1000000LL;
+
+	// the projector frame displayed at that time, which is the last one displayed before it, and the one displayed after it
+	FrameProjector* frame_shown = NULL;
+	FrameProjector* frame_next = NULL;
+	float weight_next = 0;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex_frames_projector);
+		for (FrameProjector& frame_candidate : this->frames_projector) {
+			if (frame_candidate.timestamp_display < 0) {
+				continue;
+			}
+			if (frame_candidate.timestamp_display <= timestamp_shown) {
+				if (frame_shown == NULL || frame_candidate.timestamp_display > frame_shown->timestamp_display) {
+					frame_shown = &frame_candidate;
+				}
+			} else if (frame_next == NULL || frame_candidate.timestamp_display < frame_next->timestamp_display) {
+				frame_next = &frame_candidate;
+			}
+		}
+		// use camera frame when no projector frame was displayed (yet) at that time
+		if (frame_shown == NULL || frame_shown->frame.type() != frame_camera.type()) {
+			frame_projectioneliminated = frame_camera;
+			return;
+		}
+		// blend in the next projector frame by the part of the exposure it is displayed
+		if (frame_next != NULL && nanoseconds_exposure > 0 && frame_next->frame.size() == frame_shown->frame.size() && frame_next->frame.type() == frame_shown->frame.type()) {
+			weight_next = std::min(std::max((timestamp_shown + nanoseconds_exposure / 2 - frame_next->timestamp_display) / (float) nanoseconds_exposure, 0.f), 1.f);
+		}
+		if (weight_next <= 0) {
+			frame_next = NULL;
+		}
+		++frame_shown->readers;
+		if (frame_next != NULL) {
+			++frame_next->readers;
+		}
 	}
-	if (this->frames_delay_projector.size() <= projectionelimination_configuration->getFramesProjectorCameraDelay()) {
-		// use camera frame when no projector frames are (yet) fed
-		frame_projectioneliminated = frame_camera;
-	} else {
-		// fill projection frame from camera frame using perspective map
-		cv::warpPerspective(
-			this->frames_delay_projector.front(),
-			frame_projectioneliminated,
-			this->calibration->getCameraProjectorTransformation(),
-			frame_camera.size(),
-			cv::INTER_LINEAR | cv::WARP_INVERSE_MAP,
-			cv::BORDER_CONSTANT,
-			OpenCVUtil::Color::BLACK
-		);
-		// subtract given image based on light level difference between projection and background
-		frame_projectioneliminated = frame_camera - (frame_projectioneliminated * projectionelimination_configuration->getProjectorBackgroundLight());
+
+	const cv::Mat* frame_projector = &frame_shown->frame;
+	if (frame_next != NULL) {
+		cv::addWeighted(frame_shown->frame, 1 - weight_next, frame_next->frame, weight_next, 0, this->frame_blended);
+		frame_projector = &this->frame_blended;
+	}
+	this->updateMaps(frame_camera.size(), frame_projector->size());
+	// light level difference between projection and background, in fixed point
+	const float light = std::min(std::max(projectionelimination_configuration->getProjectorBackgroundLight(), 0.f), 1.f);
+	const unsigned short light_fixed = static_cast<unsigned short>(std::lround(light * (1 << BITS_LIGHT)));
+	// the output is only reallocated when the caller passes no buffer of the camera frame size and type; never write into the camera frame itself
+	if (frame_projectioneliminated.data == frame_camera.data) {
+		frame_projectioneliminated.release();
+	}
+	frame_projectioneliminated.create(frame_camera.size(), frame_camera.type());
+	// fill projection frame from camera frame using the precomputed perspective map and subtract it strip by strip
+	const int strips = (frame_camera.rows + ROWS_STRIP - 1) / ROWS_STRIP;
+	cv::parallel_for_(
+		cv::Range(0, strips),
+		EliminateStrips(*frame_projector, frame_camera, this->map_coordinates, this->map_weights, light_fixed, ROWS_STRIP, frame_projectioneliminated)
+	);
+
+	// the projector frames may be overwritten again
+	std::lock_guard<std::mutex> lock(this->mutex_frames_projector);
+	--frame_shown->readers;
+	if (frame_next != NULL) {
+		--frame_next->readers;
 	}
 }
 
+void Projection::updateMaps(const cv::Size& size_camera, const cv::Size& size_projector) {
+	const cv::Mat transformation = this->calibration->getCameraProjectorTransformation();
+	if (!this->map_transformation.empty() && this->map_size == size_camera && this->map_size_projector == size_projector && cv::norm(transformation, this->map_transformation, cv::NORM_INF) == 0) {
+		return;
+	}
+	this->map_transformation = transformation.clone();
+	this->map_size = size_camera;
+	this->map_size_projector = size_projector;
+
+	// the scene sends projector frames downscaled from the projector resolution the transformation maps to, scale the pixel centers along
+	const cv::Size& resolution_projector = this->calibration->getProjectorConfiguration()->getResolution();
+	const double scale_x = resolution_projector.width > 0 ? size_projector.width / (double) resolution_projector.width : 1;
+	const double scale_y = resolution_projector.height > 0 ? size_projector.height / (double) resolution_projector.height : 1;
+
+	// projector coordinates of every camera pixel, like cv::warpPerspective with cv::WARP_INVERSE_MAP computes them every frame
+	cv::Mat h;
+	transformation.convertTo(h, CV_64F);
+	const double* hx = h.ptr<double>(0);
+	const double* hy = h.ptr<double>(1);
+	const double* hw = h.ptr<double>(2);
+	cv::Mat map_float(size_camera, CV_32FC2);
+	for (int y = 0; y < size_camera.height; ++y) {
+		float* row = map_float.ptr<float>(y);
+		for (int x = 0; x < size_camera.width; ++x) {
+			const double w = hw[0] * x + hw[1] * y + hw[2];
+			// pixels on the horizon map to nothing, which is outside the projector frame
+			row[2 * x] = w == 0 ? -1 : static_cast<float>(((hx[0] * x + hx[1] * y + hx[2]) / w + 0.5) * scale_x - 0.5);
+			row[2 * x + 1] = w == 0 ? -1 : static_cast<float>(((hy[0] * x + hy[1] * y + hy[2]) / w + 0.5) * scale_y - 0.5);
+		}
+	}
+	cv::convertMaps(map_float, cv::Mat(), this->map_coordinates, this->map_weights, CV_16SC2);
+}
+
 void Projection::createPointsFrameProjectorFromPointsFrameCamera(std::vector<cv::Point2f>& points_frame_projector, const std::vector<cv::Point2f>& points_frame_camera) const {
 	// cv::perspectiveTransform does not accept empty vector. this will result points_frame_projector to be empty vector as expected
 	if (!points_frame_camera.empty()) {
@@ -53,35 +241,42 @@ void Projection::createPointsFrameProjectorFromPointsFrameCamera(std::vector<cv:
 }
 
 const scene_interface::People Projection::createPeopleProjectorFromPeopleCamera(const scene_interface::People& people_camera) const {
-	// map std::vector<cv::Point2f> from std::vector<scene_interface::Person> for input this->createPointsFrameProjectorFramePointsFrameCamera
-	std::vector<cv::Point2f> points_camera = std::vector<cv::Point2f>(people_camera.size());
-	for (unsigned int i = 0; i < people_camera.size(); i++) {
-		scene_interface::Location location_person = people_camera.at(i).getLocation();
-		points_camera.at(i) = cv::Point2f(
-			location_person.getX(),
-			location_person.getY()
-		);
+	const unsigned int amount = people_camera.size();
+	// coordinates of every person followed by where every person walks to shortly after, to map the velocity through the perspective too
+	std::vector<float> points_x(2 * amount);
+	std::vector<float> points_y(2 * amount);
+	for (unsigned int i = 0; i < amount; ++i) {
+		const scene_interface::Location location_person = people_camera[i].getLocation();
+		const scene_interface::Location velocity_person = people_camera[i].getVelocity();
+		points_x[i] = location_person.getX();
+		points_y[i] = location_person.getY();
+		points_x[amount + i] = location_person.getX() + velocity_person.getX() * SECONDS_VELOCITY;
+		points_y[amount + i] = location_person.getY() + velocity_person.getY() * SECONDS_VELOCITY;
 	}
-	// fill projector frame points from camera frame points using perspective map
-	std::vector<cv::Point2f> points_projector;
-	this->createPointsFrameProjectorFromPointsFrameCamera(
-		points_projector,
-		points_camera
-	);
+	// map all points to the projector frame in one pass, in place
+	cv::Mat transformation;
+	this->calibration->getCameraProjectorTransformation().convertTo(transformation, CV_64F);
+	const Homography homography(transformation.ptr<double>());
+	homography.apply(points_x.data(), points_y.data(), 2 * amount, points_x.data(), points_y.data());
+
 	// set scene_interface::People location based on mapped projector frame points
 	scene_interface::People people_projector;
-	for (unsigned int i = 0; i < people_camera.size(); ++i) {
-		scene_interface::Person person_camera = people_camera.at(i);
-		// create person type from shared memory person type
-		cv::Point2f point_projector = points_projector.at(i);
+	people_projector.reserve(amount);
+	for (unsigned int i = 0; i < amount; ++i) {
+		const scene_interface::Person& person_camera = people_camera[i];
 		people_projector.push_back(scene_interface::Person(
 			person_camera.getId(),
 			scene_interface::Location(
-				point_projector.x,
-				point_projector.y
+				points_x[i],
+				points_y[i]
 			),
 			person_camera.getPersonType(),
-			person_camera.getMovementType()
+			person_camera.getMovementType(),
+			scene_interface::Location(
+				(points_x[amount + i] - points_x[i]) * (1 / SECONDS_VELOCITY),
+				(points_y[amount + i] - points_y[i]) * (1 / SECONDS_VELOCITY)
+			),
+			person_camera.getTimestampCapture()
 		));
 	}
 	return people_projector;
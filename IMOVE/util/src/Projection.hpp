@@ -3,8 +3,8 @@
 
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <mutex>
 #include <vector>
-#include <queue>
 
 #include "configuration/ImoveConfiguration.hpp"
 #include "../../scene_interface/src/People.h"
@@ -21,19 +21,23 @@ class Projection {
 		Projection(ImoveConfiguration* calibration);
 
 		/**
-		 * Adds a projector frame which is used for eliminating the projection
+		 * Adds a projector frame which is used for eliminating the projection. The frame is copied in a preallocated buffer in place of the oldest projector frame.
+		 * May be called from another thread than eliminating.
 		 * 
-		 * @param frame_projector The next frame of the projection
+		 * @param frame_projector   The next frame of the projection
+		 * @param timestamp_display The steady clock time in nanoseconds on which the frame is displayed
 		 **/
-		void feedFrameProjector(const cv::Mat& frame_projector);
+		void feedFrameProjector(const cv::Mat& frame_projector, long long timestamp_display);
 
 		/**
-		 * Removes the projection on the camera frame based on fed projector frames, the amount of frames to delay and the projector background light level.
+		 * Removes the projection on the camera frame based on the fed projector frame displayed when the camera frame was exposed, and the projector background light level.
+		 * Without such a projector frame the camera frame is passed on as is.
 		 * 
 		 * @param frame_projectioneliminated	The output camera frame on which the projection is eliminated
 		 * @param frame_camera								The input camera frame
+		 * @param timestamp_capture						The steady clock time in nanoseconds on which the camera frame is captured
 		 **/
-		void eliminateProjectionFeedbackFromFrameCamera(cv::Mat& frame_projectioneliminated, const cv::Mat& frame_camera);
+		void eliminateProjectionFeedbackFromFrameCamera(cv::Mat& frame_projectioneliminated, const cv::Mat& frame_camera, long long timestamp_capture);
 
 		/**
 		 * Creates points on the projector frame from the camera frame based on the given camera_projector_transformation
@@ -60,8 +64,43 @@ class Projection {
 		void createFrameProjectionFromFrameCamera(cv::Mat& frame_projection, const cv::Mat& frame_camera) const;
 
 	protected:
-		// The queue with the projector frames which are not yet expected to be captured by the camera frame
-		std::queue<cv::Mat> frames_delay_projector;
+		// Rows of the camera frame which are warped and subtracted by one core, small enough to stay in cache in between
+		static const int ROWS_STRIP = 16;
+
+		// Projector frames kept to find the one captured by a camera frame, enough to span the latency at the frame rate of the scene
+		static const unsigned int FRAMES_RING_PROJECTOR = 16;
+
+		// Projector frame with the time it is displayed
+		struct FrameProjector {
+			cv::Mat frame;
+			// steady clock nanoseconds on which the frame is displayed, -1 while empty or being written
+			long long timestamp_display;
+			// amount of eliminations reading the frame, which is not overwritten meanwhile
+			unsigned int readers;
+		};
+
+		// Ring of projector frames whose buffers are reused, the oldest one is overwritten by the next projector frame
+		FrameProjector frames_projector[FRAMES_RING_PROJECTOR];
+		// Guards the timestamps and readers of the projector frames, not their pixels
+		std::mutex mutex_frames_projector;
+		// Blend of the two projector frames displayed during the exposure of a camera frame
+		cv::Mat frame_blended;
+
+		// Camera projector transformation, camera frame size and projector frame size for which the maps are computed
+		cv::Mat map_transformation;
+		cv::Size map_size;
+		cv::Size map_size_projector;
+		// For every camera pixel the projector pixel it shows, in fixed point: integer coordinates and interpolation weights
+		cv::Mat map_coordinates;
+		cv::Mat map_weights;
+
+		/**
+		 * Computes the maps from camera pixels to projector pixels again when the transformation or the frame sizes changed
+		 *
+		 * @param size_camera    The size of the camera frame
+		 * @param size_projector The size of the projector frame, which may be downscaled from the projector resolution
+		 **/
+		void updateMaps(const cv::Size& size_camera, const cv::Size& size_projector);
 		
 		// The calibration including configuration of camera and projector
 		ImoveConfiguration* calibration;
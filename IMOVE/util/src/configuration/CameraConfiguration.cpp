@@ -8,13 +8,23 @@
 #include "../OpenCVUtil.hpp"
 #include "CameraConfiguration.hpp"
 
-CameraConfiguration::CameraConfiguration(const cv::Size& resolution, unsigned int deviceid, const Boundary& projection, float meter, float area, float dist) : Configuration(),
+CameraConfiguration::CameraConfiguration(const cv::Size& resolution, unsigned int deviceid, const Boundary& projection, float meter, float area, float dist, BlobDetector blob_detector, unsigned int blob_morphology_size, bool roi, float roi_margin, BackgroundModel background_model, float background_learning_rate, bool background_shadows, float match_distance, float track_acceleration, float track_measurement_noise) : Configuration(),
 	resolution(resolution),
 	deviceid(deviceid),
 	projection(projection),
 	meter(meter),
 	minBlobArea(area),
-	minBlobDistance(dist)
+	minBlobDistance(dist),
+	blob_detector(blob_detector),
+	blob_morphology_size(blob_morphology_size),
+	roi(roi),
+	roi_margin(roi_margin),
+	background_model(background_model),
+	background_learning_rate(background_learning_rate),
+	background_shadows(background_shadows),
+	match_distance(match_distance),
+	track_acceleration(track_acceleration),
+	track_measurement_noise(track_measurement_noise)
 {
 	this->setProjection(projection);
 }
@@ -50,7 +60,17 @@ CameraConfiguration* CameraConfiguration::readNode(cv::FileStorage read_config)
 		),
 		meter,
 		area,
-		distance
+		distance,
+		(BlobDetector) Configuration::create(read_config, "Blob_detector", CameraConfiguration::DEFAULT_BLOB_DETECTOR),
+		Configuration::create(read_config, "Blob_morphology_size", CameraConfiguration::DEFAULT_BLOB_MORPHOLOGY_SIZE),
+		Configuration::createFlag(read_config, "Roi", CameraConfiguration::DEFAULT_ROI),
+		Configuration::createFloat(read_config, "Roi_margin", CameraConfiguration::DEFAULT_ROI_MARGIN),
+		(BackgroundModel) Configuration::create(read_config, "Background_model", CameraConfiguration::DEFAULT_BACKGROUND_MODEL),
+		Configuration::createFloat(read_config, "Background_learning_rate", CameraConfiguration::DEFAULT_BACKGROUND_LEARNING_RATE),
+		Configuration::createFlag(read_config, "Background_shadows", CameraConfiguration::DEFAULT_BACKGROUND_SHADOWS),
+		Configuration::createFloat(read_config, "Match_distance", CameraConfiguration::DEFAULT_MATCH_DISTANCE),
+		Configuration::createFloat(read_config, "Track_acceleration", CameraConfiguration::DEFAULT_TRACK_ACCELERATION),
+		Configuration::createFloat(read_config, "Track_measurement_noise", CameraConfiguration::DEFAULT_TRACK_MEASUREMENT_NOISE)
 	);
 }
 
@@ -113,7 +133,17 @@ CameraConfiguration* CameraConfiguration::createFromNode(cv::FileStorage read_co
 		projection,
 		meter,
 		area,
-		distance
+		distance,
+		(BlobDetector) Configuration::create(read_config, "Blob_detector", CameraConfiguration::DEFAULT_BLOB_DETECTOR),
+		Configuration::create(read_config, "Blob_morphology_size", CameraConfiguration::DEFAULT_BLOB_MORPHOLOGY_SIZE),
+		Configuration::createFlag(read_config, "Roi", CameraConfiguration::DEFAULT_ROI),
+		Configuration::createFloat(read_config, "Roi_margin", CameraConfiguration::DEFAULT_ROI_MARGIN),
+		(BackgroundModel) Configuration::create(read_config, "Background_model", CameraConfiguration::DEFAULT_BACKGROUND_MODEL),
+		Configuration::createFloat(read_config, "Background_learning_rate", CameraConfiguration::DEFAULT_BACKGROUND_LEARNING_RATE),
+		Configuration::createFlag(read_config, "Background_shadows", CameraConfiguration::DEFAULT_BACKGROUND_SHADOWS),
+		Configuration::createFloat(read_config, "Match_distance", CameraConfiguration::DEFAULT_MATCH_DISTANCE),
+		Configuration::createFloat(read_config, "Track_acceleration", CameraConfiguration::DEFAULT_TRACK_ACCELERATION),
+		Configuration::createFloat(read_config, "Track_measurement_noise", CameraConfiguration::DEFAULT_TRACK_MEASUREMENT_NOISE)
 	);
 }
 
@@ -125,6 +155,16 @@ void CameraConfiguration::writeNode(cv::FileStorage write_config) const {
 	write_config << "Projection_bottom_left"            <<       cv::Point2f( this->projection.getLowerLeft().x,  this->projection.getLowerLeft().y);
 	write_config << "Projection_bottom_right"           <<       cv::Point2f(this->projection.getLowerRight().x, this->projection.getLowerRight().y);
 	write_config << "Meter_camera"                      <<       this->meter;
+	write_config << "Blob_detector"                     << (int) this->blob_detector;
+	write_config << "Blob_morphology_size"              << (int) this->blob_morphology_size;
+	write_config << "Roi"                               << (int) this->roi;
+	write_config << "Roi_margin"                        <<       this->roi_margin;
+	write_config << "Background_model"                  << (int) this->background_model;
+	write_config << "Background_learning_rate"          <<       this->background_learning_rate;
+	write_config << "Background_shadows"                << (int) this->background_shadows;
+	write_config << "Match_distance"                    <<       this->match_distance;
+	write_config << "Track_acceleration"                <<       this->track_acceleration;
+	write_config << "Track_measurement_noise"           <<       this->track_measurement_noise;
 }
 
 cv::Size CameraConfiguration::getResolution() const {
@@ -151,3 +191,63 @@ const float CameraConfiguration::getMinBlobArea() {
 const float CameraConfiguration::getMinBlobDistance() {
 	return this->minBlobDistance;
 }
+CameraConfiguration::BlobDetector CameraConfiguration::getBlobDetector() const {
+	return this->blob_detector;
+}
+void CameraConfiguration::setBlobDetector(BlobDetector blob_detector) {
+	this->blob_detector = blob_detector;
+}
+unsigned int CameraConfiguration::getBlobMorphologySize() const {
+	return this->blob_morphology_size;
+}
+void CameraConfiguration::setBlobMorphologySize(unsigned int blob_morphology_size) {
+	this->blob_morphology_size = blob_morphology_size;
+}
+bool CameraConfiguration::getRoi() const {
+	return this->roi;
+}
+void CameraConfiguration::setRoi(bool roi) {
+	this->roi = roi;
+}
+float CameraConfiguration::getRoiMargin() const {
+	return this->roi_margin;
+}
+void CameraConfiguration::setRoiMargin(float roi_margin) {
+	this->roi_margin = roi_margin;
+}
+CameraConfiguration::BackgroundModel CameraConfiguration::getBackgroundModel() const {
+	return this->background_model;
+}
+void CameraConfiguration::setBackgroundModel(BackgroundModel background_model) {
+	this->background_model = background_model;
+}
+float CameraConfiguration::getBackgroundLearningRate() const {
+	return this->background_learning_rate;
+}
+void CameraConfiguration::setBackgroundLearningRate(float background_learning_rate) {
+	this->background_learning_rate = background_learning_rate;
+}
+bool CameraConfiguration::getBackgroundShadows() const {
+	return this->background_shadows;
+}
+void CameraConfiguration::setBackgroundShadows(bool background_shadows) {
+	this->background_shadows = background_shadows;
+}
+float CameraConfiguration::getMatchDistance() const {
+	return this->match_distance;
+}
+void CameraConfiguration::setMatchDistance(float match_distance) {
+	this->match_distance = match_distance;
+}
+float CameraConfiguration::getTrackAcceleration() const {
+	return this->track_acceleration;
+}
+void CameraConfiguration::setTrackAcceleration(float track_acceleration) {
+	this->track_acceleration = track_acceleration;
+}
+float CameraConfiguration::getTrackMeasurementNoise() const {
+	return this->track_measurement_noise;
+}
+void CameraConfiguration::setTrackMeasurementNoise(float track_measurement_noise) {
+	this->track_measurement_noise = track_measurement_noise;
+}
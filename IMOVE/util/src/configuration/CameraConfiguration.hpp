@@ -9,8 +9,34 @@
 // Mappings for projector frames and points from camera frames and points based on camera and projector properties
 class CameraConfiguration : public Configuration {
 	public:
+		// Backends to detect blobs of people in the foreground of camera frames
+		enum BlobDetector {
+			// opencv SimpleBlobDetector, which thresholds and extracts contours on several levels
+			BLOB_DETECTOR_SIMPLE = 0,
+			// single pass connected components labelling
+			BLOB_DETECTOR_CONNECTED_COMPONENTS = 1
+		};
+
+		// Backends to model the background of camera frames and find the foreground
+		enum BackgroundModel {
+			// opencv BackgroundSubtractorKNN, which keeps a history of samples per pixel
+			BACKGROUND_MODEL_KNN = 0,
+			// one running gaussian per pixel, updated with vector instructions
+			BACKGROUND_MODEL_GAUSSIAN = 1
+		};
+
 		// Default configuration parameters if not given when createFromFile
 		static constexpr          float  DEFAULT_METER_CAMERA                      = 100.f;
+		static constexpr unsigned int    DEFAULT_BLOB_DETECTOR                     = BLOB_DETECTOR_SIMPLE;
+		static constexpr unsigned int    DEFAULT_BLOB_MORPHOLOGY_SIZE              = 3;
+		static constexpr bool            DEFAULT_ROI                               = false;
+		static constexpr          float  DEFAULT_ROI_MARGIN                        = 1.f;
+		static constexpr unsigned int    DEFAULT_BACKGROUND_MODEL                  = BACKGROUND_MODEL_KNN;
+		static constexpr          float  DEFAULT_BACKGROUND_LEARNING_RATE          = 0.002f;
+		static constexpr bool            DEFAULT_BACKGROUND_SHADOWS                = true;
+		static constexpr          float  DEFAULT_MATCH_DISTANCE                    = 1.f;
+		static constexpr          float  DEFAULT_TRACK_ACCELERATION                = 2.f;
+		static constexpr          float  DEFAULT_TRACK_MEASUREMENT_NOISE           = 0.1f;
 
 		/**
 		 * Setup properties for mapping projector from camera.
@@ -19,8 +45,18 @@ class CameraConfiguration : public Configuration {
 		 * @param deviceid The integer identifier of the camera by the OS
 		 * @param boundary The boundary of the projection on the camera frame
 		 * @param meter The amount of pixels measured as 1 meter on camere frame
+		 * @param blob_detector The backend to detect blobs of people with
+		 * @param blob_morphology_size The size in pixels of the morphological cleanup of the foreground before detecting blobs, 0 for none
+		 * @param roi Whether to only extract people on the projection plus a margin instead of the whole camera frame
+		 * @param roi_margin The margin around the projection in meters
+		 * @param background_model The backend to model the background with
+		 * @param background_learning_rate The part of the background model which is updated per camera frame
+		 * @param background_shadows Whether shadows are recognized and not taken as foreground
+		 * @param match_distance The maximum distance in meters a person moves between camera frames
+		 * @param track_acceleration The typical acceleration of a person in meters per second squared
+		 * @param track_measurement_noise The typical error of a detected location in meters
 		 **/
-		CameraConfiguration(const cv::Size& resolution, unsigned int deviceid, const Boundary& projection, float meter, float area, float dist);
+		CameraConfiguration(const cv::Size& resolution, unsigned int deviceid, const Boundary& projection, float meter, float area, float dist, BlobDetector blob_detector, unsigned int blob_morphology_size, bool roi, float roi_margin, BackgroundModel background_model, float background_learning_rate, bool background_shadows, float match_distance, float track_acceleration, float track_measurement_noise);
 
 		/**
 		 * Creates the CameraConfiguration from a file node by which the filepath is given
@@ -88,6 +124,126 @@ class CameraConfiguration : public Configuration {
  		 **/
 		 const float getMinBlobDistance();
 
+		/**
+		 * Gets the backend to detect blobs of people with
+		 **/
+		BlobDetector getBlobDetector() const;
+
+		/**
+		 * Sets the backend to detect blobs of people with
+		 *
+		 * @param blob_detector The backend to detect blobs of people with
+		 **/
+		void setBlobDetector(BlobDetector blob_detector);
+
+		/**
+		 * Gets the size in pixels of the morphological cleanup of the foreground before detecting blobs, 0 for none
+		 **/
+		unsigned int getBlobMorphologySize() const;
+
+		/**
+		 * Sets the size in pixels of the morphological cleanup of the foreground before detecting blobs
+		 *
+		 * @param blob_morphology_size The size in pixels, 0 for no cleanup
+		 **/
+		void setBlobMorphologySize(unsigned int blob_morphology_size);
+
+		/**
+		 * Gets whether to only extract people on the projection plus a margin instead of the whole camera frame
+		 **/
+		bool getRoi() const;
+
+		/**
+		 * Sets whether to only extract people on the projection plus a margin instead of the whole camera frame
+		 *
+		 * @param roi Whether to only extract people on the region of interest
+		 **/
+		void setRoi(bool roi);
+
+		/**
+		 * Gets the margin around the projection in meters which is part of the region of interest
+		 **/
+		float getRoiMargin() const;
+
+		/**
+		 * Sets the margin around the projection in meters which is part of the region of interest
+		 *
+		 * @param roi_margin The margin in meters
+		 **/
+		void setRoiMargin(float roi_margin);
+
+		/**
+		 * Gets the backend to model the background with
+		 **/
+		BackgroundModel getBackgroundModel() const;
+
+		/**
+		 * Sets the backend to model the background with
+		 *
+		 * @param background_model The backend to model the background with
+		 **/
+		void setBackgroundModel(BackgroundModel background_model);
+
+		/**
+		 * Gets the part of the background model which is updated per camera frame
+		 **/
+		float getBackgroundLearningRate() const;
+
+		/**
+		 * Sets the part of the background model which is updated per camera frame
+		 *
+		 * @param background_learning_rate The learning rate between 0 and 1
+		 **/
+		void setBackgroundLearningRate(float background_learning_rate);
+
+		/**
+		 * Gets whether shadows are recognized and not taken as foreground
+		 **/
+		bool getBackgroundShadows() const;
+
+		/**
+		 * Sets whether shadows are recognized and not taken as foreground
+		 *
+		 * @param background_shadows Whether shadows are recognized
+		 **/
+		void setBackgroundShadows(bool background_shadows);
+
+		/**
+		 * Gets the maximum distance in meters a person moves between camera frames
+		 **/
+		float getMatchDistance() const;
+
+		/**
+		 * Sets the maximum distance in meters a person moves between camera frames
+		 *
+		 * @param match_distance The maximum distance in meters
+		 **/
+		void setMatchDistance(float match_distance);
+
+		/**
+		 * Gets the typical acceleration of a person in meters per second squared
+		 **/
+		float getTrackAcceleration() const;
+
+		/**
+		 * Sets the typical acceleration of a person in meters per second squared
+		 *
+		 * @param track_acceleration The typical acceleration
+		 **/
+		void setTrackAcceleration(float track_acceleration);
+
+		/**
+		 * Gets the typical error of a detected location in meters
+		 **/
+		float getTrackMeasurementNoise() const;
+
+		/**
+		 * Sets the typical error of a detected location in meters
+		 *
+		 * @param track_measurement_noise The typical error
+		 **/
+		void setTrackMeasurementNoise(float track_measurement_noise);
+
 	protected:
 		// The camera resolution
 		cv::Size resolution;
@@ -101,6 +257,26 @@ class CameraConfiguration : public Configuration {
 		float minBlobArea;
 		// Minimum distance between blobs
 		float minBlobDistance;
+		// Backend to detect blobs of people with
+		BlobDetector blob_detector;
+		// Size in pixels of the morphological cleanup of the foreground, 0 for none
+		unsigned int blob_morphology_size;
+		// Only extract people on the projection plus a margin
+		bool roi;
+		// Margin in meters around the projection which is part of the region of interest, where bystanders are
+		float roi_margin;
+		// Backend to model the background with
+		BackgroundModel background_model;
+		// Part of the background model which is updated per camera frame
+		float background_learning_rate;
+		// Recognize shadows so they are not taken as foreground
+		bool background_shadows;
+		// Maximum distance in meters a person moves between camera frames, farther locations are never matched to the person
+		float match_distance;
+		// Typical acceleration of a person in meters per second squared, how much tracks trust their velocity
+		float track_acceleration;
+		// Typical error of a detected location in meters, how much tracks trust detected locations
+		float track_measurement_noise;
 };
 
 #endif // CAMERACONFIGURATION_H
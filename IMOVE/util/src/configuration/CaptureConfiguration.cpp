@@ -0,0 +1,100 @@
+#include "CaptureConfiguration.hpp"
+
+CaptureConfiguration::CaptureConfiguration(Source source, const std::string& recording_file, const std::string& replay_file, bool replay_realtime, unsigned int synthetic_people, unsigned int synthetic_fps, unsigned int synthetic_floor_contrast, bool synthetic_pattern, bool freshest) :
+	source(source),
+	recording_file(recording_file),
+	replay_file(replay_file),
+	replay_realtime(replay_realtime),
+	synthetic_people(synthetic_people),
+	synthetic_fps(synthetic_fps),
+	synthetic_floor_contrast(synthetic_floor_contrast),
+	synthetic_pattern(synthetic_pattern),
+	freshest(freshest)
+{}
+
+CaptureConfiguration* CaptureConfiguration::readNode(cv::FileStorage read_config) {
+	// capture settings are optional so configurations without them keep using the camera
+	return CaptureConfiguration::createFromNode(read_config);
+}
+
+CaptureConfiguration* CaptureConfiguration::createFromNode(cv::FileStorage read_config) {
+	// create initial CaptureConfiguration based on configuration and defaults
+	return new CaptureConfiguration(
+		(Source) Configuration::create(read_config, "Capture_source", CaptureConfiguration::DEFAULT_SOURCE),
+		Configuration::createText(read_config, "Recording_file", ""),
+		Configuration::createText(read_config, "Replay_file", ""),
+		Configuration::createFlag(read_config, "Replay_realtime", CaptureConfiguration::DEFAULT_REPLAY_REALTIME),
+		Configuration::create(read_config, "Synthetic_people", CaptureConfiguration::DEFAULT_SYNTHETIC_PEOPLE),
+		Configuration::create(read_config, "Synthetic_fps", CaptureConfiguration::DEFAULT_SYNTHETIC_FPS),
+		Configuration::create(read_config, "Synthetic_floor_contrast", CaptureConfiguration::DEFAULT_SYNTHETIC_FLOOR_CONTRAST),
+		Configuration::createFlag(read_config, "Synthetic_pattern", CaptureConfiguration::DEFAULT_SYNTHETIC_PATTERN),
+		Configuration::createFlag(read_config, "Capture_freshest", CaptureConfiguration::DEFAULT_FRESHEST)
+	);
+}
+
+void CaptureConfiguration::writeNode(cv::FileStorage write_config) const {
+	write_config << "Capture_source"  << (int) this->source;
+	write_config << "Recording_file"  <<       this->recording_file;
+	write_config << "Replay_file"     <<       this->replay_file;
+	write_config << "Replay_realtime" << (int) this->replay_realtime;
+	write_config << "Synthetic_people"         << (int) this->synthetic_people;
+	write_config << "Synthetic_fps"            << (int) this->synthetic_fps;
+	write_config << "Synthetic_floor_contrast" << (int) this->synthetic_floor_contrast;
+	write_config << "Synthetic_pattern"        << (int) this->synthetic_pattern;
+	write_config << "Capture_freshest"         << (int) this->freshest;
+}
+
+CaptureConfiguration::Source CaptureConfiguration::getSource() const {
+	return this->source;
+}
+void CaptureConfiguration::setSource(Source source) {
+	this->source = source;
+}
+const std::string& CaptureConfiguration::getRecordingFile() const {
+	return this->recording_file;
+}
+void CaptureConfiguration::setRecordingFile(const std::string& recording_file) {
+	this->recording_file = recording_file;
+}
+const std::string& CaptureConfiguration::getReplayFile() const {
+	return this->replay_file;
+}
+void CaptureConfiguration::setReplayFile(const std::string& replay_file) {
+	this->replay_file = replay_file;
+}
+bool CaptureConfiguration::getReplayRealtime() const {
+	return this->replay_realtime;
+}
+void CaptureConfiguration::setReplayRealtime(bool replay_realtime) {
+	this->replay_realtime = replay_realtime;
+}
+unsigned int CaptureConfiguration::getSyntheticPeople() const {
+	return this->synthetic_people;
+}
+void CaptureConfiguration::setSyntheticPeople(unsigned int synthetic_people) {
+	this->synthetic_people = synthetic_people;
+}
+unsigned int CaptureConfiguration::getSyntheticFps() const {
+	return this->synthetic_fps;
+}
+void CaptureConfiguration::setSyntheticFps(unsigned int synthetic_fps) {
+	this->synthetic_fps = synthetic_fps;
+}
+unsigned int CaptureConfiguration::getSyntheticFloorContrast() const {
+	return this->synthetic_floor_contrast;
+}
+void CaptureConfiguration::setSyntheticFloorContrast(unsigned int synthetic_floor_contrast) {
+	this->synthetic_floor_contrast = synthetic_floor_contrast;
+}
+bool CaptureConfiguration::getSyntheticPattern() const {
+	return this->synthetic_pattern;
+}
+void CaptureConfiguration::setSyntheticPattern(bool synthetic_pattern) {
+	this->synthetic_pattern = synthetic_pattern;
+}
+bool CaptureConfiguration::getFreshest() const {
+	return this->freshest;
+}
+void CaptureConfiguration::setFreshest(bool freshest) {
+	this->freshest = freshest;
+}
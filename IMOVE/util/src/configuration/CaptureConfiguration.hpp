@@ -0,0 +1,197 @@
+#ifndef CAPTURECONFIGURATION_H
+#define CAPTURECONFIGURATION_H
+
+#include <string>
+
+#include "Configuration.hpp"
+
+// Configuration variables for the source of camera frames of the people extractor and recording them
+class CaptureConfiguration : public Configuration {
+	public:
+		// Sources of camera frames
+		enum Source {
+			// camera frames from the camera device
+			SOURCE_CAMERA = 0,
+			// camera frames from a recording which are extracted again
+			SOURCE_REPLAY_FRAMES = 1,
+			// extracted people from a recording which are sent to the scene without extracting
+			SOURCE_REPLAY_PEOPLE = 2,
+			// generated camera frames of a synthetic crowd which are extracted
+			SOURCE_SYNTHETIC = 3
+		};
+
+		// Default configuration parameters if not given when createFromNode
+		static constexpr unsigned int DEFAULT_SOURCE          = SOURCE_CAMERA;
+		static constexpr bool         DEFAULT_REPLAY_REALTIME = true;
+		static constexpr unsigned int DEFAULT_SYNTHETIC_PEOPLE = 20;
+		static constexpr unsigned int DEFAULT_SYNTHETIC_FPS = 30;
+		static constexpr unsigned int DEFAULT_SYNTHETIC_FLOOR_CONTRAST = 40;
+		static constexpr bool         DEFAULT_SYNTHETIC_PATTERN = true;
+		static constexpr bool         DEFAULT_FRESHEST = true;
+
+		/**
+		 * Setup properties for the source of camera frames.
+		 *
+		 * @param source          The source of camera frames
+		 * @param recording_file  The path of the file to record camera frames and extracted people to, empty to not record
+		 * @param replay_file     The path of the recording to replay when the source is a replay
+		 * @param replay_realtime Whether to replay on recorded speed instead of as fast as possible
+		 * @param synthetic_people The amount of people in the synthetic crowd
+		 * @param synthetic_fps The camera frames per second of the synthetic crowd
+		 * @param synthetic_floor_contrast The contrast of the texture of the floor of the synthetic crowd
+		 * @param synthetic_pattern Whether to project a moving pattern on the synthetic crowd
+		 * @param freshest        Whether to grab camera frames continuously and only extract people from the newest
+		 **/
+		CaptureConfiguration(Source source, const std::string& recording_file, const std::string& replay_file, bool replay_realtime, unsigned int synthetic_people, unsigned int synthetic_fps, unsigned int synthetic_floor_contrast, bool synthetic_pattern, bool freshest);
+
+		/**
+		 * Creates the CaptureConfiguration from a file node; default if not existing, as all settings are optional
+		 *
+		 * @param read_config File node from which to read CaptureConfiguration
+		 **/
+		static CaptureConfiguration* readNode(cv::FileStorage read_config);
+
+		/**
+		 * Creates the CaptureConfiguration from a file node and defaults
+		 *
+		 * @param read_config File node from which to load CaptureConfiguration
+		 **/
+		static CaptureConfiguration* createFromNode(cv::FileStorage read_config);
+
+		/**
+		 * Creates the file by which the filepath is given from the CaptureConfiguration
+		 *
+		 * @param write_config File node to which to save CaptureConfiguration
+		 **/
+		void writeNode(cv::FileStorage write_config) const;
+
+		/**
+		 * Gets the source of camera frames
+		 **/
+		Source getSource() const;
+
+		/**
+		 * Sets the source of camera frames
+		 *
+		 * @param source The source of camera frames
+		 **/
+		void setSource(Source source);
+
+		/**
+		 * Gets the path of the file to record camera frames and extracted people to, empty when not recording
+		 **/
+		const std::string& getRecordingFile() const;
+
+		/**
+		 * Sets the path of the file to record camera frames and extracted people to
+		 *
+		 * @param recording_file The path of the file, empty to not record
+		 **/
+		void setRecordingFile(const std::string& recording_file);
+
+		/**
+		 * Gets the path of the recording to replay
+		 **/
+		const std::string& getReplayFile() const;
+
+		/**
+		 * Sets the path of the recording to replay
+		 *
+		 * @param replay_file The path of the recording
+		 **/
+		void setReplayFile(const std::string& replay_file);
+
+		/**
+		 * Gets whether to replay on recorded speed instead of as fast as possible
+		 **/
+		bool getReplayRealtime() const;
+
+		/**
+		 * Sets whether to replay on recorded speed instead of as fast as possible
+		 *
+		 * @param replay_realtime Whether to replay on recorded speed
+		 **/
+		void setReplayRealtime(bool replay_realtime);
+
+		/**
+		 * Gets the amount of people in the synthetic crowd
+		 **/
+		unsigned int getSyntheticPeople() const;
+
+		/**
+		 * Sets the amount of people in the synthetic crowd
+		 *
+		 * @param synthetic_people The amount of people
+		 **/
+		void setSyntheticPeople(unsigned int synthetic_people);
+
+		/**
+		 * Gets the camera frames per second of the synthetic crowd
+		 **/
+		unsigned int getSyntheticFps() const;
+
+		/**
+		 * Sets the camera frames per second of the synthetic crowd
+		 *
+		 * @param synthetic_fps The camera frames per second, 0 to generate as fast as possible
+		 **/
+		void setSyntheticFps(unsigned int synthetic_fps);
+
+		/**
+		 * Gets the contrast of the texture of the floor of the synthetic crowd
+		 **/
+		unsigned int getSyntheticFloorContrast() const;
+
+		/**
+		 * Sets the contrast of the texture of the floor of the synthetic crowd
+		 *
+		 * @param synthetic_floor_contrast The contrast in gray levels, 0 for a plain floor
+		 **/
+		void setSyntheticFloorContrast(unsigned int synthetic_floor_contrast);
+
+		/**
+		 * Gets whether to project a moving pattern on the synthetic crowd
+		 **/
+		bool getSyntheticPattern() const;
+
+		/**
+		 * Sets whether to project a moving pattern on the synthetic crowd
+		 *
+		 * @param synthetic_pattern Whether to project a moving pattern
+		 **/
+		void setSyntheticPattern(bool synthetic_pattern);
+
+		/**
+		 * Gets whether to grab camera frames continuously and only extract people from the newest
+		 **/
+		bool getFreshest() const;
+
+		/**
+		 * Sets whether to grab camera frames continuously and only extract people from the newest
+		 *
+		 * @param freshest Whether to only extract people from the newest camera frame, instead of from every camera frame in order
+		 **/
+		void setFreshest(bool freshest);
+
+	protected:
+		// source of camera frames
+		Source source;
+		// path of the file to record to, empty when not recording
+		std::string recording_file;
+		// path of the recording to replay
+		std::string replay_file;
+		// replay on recorded speed instead of as fast as possible
+		bool replay_realtime;
+		// amount of people in the synthetic crowd
+		unsigned int synthetic_people;
+		// camera frames per second of the synthetic crowd, 0 for as fast as possible
+		unsigned int synthetic_fps;
+		// contrast in gray levels of the texture of the floor of the synthetic crowd
+		unsigned int synthetic_floor_contrast;
+		// project a moving pattern on the synthetic crowd
+		bool synthetic_pattern;
+		// grab camera frames continuously and only extract people from the newest
+		bool freshest;
+};
+
+#endif // CAPTURECONFIGURATION_H
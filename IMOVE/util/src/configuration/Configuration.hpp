@@ -3,6 +3,7 @@
 
 #include <opencv2/core/persistence.hpp>
 #include <assert.h>
+#include <string>
 
 // Class for reading configuration from yml node
 class Configuration {
@@ -53,6 +54,57 @@ class Configuration {
 			}
 			return unsigned_int;
 		}
+
+		/**
+		 * Creates an on/off setting from configuration node using given name and if not exists use default
+		 *
+		 * @param fn           opencv yml configuration node
+		 * @param name_yml     name of setting in yml configuration, 0 is off and 1 is on
+		 * @param default_flag if not given returns this default
+		 **/
+		static inline bool createFlag(cv::FileStorage fn, char const* name_yml, bool default_flag) {
+			bool flag;
+			if (fn[name_yml].isNone()) {
+				flag = default_flag;
+			} else {
+				fn[name_yml] >> flag;
+			}
+			return flag;
+		}
+
+		/**
+		 * Creates a real number from configuration node using given name and if not exists use default
+		 *
+		 * @param fn            opencv yml configuration node
+		 * @param name_yml      name of real number property in yml configuration
+		 * @param default_float if not given returns this default real number
+		 **/
+		static inline float createFloat(cv::FileStorage fn, char const* name_yml, float default_float) {
+			float real;
+			if (fn[name_yml].isNone()) {
+				real = default_float;
+			} else {
+				fn[name_yml] >> real;
+			}
+			return real;
+		}
+
+		/**
+		 * Creates a text from configuration node using given name and if not exists use default
+		 *
+		 * @param fn           opencv yml configuration node
+		 * @param name_yml     name of text property in yml configuration
+		 * @param default_text if not given returns this default text
+		 **/
+		static inline std::string createText(cv::FileStorage fn, char const* name_yml, const std::string& default_text) {
+			std::string text;
+			if (fn[name_yml].isNone()) {
+				text = default_text;
+			} else {
+				fn[name_yml] >> text;
+			}
+			return text;
+		}
 };
 
 #endif // CONFIGURATION_H
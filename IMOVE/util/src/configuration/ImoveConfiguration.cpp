@@ -1,11 +1,15 @@
 #include "ImoveConfiguration.hpp"
 #include "../OpenCVUtil.hpp"
 
-ImoveConfiguration::ImoveConfiguration(const bool debug_mode, CameraConfiguration* camera_configuration, ProjectorConfiguration* projector_configuration, ProjectioneliminationConfiguration* projectionelimination_configuration) :
+ImoveConfiguration::ImoveConfiguration(const bool debug_mode, const bool people_snapshot_mode, const bool lock_shared_memory, CameraConfiguration* camera_configuration, ProjectorConfiguration* projector_configuration, ProjectioneliminationConfiguration* projectionelimination_configuration, CaptureConfiguration* capture_configuration, PipelineConfiguration* pipeline_configuration) : Configuration(),
 debug_mode(debug_mode),
+people_snapshot_mode(people_snapshot_mode),
+lock_shared_memory(lock_shared_memory),
 camera_configuration(camera_configuration),
 projector_configuration(projector_configuration),
-projectionelimination_configuration(projectionelimination_configuration)
+projectionelimination_configuration(projectionelimination_configuration),
+capture_configuration(capture_configuration),
+pipeline_configuration(pipeline_configuration)
 {
 	this->deriveCameraProjectorTransformation();
 	this->deriveMeterProjectorFromMeterCamera();
@@ -19,16 +23,26 @@ ImoveConfiguration* ImoveConfiguration::readFile(const char* filepath) {
 	// read debug mode from yml using OpenCV FileNode
 	bool debug_mode;
 	read_config["Debug_mode"] >> debug_mode;
+	// read people snapshot mode from yml using OpenCV FileNode; default if not existing
+	bool people_snapshot_mode = Configuration::createFlag(read_config, "People_snapshot_mode", ImoveConfiguration::DEFAULT_PEOPLE_SNAPSHOT_MODE);
+	// read lock shared memory from yml using OpenCV FileNode; default if not existing
+	bool lock_shared_memory = Configuration::createFlag(read_config, "Lock_shared_memory", ImoveConfiguration::DEFAULT_LOCK_SHARED_MEMORY);
  	
 	// create initial ImoveConfiguration based on configuration and defaults
 	CameraConfiguration* camera_configuration = CameraConfiguration::readNode(read_config);
 	ProjectorConfiguration* projector_configuration = ProjectorConfiguration::readNode(read_config);
 	ProjectioneliminationConfiguration* projectionelimination_configuration = ProjectioneliminationConfiguration::readNode(read_config);
+	CaptureConfiguration* capture_configuration = CaptureConfiguration::readNode(read_config);
+	PipelineConfiguration* pipeline_configuration = PipelineConfiguration::readNode(read_config);
 	ImoveConfiguration* calibration = new ImoveConfiguration(
 		debug_mode,
+		people_snapshot_mode,
+		lock_shared_memory,
 		camera_configuration,
 		projector_configuration,
-		projectionelimination_configuration
+		projectionelimination_configuration,
+		capture_configuration,
+		pipeline_configuration
 	);
 
 	read_config.release();
@@ -47,16 +61,26 @@ ImoveConfiguration* ImoveConfiguration::createFromFile(const char* filepath, con
 	} else {
 		read_config["Debug_mode"] >> debug_mode;
 	}
+	// read people snapshot mode from yml using OpenCV FileNode; default if not existing
+	bool people_snapshot_mode = Configuration::createFlag(read_config, "People_snapshot_mode", ImoveConfiguration::DEFAULT_PEOPLE_SNAPSHOT_MODE);
+	// read lock shared memory from yml using OpenCV FileNode; default if not existing
+	bool lock_shared_memory = Configuration::createFlag(read_config, "Lock_shared_memory", ImoveConfiguration::DEFAULT_LOCK_SHARED_MEMORY);
 	
  	// create initial ImoveConfiguration based on configuration and defaults
 	CameraConfiguration* camera_configuration = CameraConfiguration::createFromNode(read_config, deviceid_camera);
 	ProjectorConfiguration* projector_configuration = ProjectorConfiguration::createFromNode(read_config, resolution_projector);
 	ProjectioneliminationConfiguration* projectionelimination_configuration = ProjectioneliminationConfiguration::createFromNode(read_config);
+	CaptureConfiguration* capture_configuration = CaptureConfiguration::createFromNode(read_config);
+	PipelineConfiguration* pipeline_configuration = PipelineConfiguration::createFromNode(read_config);
 	ImoveConfiguration* calibration = new ImoveConfiguration(
 		debug_mode,
+		people_snapshot_mode,
+		lock_shared_memory,
 		camera_configuration,
 		projector_configuration,
-		projectionelimination_configuration
+		projectionelimination_configuration,
+		capture_configuration,
+		pipeline_configuration
 	);
 
 	read_config.release();
@@ -69,10 +93,14 @@ void ImoveConfiguration::writeFile(const char* filepath) const {
 	cv::FileStorage write_config(filepath, cv::FileStorage::WRITE);
 	
 	write_config << "Debug_mode" << (int) this->debug_mode;
+	write_config << "People_snapshot_mode" << (int) this->people_snapshot_mode;
+	write_config << "Lock_shared_memory" << (int) this->lock_shared_memory;
 
 	this->camera_configuration->writeNode(write_config);
 	this->projector_configuration->writeNode(write_config);
 	this->projectionelimination_configuration->writeNode(write_config);
+	this->capture_configuration->writeNode(write_config);
+	this->pipeline_configuration->writeNode(write_config);
 	
 	write_config.release();
 }
@@ -89,6 +117,14 @@ ProjectioneliminationConfiguration* ImoveConfiguration::getProjectionelimination
 	return this->projectionelimination_configuration;
 }
 
+CaptureConfiguration* ImoveConfiguration::getCaptureConfiguration() const {
+	return this->capture_configuration;
+}
+
+PipelineConfiguration* ImoveConfiguration::getPipelineConfiguration() const {
+	return this->pipeline_configuration;
+}
+
 void ImoveConfiguration::deriveMeterProjectorFromMeterCamera() {
 	std::vector<cv::Point2f> projector_points;
 	std::vector<cv::Point2f> camera_points;
@@ -146,3 +182,10 @@ const cv::Mat ImoveConfiguration::getCameraProjectorTransformation() {
 const bool ImoveConfiguration::getDebugMode() const {
 	return this->debug_mode;
 }
+const bool ImoveConfiguration::getPeopleSnapshotMode() const {
+	return this->people_snapshot_mode;
+}
+
+const bool ImoveConfiguration::getLockSharedMemory() const {
+	return this->lock_shared_memory;
+}
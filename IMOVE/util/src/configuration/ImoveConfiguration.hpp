@@ -1,24 +1,33 @@
 #ifndef IMOVECONFIGURATION_H
 #define IMOVECONFIGURATION_H
 
+#include "Configuration.hpp"
 #include "CameraConfiguration.hpp"
 #include "ProjectorConfiguration.hpp"
 #include "ProjectioneliminationConfiguration.hpp"
+#include "CaptureConfiguration.hpp"
+#include "PipelineConfiguration.hpp"
 
 // Class for reading configuration from yml file
-class ImoveConfiguration {
+class ImoveConfiguration : public Configuration {
 	public:
 		static const bool DEFAULT_DEBUG_MODE = true;
+		static const bool DEFAULT_PEOPLE_SNAPSHOT_MODE = false;
+		static const bool DEFAULT_LOCK_SHARED_MEMORY = false;
 		
 		/**
 		 * Setup properties for configuration.
 		 *
 		 * @param debug_mode                          The debug mode
+		 * @param people_snapshot_mode                Whether the scene reads only the latest extracted people instead of queued extracted people
+		 * @param lock_shared_memory                  Whether the processes lock the shared memory in memory
 		 * @param camera_configuration                The configuration for the camera
 		 * @param projector_configuration             The configuration for the projector
 		 * @param projectionelimination_configuration The configuration for the projection elimination
+		 * @param capture_configuration               The configuration for the source of camera frames
+		 * @param pipeline_configuration              The configuration for the stages of the people extractor
 		 **/
-		ImoveConfiguration(const bool debug_mode, CameraConfiguration* camera_configuration, ProjectorConfiguration* projector_configuration, ProjectioneliminationConfiguration* projectionelimination_configuration);
+		ImoveConfiguration(const bool debug_mode, const bool people_snapshot_mode, const bool lock_shared_memory, CameraConfiguration* camera_configuration, ProjectorConfiguration* projector_configuration, ProjectioneliminationConfiguration* projectionelimination_configuration, CaptureConfiguration* capture_configuration, PipelineConfiguration* pipeline_configuration);
 
 		/**
 		 * Creates the ImoveConfiguration from a file by which the filepath is given
@@ -60,6 +69,16 @@ class ImoveConfiguration {
 		 * Gets debug mode 
 		 **/
 		const bool getDebugMode() const;
+
+		/**
+		 * Gets whether extracted people are published as latest snapshot instead of queued
+		 **/
+		const bool getPeopleSnapshotMode() const;
+
+		/**
+		 * Gets whether the shared memory is locked in memory so it is never swapped out
+		 **/
+		const bool getLockSharedMemory() const;
 		
 		/**
 		 * Get the camera configuration
@@ -76,11 +95,25 @@ class ImoveConfiguration {
 		 **/
 		ProjectioneliminationConfiguration* getProjectioneliminationConfiguration() const;
 
+		/**
+		 * Get the capture configuration
+		 **/
+		CaptureConfiguration* getCaptureConfiguration() const;
+
+		/**
+		 * Get the pipeline configuration
+		 **/
+		PipelineConfiguration* getPipelineConfiguration() const;
+
 	protected:
 		const bool debug_mode;
+		const bool people_snapshot_mode;
+		const bool lock_shared_memory;
 		CameraConfiguration* camera_configuration;
 		ProjectorConfiguration* projector_configuration;
 		ProjectioneliminationConfiguration* projectionelimination_configuration;
+		CaptureConfiguration* capture_configuration;
+		PipelineConfiguration* pipeline_configuration;
 
 		cv::Mat camera_projector_transformation;
 };
@@ -0,0 +1,66 @@
+#include <algorithm>
+
+#include "PipelineConfiguration.hpp"
+
+PipelineConfiguration::PipelineConfiguration(unsigned int queue_capacity, DropPolicy drop_policy, unsigned int debug_fps, unsigned int budget_ms, Ingestion ingestion) :
+	queue_capacity(std::max(1u, queue_capacity)),
+	drop_policy(drop_policy),
+	debug_fps(debug_fps),
+	budget_ms(budget_ms),
+	ingestion(ingestion)
+{}
+
+PipelineConfiguration* PipelineConfiguration::readNode(cv::FileStorage read_config) {
+	// pipeline settings are optional so configurations without them keep the defaults
+	return PipelineConfiguration::createFromNode(read_config);
+}
+
+PipelineConfiguration* PipelineConfiguration::createFromNode(cv::FileStorage read_config) {
+	// create initial PipelineConfiguration based on configuration and defaults
+	return new PipelineConfiguration(
+		Configuration::create(read_config, "Pipeline_queue_capacity", PipelineConfiguration::DEFAULT_QUEUE_CAPACITY),
+		(DropPolicy) Configuration::create(read_config, "Pipeline_drop_policy", PipelineConfiguration::DEFAULT_DROP_POLICY),
+		Configuration::create(read_config, "Pipeline_debug_fps", PipelineConfiguration::DEFAULT_DEBUG_FPS),
+		Configuration::create(read_config, "Pipeline_budget_ms", PipelineConfiguration::DEFAULT_BUDGET_MS),
+		(Ingestion) Configuration::create(read_config, "Pipeline_ingestion", PipelineConfiguration::DEFAULT_INGESTION)
+	);
+}
+
+void PipelineConfiguration::writeNode(cv::FileStorage write_config) const {
+	write_config << "Pipeline_queue_capacity" << (int) this->queue_capacity;
+	write_config << "Pipeline_drop_policy"    << (int) this->drop_policy;
+	write_config << "Pipeline_debug_fps"      << (int) this->debug_fps;
+	write_config << "Pipeline_budget_ms"      << (int) this->budget_ms;
+	write_config << "Pipeline_ingestion"      << (int) this->ingestion;
+}
+
+unsigned int PipelineConfiguration::getQueueCapacity() const {
+	return this->queue_capacity;
+}
+void PipelineConfiguration::setQueueCapacity(unsigned int queue_capacity) {
+	this->queue_capacity = std::max(1u, queue_capacity);
+}
+PipelineConfiguration::DropPolicy PipelineConfiguration::getDropPolicy() const {
+	return this->drop_policy;
+}
+void PipelineConfiguration::setDropPolicy(DropPolicy drop_policy) {
+	this->drop_policy = drop_policy;
+}
+unsigned int PipelineConfiguration::getDebugFps() const {
+	return this->debug_fps;
+}
+void PipelineConfiguration::setDebugFps(unsigned int debug_fps) {
+	this->debug_fps = debug_fps;
+}
+unsigned int PipelineConfiguration::getBudgetMs() const {
+	return this->budget_ms;
+}
+void PipelineConfiguration::setBudgetMs(unsigned int budget_ms) {
+	this->budget_ms = budget_ms;
+}
+PipelineConfiguration::Ingestion PipelineConfiguration::getIngestion() const {
+	return this->ingestion;
+}
+void PipelineConfiguration::setIngestion(Ingestion ingestion) {
+	this->ingestion = ingestion;
+}
@@ -0,0 +1,141 @@
+#ifndef PIPELINECONFIGURATION_H
+#define PIPELINECONFIGURATION_H
+
+#include "Configuration.hpp"
+
+// Configuration variables for the stages of the people extractor which run on their own threads
+class PipelineConfiguration : public Configuration {
+	public:
+		// What a stage does with a camera frame when the queue to the next stage is full
+		enum DropPolicy {
+			// drop the oldest queued camera frame, so the next stage always gets the freshest one
+			DROP_POLICY_OLDEST = 0,
+			// drop the new camera frame, so queued camera frames are kept
+			DROP_POLICY_NEWEST = 1,
+			// wait till the next stage took a camera frame, so no camera frame is dropped
+			DROP_POLICY_BLOCK = 2
+		};
+
+		// What camera frames are converted to on ingestion, before eliminating the projection and detecting people
+		enum Ingestion {
+			// color camera frames, as captured
+			INGESTION_BGR = 0,
+			// grayscale camera frames, converted from color while resizing
+			INGESTION_GRAY = 1,
+			// grayscale camera frames, taken from the luma of the native YUV camera frames without converting to color first
+			INGESTION_GRAY_YUV = 2
+		};
+
+		// Default configuration parameters if not given when createFromNode
+		static constexpr unsigned int DEFAULT_QUEUE_CAPACITY = 1;
+		static constexpr unsigned int DEFAULT_DROP_POLICY    = DROP_POLICY_OLDEST;
+		static constexpr unsigned int DEFAULT_DEBUG_FPS      = 5;
+		static constexpr unsigned int DEFAULT_BUDGET_MS      = 100;
+		static constexpr unsigned int DEFAULT_INGESTION      = INGESTION_BGR;
+
+		/**
+		 * Setup properties for the stages of the people extractor.
+		 *
+		 * @param queue_capacity The maximum amount of camera frames waiting between two stages
+		 * @param drop_policy    What a stage does with a camera frame when the queue to the next stage is full
+		 * @param debug_fps      The maximum camera frames per second drawn in the debug windows, 0 for every camera frame
+		 * @param budget_ms      The milliseconds a camera frame may take from capturing till its people are sent before the quality is lowered, 0 for never
+		 * @param ingestion      What camera frames are converted to on ingestion
+		 **/
+		PipelineConfiguration(unsigned int queue_capacity, DropPolicy drop_policy, unsigned int debug_fps, unsigned int budget_ms, Ingestion ingestion);
+
+		/**
+		 * Creates the PipelineConfiguration from a file node; default if not existing, as all settings are optional
+		 *
+		 * @param read_config File node from which to read PipelineConfiguration
+		 **/
+		static PipelineConfiguration* readNode(cv::FileStorage read_config);
+
+		/**
+		 * Creates the PipelineConfiguration from a file node and defaults
+		 *
+		 * @param read_config File node from which to load PipelineConfiguration
+		 **/
+		static PipelineConfiguration* createFromNode(cv::FileStorage read_config);
+
+		/**
+		 * Creates the file by which the filepath is given from the PipelineConfiguration
+		 *
+		 * @param write_config File node to which to save PipelineConfiguration
+		 **/
+		void writeNode(cv::FileStorage write_config) const;
+
+		/**
+		 * Gets the maximum amount of camera frames waiting between two stages
+		 **/
+		unsigned int getQueueCapacity() const;
+
+		/**
+		 * Sets the maximum amount of camera frames waiting between two stages
+		 *
+		 * @param queue_capacity The maximum amount of camera frames, at least 1
+		 **/
+		void setQueueCapacity(unsigned int queue_capacity);
+
+		/**
+		 * Gets what a stage does with a camera frame when the queue to the next stage is full
+		 **/
+		DropPolicy getDropPolicy() const;
+
+		/**
+		 * Sets what a stage does with a camera frame when the queue to the next stage is full
+		 *
+		 * @param drop_policy The drop policy
+		 **/
+		void setDropPolicy(DropPolicy drop_policy);
+
+		/**
+		 * Gets the maximum camera frames per second drawn in the debug windows, 0 for every camera frame
+		 **/
+		unsigned int getDebugFps() const;
+
+		/**
+		 * Sets the maximum camera frames per second drawn in the debug windows
+		 *
+		 * @param debug_fps The maximum camera frames per second, 0 for every camera frame
+		 **/
+		void setDebugFps(unsigned int debug_fps);
+
+		/**
+		 * Gets the milliseconds a camera frame may take from capturing till its people are sent before the quality is lowered, 0 for never
+		 **/
+		unsigned int getBudgetMs() const;
+
+		/**
+		 * Sets the milliseconds a camera frame may take from capturing till its people are sent before the quality is lowered
+		 *
+		 * @param budget_ms The milliseconds, 0 to never lower the quality
+		 **/
+		void setBudgetMs(unsigned int budget_ms);
+
+		/**
+		 * Gets what camera frames are converted to on ingestion
+		 **/
+		Ingestion getIngestion() const;
+
+		/**
+		 * Sets what camera frames are converted to on ingestion
+		 *
+		 * @param ingestion What camera frames are converted to
+		 **/
+		void setIngestion(Ingestion ingestion);
+
+	protected:
+		// maximum amount of camera frames waiting between two stages
+		unsigned int queue_capacity;
+		// what a stage does with a camera frame when the queue to the next stage is full
+		DropPolicy drop_policy;
+		// maximum camera frames per second drawn in the debug windows, 0 for every camera frame
+		unsigned int debug_fps;
+		// milliseconds a camera frame may take from capturing till its people are sent before the quality is lowered, 0 for never
+		unsigned int budget_ms;
+		// what camera frames are converted to on ingestion
+		Ingestion ingestion;
+};
+
+#endif // PIPELINECONFIGURATION_H
@@ -6,11 +6,11 @@
 
 #include "ProjectioneliminationConfiguration.hpp"
 
-ProjectioneliminationConfiguration::ProjectioneliminationConfiguration(unsigned int frames_projector_camera_delay, float projector_background_light, unsigned int fps_capture_scene, unsigned int iterations_delay_peopleextracting, unsigned int factor_resize_capture_scene) :
-	frames_projector_camera_delay(frames_projector_camera_delay),
+ProjectioneliminationConfiguration::ProjectioneliminationConfiguration(unsigned int latency_projector_camera_ms, unsigned int exposure_camera_ms, float projector_background_light, unsigned int fps_capture_scene, unsigned int factor_resize_capture_scene) :
+	latency_projector_camera_ms(latency_projector_camera_ms),
+	exposure_camera_ms(exposure_camera_ms),
 	projector_background_light(projector_background_light),
 	fps_capture_scene(fps_capture_scene),
-	iterations_delay_peopleextracting(iterations_delay_peopleextracting),
 	factor_resize_capture_scene(factor_resize_capture_scene)
 {}
 
@@ -18,11 +18,13 @@ ProjectioneliminationConfiguration* ProjectioneliminationConfiguration::readNode
 	float projector_background_light;
 	read_config["Projector_background_light"] >> projector_background_light;
 
+	// the latency and exposure are optional, so configurations calibrated with a delay in frames still load
+	const unsigned int fps_capture_scene = Configuration::read(read_config, "FPS_capture_scene");
 	return new ProjectioneliminationConfiguration(
-		Configuration::read(read_config, "Frames_projector_camera_delay"),
+		ProjectioneliminationConfiguration::createLatencyProjectorCameraMs(read_config, fps_capture_scene),
+		Configuration::create(read_config, "Exposure_camera", ProjectioneliminationConfiguration::DEFAULT_EXPOSURE_CAMERA_MS),
 		projector_background_light,
-		Configuration::read(read_config, "FPS_capture_scene"),
-		Configuration::read(read_config, "Iterations_delay_peopleextracting"),
+		fps_capture_scene,
 		Configuration::read(read_config, "Factor_resize_capture_scene")
 	);
 }
@@ -37,28 +39,44 @@ ProjectioneliminationConfiguration* ProjectioneliminationConfiguration::createFr
 	}
  
  	// create initial ProjectioneliminationConfiguration based on configuration, arguments and defaults
+	const unsigned int fps_capture_scene = Configuration::create(read_config, "FPS_capture_scene", ProjectioneliminationConfiguration::DEFAULT_FPS_CAPTURE_SCENE);
 	return new ProjectioneliminationConfiguration(
-		Configuration::create(read_config, "Frames_projector_camera_delay", ProjectioneliminationConfiguration::DEFAULT_FRAMES_PROJECTOR_CAMERA_DELAY),
+		ProjectioneliminationConfiguration::createLatencyProjectorCameraMs(read_config, fps_capture_scene),
+		Configuration::create(read_config, "Exposure_camera", ProjectioneliminationConfiguration::DEFAULT_EXPOSURE_CAMERA_MS),
 		projector_background_light,
-		Configuration::create(read_config, "FPS_capture_scene", ProjectioneliminationConfiguration::DEFAULT_FPS_CAPTURE_SCENE),
-		Configuration::create(read_config, "Iterations_delay_peopleextracting", ProjectioneliminationConfiguration::DEFAULT_ITERATIONS_DELAY_PEOPLEEXTRACTING),
+		fps_capture_scene,
 		Configuration::create(read_config, "Factor_resize_capture_scene", ProjectioneliminationConfiguration::DEFAULT_FACTOR_RESIZE_CAPTURE_SCENE)
 	);
 }
 
+unsigned int ProjectioneliminationConfiguration::createLatencyProjectorCameraMs(cv::FileStorage read_config, unsigned int fps_capture_scene) {
+	if (!read_config["Latency_projector_camera"].isNone() || read_config["Frames_projector_camera_delay"].isNone() || fps_capture_scene == 0) {
+		return Configuration::create(read_config, "Latency_projector_camera", ProjectioneliminationConfiguration::DEFAULT_LATENCY_PROJECTOR_CAMERA_MS);
+	}
+	// the delay counted the scene frames captured since the projector frame, which are captured at the configured fps
+	const unsigned int frames_projector_camera_delay = Configuration::create(read_config, "Frames_projector_camera_delay", 0);
+	return (frames_projector_camera_delay * 1000 + fps_capture_scene / 2) / fps_capture_scene;
+}
+
 void ProjectioneliminationConfiguration::writeNode(cv::FileStorage write_config) const {
-	write_config << "Frames_projector_camera_delay"     << (int) this->frames_projector_camera_delay;
-	write_config << "Projector_background_light"        <<       this->projector_background_light;
-	write_config << "FPS_capture_scene"                 << (int) this->fps_capture_scene;
-	write_config << "Iterations_delay_peopleextracting" << (int) this->iterations_delay_peopleextracting;
-	write_config << "Factor_resize_capture_scene"       << (int) this->factor_resize_capture_scene;
+	write_config << "Latency_projector_camera"    << (int) this->latency_projector_camera_ms;
+	write_config << "Exposure_camera"             << (int) this->exposure_camera_ms;
+	write_config << "Projector_background_light"  <<       this->projector_background_light;
+	write_config << "FPS_capture_scene"           << (int) this->fps_capture_scene;
+	write_config << "Factor_resize_capture_scene" << (int) this->factor_resize_capture_scene;
 }
 
-unsigned int ProjectioneliminationConfiguration::getFramesProjectorCameraDelay() const {
-	return this->frames_projector_camera_delay;
+unsigned int ProjectioneliminationConfiguration::getLatencyProjectorCameraMs() const {
+	return this->latency_projector_camera_ms;
+}
+void ProjectioneliminationConfiguration::setLatencyProjectorCameraMs(unsigned int latency_projector_camera_ms) {
+	this->latency_projector_camera_ms = latency_projector_camera_ms;
 }
-void ProjectioneliminationConfiguration::setFramesProjectorCameraDelay(unsigned int frames_projector_camera_delay) {
-	this->frames_projector_camera_delay = frames_projector_camera_delay;
+unsigned int ProjectioneliminationConfiguration::getExposureCameraMs() const {
+	return this->exposure_camera_ms;
+}
+void ProjectioneliminationConfiguration::setExposureCameraMs(unsigned int exposure_camera_ms) {
+	this->exposure_camera_ms = exposure_camera_ms;
 }
 float ProjectioneliminationConfiguration::getProjectorBackgroundLight() const {
 	return this->projector_background_light;
@@ -72,12 +90,6 @@ void ProjectioneliminationConfiguration::setFpsCaptureScene(const unsigned int f
 const unsigned int ProjectioneliminationConfiguration::getFpsCaptureScene() const {
 	return this->fps_capture_scene;
 }
-void ProjectioneliminationConfiguration::setIterationsDelayPeopleextracting(unsigned int iterations_delay_peopleextracting) {
-	this->iterations_delay_peopleextracting = iterations_delay_peopleextracting;
-}
-const unsigned int ProjectioneliminationConfiguration::getIterationsDelayPeopleextracting() const {
-	return this->iterations_delay_peopleextracting;
-}
 void ProjectioneliminationConfiguration::setFactorResizeCaptureScene(unsigned int factor_resize_capture_scene) {
 	this->factor_resize_capture_scene = factor_resize_capture_scene;
 }
@@ -9,22 +9,22 @@
 class ProjectioneliminationConfiguration : public Configuration {
 	public:
 		// Default configuration parameters if not given when createFromNode
-		static constexpr unsigned int    DEFAULT_FRAMES_PROJECTOR_CAMERA_DELAY     = 5;
-		static constexpr          double DEFAULT_PROJECTOR_BACKGROUND_LIGHT        = 39;
-		static constexpr unsigned int    DEFAULT_FPS_CAPTURE_SCENE                 = 8;
-		static constexpr unsigned int    DEFAULT_ITERATIONS_DELAY_PEOPLEEXTRACTING = 5000;
-		static constexpr unsigned int    DEFAULT_FACTOR_RESIZE_CAPTURE_SCENE       = 10;
+		static constexpr unsigned int    DEFAULT_LATENCY_PROJECTOR_CAMERA_MS = 150;
+		static constexpr unsigned int    DEFAULT_EXPOSURE_CAMERA_MS          = 0;
+		static constexpr          double DEFAULT_PROJECTOR_BACKGROUND_LIGHT  = 39;
+		static constexpr unsigned int    DEFAULT_FPS_CAPTURE_SCENE           = 8;
+		static constexpr unsigned int    DEFAULT_FACTOR_RESIZE_CAPTURE_SCENE = 10;
 		
 		/**
 		 * Setup properties for mapping projector from camera.
 		 * 
-		 * @param frames_projector_camera_delay The amount of frames delay between the projectors projection captured by the camera
+		 * @param latency_projector_camera_ms The milliseconds from displaying a projector frame till the camera frame showing it is captured
+		 * @param exposure_camera_ms The milliseconds the camera exposes a frame over, over which projector frames are blended; 0 for no blending
 		 * @param projector_background_light The light level difference between the projectors projection light level and background level
 		 * @param fps_capture_scene The fps capture scene for projection elimination
-		 * @param iterations_delay_peopleextracting The amount of iterations to stall for syncing people extracting and slow scene capture image
 		 * @param factor_resize_capture_scene The factor to resize the captured scene before sending over to people extractor
 		 **/
-		ProjectioneliminationConfiguration(unsigned int frames_projector_camera_delay, float projector_background_light, unsigned int fps_capture_scene, unsigned int iterations_delay_peopleextracting, unsigned int factor_resize_capture_scene);
+		ProjectioneliminationConfiguration(unsigned int latency_projector_camera_ms, unsigned int exposure_camera_ms, float projector_background_light, unsigned int fps_capture_scene, unsigned int factor_resize_capture_scene);
 
 		/**
 		 * Creates the ProjectioneliminationConfiguration from a file by which the filepath is given
@@ -48,16 +48,28 @@ class ProjectioneliminationConfiguration : public Configuration {
 		void writeNode(cv::FileStorage write_config) const;
 
 		/**
-		 * Gets the amount of frames delay between the projectors projection captured by the camera.
+		 * Gets the milliseconds from displaying a projector frame till the camera frame showing it is captured.
 		 **/
-		unsigned int getFramesProjectorCameraDelay() const;
+		unsigned int getLatencyProjectorCameraMs() const;
 
 		/**
-		 * Sets the amount of frames delay between the projectors projection captured by the camera.
+		 * Sets the milliseconds from displaying a projector frame till the camera frame showing it is captured.
 		 * 
-		 * @param frames_projector_camera_delay The amount of frames delay between the projectors projection captured by the camera
+		 * @param latency_projector_camera_ms The milliseconds from displaying a projector frame till the camera frame showing it is captured
 		 **/
-		void setFramesProjectorCameraDelay(unsigned int frames_projector_camera_delay);
+		void setLatencyProjectorCameraMs(unsigned int latency_projector_camera_ms);
+
+		/**
+		 * Gets the milliseconds the camera exposes a frame over, 0 for no blending of projector frames.
+		 **/
+		unsigned int getExposureCameraMs() const;
+
+		/**
+		 * Sets the milliseconds the camera exposes a frame over, over which projector frames are blended.
+		 * 
+		 * @param exposure_camera_ms The milliseconds the camera exposes a frame over, 0 for no blending
+		 **/
+		void setExposureCameraMs(unsigned int exposure_camera_ms);
 
 		/**
 		 * Gets the light level difference between the projectors projection light level and background level.
@@ -83,18 +95,6 @@ class ProjectioneliminationConfiguration : public Configuration {
 		 **/
 		const unsigned int getFpsCaptureScene() const;
 
-		/**
-		 * Sets the amount of iterations to stall for syncing people extracting and slow scene capture image
-		 * 
-		 * @param iterations_delay_peopleextracting The amount of iterations to stall for sycing people extracting with slow capture scene image
-		 **/
-		void setIterationsDelayPeopleextracting(unsigned int iterations_delay_peopleextracting);
-		
-		/**
-		 * Gets the amount of iterations to stall for syncing people extracting and slow scene capture image
-		 **/
-		const unsigned int getIterationsDelayPeopleextracting() const;
-
 		/**
 		 * Sets the factor to resize the captured scene before sending over to people extractor
 		 * 
@@ -108,16 +108,24 @@ class ProjectioneliminationConfiguration : public Configuration {
 		const unsigned int getFactorResizeCaptureScene() const;
 
 	protected:
-		// The amount of frames delay between the projectors projection captured by the camera
-		unsigned int frames_projector_camera_delay;
+		// The milliseconds from displaying a projector frame till the camera frame showing it is captured
+		unsigned int latency_projector_camera_ms;
+		// The milliseconds the camera exposes a frame over, 0 for no blending of projector frames
+		unsigned int exposure_camera_ms;
 		// The light level difference between the projectors projection light level and background level
 		float projector_background_light;
 		// fps capture scene for projection elimination
 		unsigned int fps_capture_scene;
-		// amount of iterations to stall for syncing people extracting and slow scene capture image
-		unsigned int iterations_delay_peopleextracting;
 		// factor to resize the captured scene before sending over to people extractor
 		unsigned int factor_resize_capture_scene;
+
+		/**
+		 * Creates the latency from configuration node, or converts the delay in projector frames of configurations calibrated before there was a latency, or uses the default.
+		 *
+		 * @param read_config       File node from which to read the latency or delay
+		 * @param fps_capture_scene The frames per second the projector frames of the delay are captured at
+		 **/
+		static unsigned int createLatencyProjectorCameraMs(cv::FileStorage read_config, unsigned int fps_capture_scene);
 };
 
 #endif // PROJECTIONELIMINIATION_H
@@ -6,11 +6,13 @@
 
 #include "ProjectorConfiguration.hpp"
 
-ProjectorConfiguration::ProjectorConfiguration(const cv::Size& resolution, const bool& fullscreen, float meter, unsigned int maximum_fps_scene) : Configuration(),
+ProjectorConfiguration::ProjectorConfiguration(const cv::Size& resolution, const bool& fullscreen, float meter, unsigned int maximum_fps_scene, float resample_delay, float maximum_extrapolation) : Configuration(),
 	resolution(resolution),
 	fullscreen(fullscreen),
 	meter(meter),
-	maximum_fps_scene(maximum_fps_scene)
+	maximum_fps_scene(maximum_fps_scene),
+	resample_delay(resample_delay),
+	maximum_extrapolation(maximum_extrapolation)
 {}
 
 ProjectorConfiguration* ProjectorConfiguration::readNode(cv::FileStorage read_config) {
@@ -28,7 +30,9 @@ ProjectorConfiguration* ProjectorConfiguration::readNode(cv::FileStorage read_co
 		resolution,
 		fullscreen,
 		meter,
-		Configuration::read(read_config, "Maximum_FPS_scene")
+		Configuration::read(read_config, "Maximum_FPS_scene"),
+		Configuration::createFloat(read_config, "Resample_delay", ProjectorConfiguration::DEFAULT_RESAMPLE_DELAY),
+		Configuration::createFloat(read_config, "Maximum_extrapolation", ProjectorConfiguration::DEFAULT_MAXIMUM_EXTRAPOLATION)
 	);
 }
 
@@ -53,7 +57,9 @@ ProjectorConfiguration* ProjectorConfiguration::createFromNode(cv::FileStorage r
 		resolution,
 		fullscreen,
 		meter,
-		Configuration::create(read_config, "Maximum_FPS_scene", ProjectorConfiguration::DEFAULT_MAXIMUM_FPS_SCENE)
+		Configuration::create(read_config, "Maximum_FPS_scene", ProjectorConfiguration::DEFAULT_MAXIMUM_FPS_SCENE),
+		Configuration::createFloat(read_config, "Resample_delay", ProjectorConfiguration::DEFAULT_RESAMPLE_DELAY),
+		Configuration::createFloat(read_config, "Maximum_extrapolation", ProjectorConfiguration::DEFAULT_MAXIMUM_EXTRAPOLATION)
 	);
 }
 
@@ -62,6 +68,8 @@ void ProjectorConfiguration::writeNode(cv::FileStorage write_config) const {
 	write_config << "Fullscreen_projector"              <<       this->fullscreen;
 	write_config << "Meter_projector"                   <<       this->meter;
 	write_config << "Maximum_FPS_scene"                 << (int) this->maximum_fps_scene;
+	write_config << "Resample_delay"                    <<       this->resample_delay;
+	write_config << "Maximum_extrapolation"             <<       this->maximum_extrapolation;
 }
 
 bool ProjectorConfiguration::getFullscreen() const {
@@ -82,3 +90,15 @@ void ProjectorConfiguration::setMaximumFpsScene(const unsigned int maximum_fps_s
 const unsigned int ProjectorConfiguration::getMaximumFpsScene() const {
 	return this->maximum_fps_scene;
 }
+void ProjectorConfiguration::setResampleDelay(float resample_delay) {
+	this->resample_delay = resample_delay;
+}
+float ProjectorConfiguration::getResampleDelay() const {
+	return this->resample_delay;
+}
+void ProjectorConfiguration::setMaximumExtrapolation(float maximum_extrapolation) {
+	this->maximum_extrapolation = maximum_extrapolation;
+}
+float ProjectorConfiguration::getMaximumExtrapolation() const {
+	return this->maximum_extrapolation;
+}
@@ -11,6 +11,8 @@ class ProjectorConfiguration : public Configuration {
 		static constexpr unsigned int  DEFAULT_MAXIMUM_FPS_SCENE = 60;
 		static constexpr          bool DEFAULT_FULLSCREEN        = true;
 		static constexpr          bool DEFAULT_METER             = 100;
+		static constexpr         float DEFAULT_RESAMPLE_DELAY    = 0;
+		static constexpr         float DEFAULT_MAXIMUM_EXTRAPOLATION = 0.25;
 		
 		/**
 		 * Setup properties for mapping projector from camera.
@@ -19,8 +21,10 @@ class ProjectorConfiguration : public Configuration {
 		 * @param fullscreen_projector The projector fullscreen or not
 		 * @param meter The amount of pixels measured as 1 meter on projector frame
 		 * @param maximum_fps_scene The maximum fps for the scene
+		 * @param resample_delay The seconds people are shown behind the projector frame, to interpolate between extracted locations
+		 * @param maximum_extrapolation The maximum seconds people are moved ahead of their last extracted location
 		 **/
-		ProjectorConfiguration(const cv::Size& resolution_projector, const bool& fullscreen_projector, float meter, unsigned int maximum_fps_scene);
+		ProjectorConfiguration(const cv::Size& resolution_projector, const bool& fullscreen_projector, float meter, unsigned int maximum_fps_scene, float resample_delay, float maximum_extrapolation);
 
 		/**
 		 * Creates the ProjectorConfiguration from a file node by which the filepath is given
@@ -76,6 +80,30 @@ class ProjectorConfiguration : public Configuration {
 		 **/
 		const unsigned int getMaximumFpsScene() const;
 
+		/**
+		 * Sets the seconds people are shown behind the time a projector frame is displayed
+		 *
+		 * @param resample_delay The seconds of delay, 0 to only extrapolate
+		 **/
+		void setResampleDelay(float resample_delay);
+
+		/**
+		 * Gets the seconds people are shown behind the time a projector frame is displayed
+		 **/
+		float getResampleDelay() const;
+
+		/**
+		 * Sets the maximum seconds people are moved ahead of their last extracted location
+		 *
+		 * @param maximum_extrapolation The maximum seconds of extrapolation
+		 **/
+		void setMaximumExtrapolation(float maximum_extrapolation);
+
+		/**
+		 * Gets the maximum seconds people are moved ahead of their last extracted location
+		 **/
+		float getMaximumExtrapolation() const;
+
 	protected:
 		// The projector resolution
 		cv::Size resolution;
@@ -85,6 +113,10 @@ class ProjectorConfiguration : public Configuration {
 		float meter;
 		// fps scene
 		unsigned int maximum_fps_scene;
+		// seconds people are shown behind the displayed projector frame
+		float resample_delay;
+		// maximum seconds people are moved ahead of their last extracted location
+		float maximum_extrapolation;
 };
 
 #endif // PROJECTORCONFIGURATION_H